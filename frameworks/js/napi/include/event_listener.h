@@ -19,6 +19,7 @@
 #include <cstdint>
 
 #include "napi/native_api.h"
+#include "telephony_observer_delivery_policy.h"
 #include "telephony_update_event_type.h"
 
 namespace OHOS {
@@ -29,6 +30,7 @@ struct EventListener {
     int32_t slotId = 0;
     napi_ref callbackRef = nullptr;
     std::shared_ptr<bool> isDeleting = nullptr;
+    TelephonyObserverDeliveryPolicy policy;
 };
 } // namespace Telephony
 } // namespace OHOS
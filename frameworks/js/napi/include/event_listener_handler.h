@@ -39,6 +39,7 @@ namespace Telephony {
 constexpr int32_t EVENT_LISTENER_DIFF = -1;
 constexpr int32_t EVENT_LISTENER_SAME = 0;
 constexpr int32_t EVENT_LISTENER_SLOTID_AND_EVENTTYPE_SAME = 1;
+constexpr int32_t EVENT_LISTENER_POLICY_CONFLICT = 2;
 
 class EventListenerHandler : public AppExecFwk::EventHandler {
     DECLARE_DELAYED_SINGLETON(EventListenerHandler)
@@ -107,6 +107,7 @@ struct ObserverContext : BaseContext {
     TelephonyUpdateEventType eventType = TelephonyUpdateEventType::NONE_EVENT_TYPE;
     int32_t errorCode = 0;
     std::list<EventListener> removeListenerList {};
+    TelephonyObserverDeliveryPolicy policy;
 };
 } // namespace Telephony
 } // namespace OHOS
@@ -451,6 +451,10 @@ int32_t EventListenerHandler::CheckEventListenerRegister(EventListener &eventLis
             return flag;
         }
         if (eventListener.slotId == listen.slotId && eventListener.eventType == listen.eventType) {
+            // The listeners of a slot and event share one observer and so one delivery policy.
+            if (eventListener.policy != listen.policy) {
+                return EVENT_LISTENER_POLICY_CONFLICT;
+            }
             flag = EVENT_LISTENER_SLOTID_AND_EVENTTYPE_SAME;
         }
     }
@@ -464,6 +468,11 @@ int32_t EventListenerHandler::RegisterEventListener(EventListener &eventListener
     if (registerStatus == EVENT_LISTENER_SAME) {
         return TELEPHONY_ERR_CALLBACK_ALREADY_REGISTERED;
     }
+    if (registerStatus == EVENT_LISTENER_POLICY_CONFLICT) {
+        TELEPHONY_LOGE("slotId %{public}d eventType %{public}d is listened with another delivery policy",
+            eventListener.slotId, static_cast<int32_t>(eventListener.eventType));
+        return TELEPHONY_ERR_ARGUMENT_INVALID;
+    }
     if (registerStatus != EVENT_LISTENER_SLOTID_AND_EVENTTYPE_SAME) {
         NapiTelephonyObserver *telephonyObserver = std::make_unique<NapiTelephonyObserver>().release();
         if (telephonyObserver == nullptr) {
@@ -480,8 +489,11 @@ int32_t EventListenerHandler::RegisterEventListener(EventListener &eventListener
             eventListener.eventType == TelephonyUpdateEventType::EVENT_CALL_STATE_EX_UPDATE ||
             eventListener.eventType == TelephonyUpdateEventType::EVENT_CCALL_STATE_UPDATE ||
             eventListener.eventType == TelephonyUpdateEventType::EVENT_SIM_ACTIVE_STATE);
-        int32_t addResult = TelephonyStateManager::AddStateObserver(
-            observer, eventListener.slotId, ToUint32t(eventListener.eventType), isUpdate);
+        int32_t addResult = eventListener.policy.IsDefault() ?
+            TelephonyStateManager::AddStateObserver(
+                observer, eventListener.slotId, ToUint32t(eventListener.eventType), isUpdate) :
+            TelephonyStateManager::AddStateObserver(
+                observer, eventListener.slotId, ToUint32t(eventListener.eventType), isUpdate, eventListener.policy);
         if (addResult != TELEPHONY_SUCCESS) {
             TELEPHONY_LOGE("AddStateObserver failed, ret=%{public}d!", addResult);
             return addResult;
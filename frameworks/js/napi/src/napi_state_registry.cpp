@@ -95,6 +95,11 @@ static void NativeOn(napi_env env, void *data)
         asyncContext->errorCode = ERROR_SLOT_ID_INVALID;
         return;
     }
+    if (!asyncContext->policy.IsValid()) {
+        TELEPHONY_LOGE("NativeOn delivery policy is invalid");
+        asyncContext->errorCode = TELEPHONY_ERR_ARGUMENT_INVALID;
+        return;
+    }
     std::shared_ptr<bool> isDeleting = std::make_shared<bool>(false);
     EventListener listener {
         env,
@@ -102,6 +107,7 @@ static void NativeOn(napi_env env, void *data)
         asyncContext->slotId,
         asyncContext->callbackRef,
         isDeleting,
+        asyncContext->policy,
     };
     asyncContext->errorCode = EventListenerManager::RegisterEventListener(listener);
     if (asyncContext->errorCode == TELEPHONY_SUCCESS) {
@@ -139,6 +145,22 @@ static void OnCallback(napi_env env, void *data)
     delete asyncContext;
 }
 
+static void GetDeliveryPolicy(napi_env env, napi_value object, TelephonyObserverDeliveryPolicy &policy)
+{
+    napi_value minInterval = NapiUtil::GetNamedProperty(env, object, "minInterval");
+    if (minInterval) {
+        NapiValueToCppValue(env, minInterval, napi_number, &policy.minIntervalMs);
+    }
+    napi_value signalDelta = NapiUtil::GetNamedProperty(env, object, "signalDelta");
+    if (signalDelta) {
+        NapiValueToCppValue(env, signalDelta, napi_number, &policy.signalDeltaDbm);
+    }
+    napi_value levelChangeOnly = NapiUtil::GetNamedProperty(env, object, "levelChangeOnly");
+    if (levelChangeOnly) {
+        NapiValueToCppValue(env, levelChangeOnly, napi_boolean, &policy.levelChangeOnly);
+    }
+}
+
 static std::optional<NapiError> MatchParametersWithObject(napi_env env, napi_value* parameters, size_t parameterCount,
     std::array<char, ARRAY_SIZE>& eventType, std::unique_ptr<ObserverContext>&asyncContext)
 {
@@ -161,6 +183,7 @@ static std::optional<NapiError> MatchParametersWithObject(napi_env env, napi_val
             TELEPHONY_LOGI("state registry on slotId = %{public}d, eventType = %{public}d",
                 asyncContext->slotId, asyncContext->eventType);
         }
+        GetDeliveryPolicy(env, object, asyncContext->policy);
     }
     return errCode;
 }
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATE_REGISTRY_IPC_INTERFACE_CODE_EX_H
+#define STATE_REGISTRY_IPC_INTERFACE_CODE_EX_H
+
+#include <cstdint>
+
+/* SAID:4009 */
+namespace OHOS {
+namespace Telephony {
+/**
+ * Requests of the state registry service which are not part of ITelephonyStateNotify, sent by the clients of this
+ * part through the remote object of the service. They start after StateNotifyInterfaceCode.
+ */
+enum class StateNotifyInterfaceCodeEx : uint32_t {
+    ADD_OBSERVER_WITH_POLICY = 100,
+    BATCH_UPDATE,
+    MODIFY_OBSERVER_MASK,
+    ADD_OBSERVERS,
+    REMOVE_OBSERVERS,
+    REMOVE_ALL_OBSERVERS,
+    GET_STATE_SNAPSHOT,
+    GET_STATE_PAGE,
+    GET_EVENT_RING,
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // STATE_REGISTRY_IPC_INTERFACE_CODE_EX_H
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_EVENT_RING_H
+#define TELEPHONY_EVENT_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * @brief Layout of the shared memory ring the service writes the signal or cell events of a slot into.
+ *
+ * The ring has one writer, the service, and any number of readers mapping it read-only. Events are numbered from 1,
+ * the event of sequence s lives in entry (s - 1) % entryCount. An entry holds the observer callback arguments as
+ * TelephonyObserverProxy encodes them after the interface token. A reader which falls more than entryCount events
+ * behind has lost the oldest ones, it tells from the sequence numbers how many.
+ */
+struct TelephonyEventRing {
+    static constexpr uint32_t MAGIC = 0x54455652;
+    static constexpr uint32_t LAYOUT_VERSION = 1;
+    static constexpr uint32_t DEFAULT_ENTRY_COUNT = 32;
+    static constexpr uint32_t DEFAULT_ENTRY_SIZE = 4096;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct alignas(CACHE_LINE_SIZE) Header {
+        uint32_t magic = 0;
+        uint32_t layoutVersion = 0;
+        int32_t slotId = 0;
+        /**
+         * Observer mask bit of the events, OBSERVER_MASK_SIGNAL_STRENGTHS or OBSERVER_MASK_CELL_INFO.
+         */
+        uint32_t mask = 0;
+        /**
+         * Number of entries, a power of two.
+         */
+        uint32_t entryCount = 0;
+        /**
+         * Maximum size of the arguments of an event.
+         */
+        uint32_t entrySize = 0;
+        /**
+         * Sequence of the last event written, 0 when none.
+         */
+        std::atomic<uint64_t> head { 0 };
+        /**
+         * Bumped after each event, readers wait on it with a futex.
+         */
+        std::atomic<uint32_t> wakeup { 0 };
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Entry {
+        /**
+         * Sequence of the event held by the entry, 0 while it is being written.
+         */
+        std::atomic<uint64_t> sequence { 0 };
+        /**
+         * Sequence number of the state the event carries, see TelephonyObserver::GetUpdateSequence.
+         */
+        std::atomic<uint64_t> stateSequence { 0 };
+        /**
+         * Observer broker code of the event, 0 when the arguments did not fit and the event is lost.
+         */
+        std::atomic<uint32_t> code { 0 };
+        std::atomic<uint32_t> size { 0 };
+    };
+
+    static constexpr size_t GetEntryStride(uint32_t entrySize)
+    {
+        return (sizeof(Entry) + entrySize + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    }
+
+    static constexpr size_t GetSize(uint32_t entryCount, uint32_t entrySize)
+    {
+        return sizeof(Header) + GetEntryStride(entrySize) * entryCount;
+    }
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+        "the ring is shared between processes, its atomics must not rely on a lock");
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_EVENT_RING_H
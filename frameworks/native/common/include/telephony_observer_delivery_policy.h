@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_OBSERVER_DELIVERY_POLICY_H
+#define TELEPHONY_OBSERVER_DELIVERY_POLICY_H
+
+#include <cstdint>
+
+namespace OHOS {
+class Parcel;
+namespace Telephony {
+/**
+ * @brief Limits the signal and cell information notifications of an observer.
+ *
+ * The policy applies to OBSERVER_MASK_SIGNAL_STRENGTHS and OBSERVER_MASK_CELL_INFO, other events are notified as
+ * usual. A notification held back by the interval is replaced by the following ones, the latest value is notified
+ * when the interval expires.
+ */
+struct TelephonyObserverDeliveryPolicy {
+    /**
+     * Minimum interval between two notifications in milliseconds, 0 means no limit.
+     */
+    int32_t minIntervalMs = 0;
+    /**
+     * Minimum change of the signal intensity in dBm notified while the signal level is unchanged, 0 means any change.
+     */
+    int32_t signalDeltaDbm = 0;
+    /**
+     * Whether only the changes of the signal level are notified.
+     */
+    bool levelChangeOnly = false;
+
+    /**
+     * @brief Whether the policy lets every notification through.
+     */
+    bool IsDefault() const;
+
+    /**
+     * @brief Whether the policy values are in range.
+     */
+    bool IsValid() const;
+
+    bool operator==(const TelephonyObserverDeliveryPolicy &other) const;
+    bool operator!=(const TelephonyObserverDeliveryPolicy &other) const;
+
+    bool Marshalling(Parcel &parcel) const;
+    bool ReadFromParcel(Parcel &parcel);
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_OBSERVER_DELIVERY_POLICY_H
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_OBSERVER_REGISTRATION_H
+#define TELEPHONY_OBSERVER_REGISTRATION_H
+
+#include <cstdint>
+
+#include "refbase.h"
+#include "telephony_observer_broker.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * @brief One (slot, mask) pair of a bulk add or remove observer request.
+ *
+ * The service applies the pairs of a request under one lock acquisition and notifies the initial state of the pairs
+ * added with notifyNow as one delivery per observer.
+ */
+struct TelephonyObserverRegistration {
+    static constexpr int32_t MAX_ENTRY_COUNT = 32;
+
+    /**
+     * Observer to add, not used by a remove request.
+     */
+    sptr<TelephonyObserverBroker> observer = nullptr;
+    int32_t slotId = 0;
+    uint32_t mask = 0;
+    /**
+     * Whether the current state is notified once added, not used by a remove request.
+     */
+    bool notifyNow = false;
+    /**
+     * Last sequence number the observer has seen, see TelephonyObserver::GetUpdateSequence. With notifyNow, only the
+     * state changed after it is notified, 0 notifies the whole state. Not used by a remove request.
+     */
+    uint64_t sinceSequence = 0;
+    /**
+     * Whether the observer reads the sequence numbers of the callbacks, as the observers derived from
+     * TelephonyObserver do. Only such observers are sent callbacks with TelephonyObserverProxy::SEQUENCED_CODE_FLAG.
+     * Not used by a remove request.
+     */
+    bool readsSequence = false;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_OBSERVER_REGISTRATION_H
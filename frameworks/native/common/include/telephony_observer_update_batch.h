@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_OBSERVER_UPDATE_BATCH_H
+#define TELEPHONY_OBSERVER_UPDATE_BATCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "refbase.h"
+
+namespace OHOS {
+class MessageParcel;
+namespace Telephony {
+class CellInformation;
+class NetworkState;
+class SignalInformation;
+
+/**
+ * @brief State updates of a producer published in one request.
+ *
+ * Each entry carries the arguments of the matching single update request. The service checks the permission of the
+ * producer once, commits every entry before notifying, and notifies the observers of each slot in one pass.
+ */
+class TelephonyObserverUpdateBatch {
+public:
+    static constexpr int32_t MAX_ENTRY_COUNT = 16;
+
+    /**
+     * @brief Add a signal information update.
+     *
+     * @param slotId Indicates the slot identification.
+     * @param vec Indicates the signal information of the slot.
+     * @return Return false if the batch is full or the arguments can not be written.
+     */
+    bool AddSignalInfo(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec);
+
+    /**
+     * @brief Add a cell information update.
+     *
+     * @param slotId Indicates the slot identification.
+     * @param vec Indicates the cell information of the slot.
+     * @return Return false if the batch is full or the arguments can not be written.
+     */
+    bool AddCellInfo(int32_t slotId, const std::vector<sptr<CellInformation>> &vec);
+
+    /**
+     * @brief Add a network state update.
+     *
+     * @param slotId Indicates the slot identification.
+     * @param networkState Indicates the network state of the slot.
+     * @return Return false if the batch is full or the arguments can not be written.
+     */
+    bool AddNetworkState(int32_t slotId, const sptr<NetworkState> &networkState);
+
+    /**
+     * @brief Add a cellular data connection state update.
+     *
+     * @param slotId Indicates the slot identification.
+     * @param dataState Indicates the cellular data connection state.
+     * @param networkType Indicates the network type of the connection.
+     * @return Return false if the batch is full.
+     */
+    bool AddCellularDataConnectState(int32_t slotId, int32_t dataState, int32_t networkType);
+
+    /**
+     * @brief Add a cellular data flow update.
+     *
+     * @param slotId Indicates the slot identification.
+     * @param flowData Indicates the cellular data flow type.
+     * @return Return false if the batch is full.
+     */
+    bool AddCellularDataFlow(int32_t slotId, int32_t flowData);
+
+    int32_t GetEntryCount() const;
+    void Clear();
+
+    /**
+     * @brief Write the entry count followed by the code, size and arguments of each entry.
+     */
+    bool Marshalling(MessageParcel &parcel) const;
+
+private:
+    struct Entry {
+        uint32_t code = 0;
+        std::vector<uint8_t> arguments;
+    };
+
+    template<typename Writer>
+    bool AddEntry(uint32_t code, Writer writer);
+
+private:
+    std::vector<Entry> entries_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_OBSERVER_UPDATE_BATCH_H
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_PAGE_H
+#define TELEPHONY_STATE_PAGE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "telephony_state_snapshot.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * @brief Layout of the shared memory page the service publishes the scalar state of every slot into.
+ *
+ * The page is a header followed by one entry per slot, slot -1 first. The service is the only writer, each entry is
+ * published under its own sequence lock so that readers in other processes never block it. The entries written by
+ * one batch update are committed together under the sequence lock of the header. The call incoming number and the
+ * other permission-sensitive values are never written to the page.
+ */
+struct TelephonyStatePage {
+    static constexpr uint32_t MAGIC = 0x54535047;
+    static constexpr uint32_t LAYOUT_VERSION = 2;
+    static constexpr uint32_t FIELD_COUNT = static_cast<uint32_t>(TelephonyStateSnapshot::Field::CALL_INCOMING_NUMBER);
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct alignas(CACHE_LINE_SIZE) Header {
+        uint32_t magic = 0;
+        uint32_t layoutVersion = 0;
+        /**
+         * Number of slot entries, the slot -1 included.
+         */
+        uint32_t slotCount = 0;
+        uint32_t fieldCount = 0;
+        /**
+         * Odd while the entries of a batch update are being written.
+         */
+        std::atomic<uint32_t> commitSequence { 0 };
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        /**
+         * Odd while the entry is being written.
+         */
+        std::atomic<uint32_t> sequence { 0 };
+        /**
+         * Bit (1 << field) is set for each published field, fields are the ones of TelephonyStateSnapshot.
+         */
+        std::atomic<uint32_t> validFields { 0 };
+        std::atomic<int32_t> values[FIELD_COUNT] = {};
+        std::atomic<uint64_t> versions[FIELD_COUNT] = {};
+    };
+
+    static constexpr size_t GetSize(uint32_t slotCount)
+    {
+        return sizeof(Header) + sizeof(Slot) * slotCount;
+    }
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+        "the page is shared between processes, its atomics must not rely on a lock");
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_PAGE_H
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_SNAPSHOT_H
+#define TELEPHONY_STATE_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+class Parcel;
+namespace Telephony {
+/**
+ * @brief Cached state of a slot read in one request.
+ *
+ * Only the fields the service has a value for and the caller is permitted to see are present. Each field carries
+ * the sequence number of its last change, sequence numbers increase across every field of every slot so a caller
+ * can tell which fields changed between two snapshots.
+ */
+struct TelephonyStateSnapshot {
+    /**
+     * Slot identification requesting the snapshot of every slot.
+     */
+    static constexpr int32_t ALL_SLOTS = -2;
+
+    enum class Field : uint32_t {
+        CALL_STATE = 0,
+        SIM_STATE,
+        CARD_TYPE,
+        LOCK_REASON,
+        DATA_CONNECTION_STATE,
+        DATA_CONNECTION_NETWORK_TYPE,
+        DATA_FLOW,
+        CFU_INDICATOR,
+        VOICE_MAIL_MSG_INDICATOR,
+        SIM_ACTIVE_STATE,
+        CALL_INCOMING_NUMBER,
+        FIELD_COUNT,
+    };
+    static constexpr uint32_t FIELD_COUNT = static_cast<uint32_t>(Field::FIELD_COUNT);
+
+    int32_t slotId = 0;
+    /**
+     * Bit (1 << field) is set for each present field.
+     */
+    uint32_t fields = 0;
+    /**
+     * Value of each present field, the call incoming number is in callIncomingNumber.
+     */
+    int32_t values[FIELD_COUNT] = { 0 };
+    uint64_t sequences[FIELD_COUNT] = { 0 };
+    std::u16string callIncomingNumber;
+
+    bool Has(Field field) const;
+    int32_t Get(Field field) const;
+    uint64_t GetSequence(Field field) const;
+    void Set(Field field, int32_t value, uint64_t sequence);
+
+    bool Marshalling(Parcel &parcel) const;
+    bool ReadFromParcel(Parcel &parcel);
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_SNAPSHOT_H
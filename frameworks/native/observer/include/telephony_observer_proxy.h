@@ -49,6 +49,65 @@ public:
     void OnCCallStateUpdated(int32_t slotId, int32_t callState, const std::u16string &phoneNumber);
     void OnSimActiveStateUpdated(int32_t slotId, bool enable);
 
+    /**
+     * Write the arguments of OnSignalInfoUpdated, OnCellInfoUpdated and OnNetworkStateUpdated after the interface
+     * token, so that the service can encode an event once and send the same bytes to every observer.
+     *
+     * @return bool false when the arguments are not sent to the observers.
+     */
+    static bool WriteSignalInfo(
+        MessageParcel &dataParcel, int32_t slotId, const std::vector<sptr<SignalInformation>> &vec);
+    static bool WriteCellInfo(MessageParcel &dataParcel, int32_t slotId, const std::vector<sptr<CellInformation>> &vec);
+    static bool WriteNetworkState(MessageParcel &dataParcel, int32_t slotId, const sptr<NetworkState> &networkState);
+
+    /**
+     * Set on the code of a callback which carries a sequence number. The number is the first argument after the
+     * interface token. Only the observers registered with TelephonyObserverRegistration::readsSequence are sent
+     * such codes, the other observers get the plain callbacks.
+     */
+    static constexpr uint32_t SEQUENCED_CODE_FLAG = 0x00800000;
+
+    /**
+     * Sequence number of the state notified by the callbacks made from the calling thread while the scope lives.
+     */
+    class SequenceScope {
+    public:
+        /**
+         * @param sequence Sequence number of the notified state.
+         * @param sent Whether the callbacks sent to remote observers carry it, see SEQUENCED_CODE_FLAG.
+         */
+        explicit SequenceScope(uint64_t sequence, bool sent = true);
+        ~SequenceScope();
+
+    private:
+        uint64_t previousSequence_ = 0;
+        bool previousSent_ = false;
+    };
+
+    /**
+     * Sequence number set by the innermost SequenceScope of the calling thread, 0 when none.
+     */
+    static uint64_t GetCurrentSequence();
+
+    /**
+     * Write the interface token of a callback, followed by the current sequence number when it is sent.
+     */
+    static bool WriteRequestHeader(MessageParcel &dataParcel);
+
+    /**
+     * Code of a callback whose header was written by WriteRequestHeader on the calling thread.
+     */
+    static uint32_t GetRequestCode(uint32_t code);
+
+    /**
+     * Read the sequence number of a callback after its interface token.
+     *
+     * @param code Code of the callback, SEQUENCED_CODE_FLAG is cleared.
+     * @param sequence Sequence number of the callback, 0 when the code does not have SEQUENCED_CODE_FLAG.
+     * @return bool false when the code has SEQUENCED_CODE_FLAG but the sequence number cannot be read.
+     */
+    static bool ReadSequence(uint32_t &code, MessageParcel &dataParcel, uint64_t &sequence);
+
 private:
     int32_t SendRequest(int32_t msgId, MessageParcel &dataParcel, MessageParcel &replyParcel, MessageOption &option);
     static inline BrokerDelegator<TelephonyObserverProxy> delegator_;
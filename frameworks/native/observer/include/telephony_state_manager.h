@@ -16,7 +16,9 @@
 #ifndef TELEPHONY_STATE_MANAGER_H
 #define TELEPHONY_STATE_MANAGER_H
 
+#include <memory>
 #include <stdint.h>
+#include <vector>
 
 namespace OHOS {
 template<typename T>
@@ -73,11 +75,28 @@ enum class CallStatus {
 };
 
 class TelephonyObserverBroker;
+struct TelephonyObserverDeliveryPolicy;
+struct TelephonyObserverRegistration;
+struct TelephonyStateSnapshot;
+class TelephonyStatePageReader;
+class TelephonyEventRingReader;
 class TelephonyStateManager {
 public:
     static int32_t AddStateObserver(const sptr<TelephonyObserverBroker> &telephonyObserver,
         int32_t slotId, uint32_t mask, bool notifyNow);
+    static int32_t AddStateObserver(const sptr<TelephonyObserverBroker> &telephonyObserver,
+        int32_t slotId, uint32_t mask, bool notifyNow, const TelephonyObserverDeliveryPolicy &policy);
     static int32_t RemoveStateObserver(int32_t slotId, uint32_t mask);
+    static int32_t ModifyStateObserver(
+        int32_t slotId, uint32_t mask, uint32_t addMask, uint32_t removeMask, bool notifyNow);
+    static int32_t AddStateObservers(
+        const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results);
+    static int32_t RemoveStateObservers(
+        const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results);
+    static int32_t RemoveAllStateObservers();
+    static int32_t GetStateSnapshot(int32_t slotId, std::vector<TelephonyStateSnapshot> &snapshots);
+    static int32_t GetStatePage(std::shared_ptr<TelephonyStatePageReader> &reader);
+    static int32_t GetEventRing(int32_t slotId, uint32_t mask, std::shared_ptr<TelephonyEventRingReader> &reader);
 };
 } // namespace Telephony
 } // namespace OHOS
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_event_ring_reader.h"
+
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "telephony_event_ring.h"
+#include "telephony_log_wrapper.h"
+#include "telephony_observer_proxy.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr int32_t MS_PER_SECOND = 1000;
+constexpr int64_t NS_PER_MS = 1000000;
+
+const TelephonyEventRing::Header *GetHeader(const void *address)
+{
+    return reinterpret_cast<const TelephonyEventRing::Header *>(address);
+}
+} // namespace
+
+std::shared_ptr<TelephonyEventRingReader> TelephonyEventRingReader::Create(const sptr<Ashmem> &ashmem)
+{
+    if (ashmem == nullptr || !ashmem->MapReadOnlyAshmem()) {
+        TELEPHONY_LOGE("EventRingReader map ashmem failed");
+        return nullptr;
+    }
+    int32_t size = ashmem->GetAshmemSize();
+    const void *address = nullptr;
+    if (size >= static_cast<int32_t>(sizeof(TelephonyEventRing::Header))) {
+        address = ashmem->ReadFromAshmem(size, 0);
+    }
+    auto header = GetHeader(address);
+    if (header == nullptr || header->magic != TelephonyEventRing::MAGIC ||
+        header->layoutVersion != TelephonyEventRing::LAYOUT_VERSION || header->entryCount == 0 ||
+        (header->entryCount & (header->entryCount - 1)) != 0 ||
+        TelephonyEventRing::GetSize(header->entryCount, header->entrySize) > static_cast<size_t>(size)) {
+        TELEPHONY_LOGE("EventRingReader ring of size %{public}d invalid", size);
+        ashmem->UnmapAshmem();
+        ashmem->CloseAshmem();
+        return nullptr;
+    }
+    return std::make_shared<TelephonyEventRingReader>(ashmem, address);
+}
+
+TelephonyEventRingReader::TelephonyEventRingReader(const sptr<Ashmem> &ashmem, const void *address)
+    : ashmem_(ashmem), address_(address)
+{
+    next_ = GetHeader(address_)->head.load(std::memory_order_acquire) + 1;
+}
+
+TelephonyEventRingReader::~TelephonyEventRingReader()
+{
+    if (ashmem_ != nullptr) {
+        ashmem_->UnmapAshmem();
+        ashmem_->CloseAshmem();
+    }
+}
+
+bool TelephonyEventRingReader::ReadEvent(uint64_t sequence, Event &event) const
+{
+    const TelephonyEventRing::Header *header = GetHeader(address_);
+    uint64_t index = (sequence - 1) & (header->entryCount - 1);
+    auto entry = reinterpret_cast<const TelephonyEventRing::Entry *>(reinterpret_cast<const uint8_t *>(address_) +
+        sizeof(TelephonyEventRing::Header) + TelephonyEventRing::GetEntryStride(header->entrySize) * index);
+    if (entry->sequence.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+    event.code = entry->code.load(std::memory_order_relaxed);
+    event.stateSequence = entry->stateSequence.load(std::memory_order_relaxed);
+    uint32_t size = entry->size.load(std::memory_order_relaxed);
+    if (size > header->entrySize) {
+        return false;
+    }
+    auto arguments = reinterpret_cast<const uint8_t *>(entry) + sizeof(TelephonyEventRing::Entry);
+    event.arguments.assign(arguments, arguments + size);
+    // The entry may have been overwritten while it was copied.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return entry->sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+uint32_t TelephonyEventRingReader::Poll(TelephonyObserver &observer, uint32_t maxEvents)
+{
+    const TelephonyEventRing::Header *header = GetHeader(address_);
+    uint32_t delivered = 0;
+    Event event;
+    while (delivered < maxEvents) {
+        uint64_t head = header->head.load(std::memory_order_acquire);
+        if (next_ > head) {
+            break;
+        }
+        if (head - next_ >= header->entryCount) {
+            uint64_t oldest = head - header->entryCount + 1;
+            TELEPHONY_LOGW("EventRingReader slot %{public}d lost %{public}llu events", header->slotId,
+                static_cast<unsigned long long>(oldest - next_));
+            lost_ += oldest - next_;
+            next_ = oldest;
+        }
+        bool read = ReadEvent(next_, event);
+        next_++;
+        // An event overwritten while it was read, or which did not fit in its entry, is lost.
+        if (!read || event.code == 0) {
+            lost_++;
+            continue;
+        }
+        Deliver(observer, event);
+        delivered++;
+    }
+    return delivered;
+}
+
+void TelephonyEventRingReader::Deliver(TelephonyObserver &observer, const Event &event) const
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    TelephonyObserverProxy::SequenceScope scope(event.stateSequence);
+    if (!TelephonyObserverProxy::WriteRequestHeader(data) ||
+        !data.WriteBuffer(event.arguments.data(), event.arguments.size())) {
+        TELEPHONY_LOGE("EventRingReader write code %{public}u failed", event.code);
+        return;
+    }
+    observer.OnRemoteRequest(TelephonyObserverProxy::GetRequestCode(event.code), data, reply, option);
+}
+
+bool TelephonyEventRingReader::Wait(int32_t timeoutMs) const
+{
+    const TelephonyEventRing::Header *header = GetHeader(address_);
+    uint32_t wakeup = header->wakeup.load(std::memory_order_acquire);
+    if (header->head.load(std::memory_order_acquire) >= next_) {
+        return true;
+    }
+    struct timespec timeout = { timeoutMs / MS_PER_SECOND, (timeoutMs % MS_PER_SECOND) * NS_PER_MS };
+    // Returns at once when a write bumped the wakeup counter since it was loaded.
+    if (syscall(SYS_futex, &header->wakeup, FUTEX_WAIT, wakeup, timeoutMs < 0 ? nullptr : &timeout, nullptr, 0) != 0 &&
+        errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT) {
+        TELEPHONY_LOGE("EventRingReader wait failed, errno %{public}d", errno);
+    }
+    return header->head.load(std::memory_order_acquire) >= next_;
+}
+
+uint64_t TelephonyEventRingReader::GetLostCount() const
+{
+    return lost_;
+}
+
+int32_t TelephonyEventRingReader::GetSlotId() const
+{
+    return GetHeader(address_)->slotId;
+}
+} // namespace Telephony
+} // namespace OHOS
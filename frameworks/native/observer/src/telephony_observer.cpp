@@ -17,6 +17,7 @@
 
 #include "telephony_errors.h"
 #include "telephony_log_wrapper.h"
+#include "telephony_observer_proxy.h"
 
 namespace OHOS {
 namespace Telephony {
@@ -54,6 +55,11 @@ void TelephonyObserver::OnCCallStateUpdated(
 
 void TelephonyObserver::OnSimActiveStateUpdated(int32_t slotId, bool enable) {}
 
+uint64_t TelephonyObserver::GetUpdateSequence()
+{
+    return TelephonyObserverProxy::GetCurrentSequence();
+}
+
 TelephonyObserver::TelephonyObserver()
 {
     memberFuncMap_[static_cast<uint32_t>(ObserverBrokerCode::ON_CALL_STATE_UPDATED)] =
@@ -94,10 +100,17 @@ int32_t TelephonyObserver::OnRemoteRequest(
         TELEPHONY_LOGE("verify token failed!");
         return TELEPHONY_ERR_DESCRIPTOR_MISMATCH;
     }
-    auto itFunc = memberFuncMap_.find(code);
+    uint32_t funcCode = code;
+    uint64_t sequence = 0;
+    if (!TelephonyObserverProxy::ReadSequence(funcCode, data, sequence)) {
+        TELEPHONY_LOGE("read sequence failed!");
+        return TELEPHONY_ERR_READ_DATA_FAIL;
+    }
+    auto itFunc = memberFuncMap_.find(funcCode);
     if (itFunc != memberFuncMap_.end()) {
         auto memberFunc = itFunc->second;
         if (memberFunc != nullptr) {
+            TelephonyObserverProxy::SequenceScope scope(sequence);
             memberFunc(data, reply);
             return OHOS::NO_ERROR;
         }
@@ -15,12 +15,17 @@
 
 #include "telephony_observer_client.h"
 
+#include <algorithm>
+
 #include "if_system_ability_manager.h"
+#include "ipc_object_stub.h"
 #include "iservice_registry.h"
+#include "state_registry_ipc_interface_code_ex.h"
 #include "state_registry_errors.h"
 #include "system_ability_definition.h"
 #include "telephony_log_wrapper.h"
 #include "telephony_state_registry_proxy.h"
+#include "telephony_types.h"
 
 namespace OHOS {
 namespace Telephony {
@@ -66,17 +71,181 @@ void TelephonyObserverClient::OnRemoteDied(const wptr<IRemoteObject> &remote)
         TELEPHONY_LOGE("OnRemoteDied failed, remote is nullptr");
         return;
     }
-    std::lock_guard<std::mutex> lock(mutexProxy_);
-    if (proxy_ == nullptr) {
-        TELEPHONY_LOGE("OnRemoteDied proxy_ is nullptr");
-        return;
-    }
-    auto serviceRemote = proxy_->AsObject();
-    if ((serviceRemote != nullptr) && (serviceRemote == remote.promote())) {
+    {
+        std::lock_guard<std::mutex> lock(mutexProxy_);
+        if (proxy_ == nullptr) {
+            TELEPHONY_LOGE("OnRemoteDied proxy_ is nullptr");
+            return;
+        }
+        auto serviceRemote = proxy_->AsObject();
+        if ((serviceRemote == nullptr) || (serviceRemote != remote.promote())) {
+            return;
+        }
         serviceRemote->RemoveDeathRecipient(deathRecipient_);
         proxy_ = nullptr;
         TELEPHONY_LOGE("on remote died");
     }
+    WaitForService();
+}
+
+void TelephonyObserverClient::WaitForService()
+{
+    sptr<ISystemAbilityManager> sam = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (sam == nullptr) {
+        TELEPHONY_LOGE("WaitForService failed to get system ability manager");
+        return;
+    }
+    sptr<ISystemAbilityStatusChange> listener = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        if (journal_.empty() || recovering_) {
+            return;
+        }
+        statusListener_ = new (std::nothrow) StateRegistryStatusListener(*this);
+        if (statusListener_ == nullptr) {
+            TELEPHONY_LOGE("WaitForService statusListener_ is nullptr");
+            return;
+        }
+        listener = statusListener_;
+        recovering_ = true;
+        diedTime_ = std::chrono::steady_clock::now();
+        TELEPHONY_LOGI("WaitForService %{public}zu observers to recover", journal_.size());
+    }
+    // Notified right away if the service is already back.
+    if (sam->SubscribeSystemAbility(TELEPHONY_STATE_REGISTRY_SYS_ABILITY_ID, listener) != ERR_NONE) {
+        TELEPHONY_LOGE("WaitForService subscribe state registry service failed");
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        if (statusListener_ == listener) {
+            statusListener_ = nullptr;
+            recovering_ = false;
+        }
+    }
+}
+
+void TelephonyObserverClient::Recover()
+{
+    std::vector<TelephonyObserverRegistration> registrations;
+    std::vector<std::pair<TelephonyObserverRegistration, TelephonyObserverDeliveryPolicy>> policyRegistrations;
+    sptr<ISystemAbilityStatusChange> listener = nullptr;
+    std::chrono::steady_clock::time_point diedTime;
+    {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        if (!recovering_) {
+            return;
+        }
+        recovering_ = false;
+        diedTime = diedTime_;
+        listener = statusListener_;
+        statusListener_ = nullptr;
+        for (const auto &[key, entry] : journal_) {
+            TelephonyObserverRegistration registration;
+            registration.observer = entry.observer;
+            registration.slotId = key.first;
+            registration.mask = key.second;
+            // The sequence numbers of the restarted service start over, the whole current state is notified.
+            registration.notifyNow = true;
+            registration.sinceSequence = 0;
+            registration.readsSequence = entry.readsSequence;
+            if (entry.policy.IsDefault()) {
+                registrations.push_back(registration);
+            } else {
+                policyRegistrations.emplace_back(registration, entry.policy);
+            }
+        }
+    }
+    uint32_t failedCount = 0;
+    uint32_t unsentCount = 0;
+    const size_t maxCount = static_cast<size_t>(TelephonyObserverRegistration::MAX_ENTRY_COUNT);
+    for (size_t begin = 0; begin < registrations.size(); begin += maxCount) {
+        std::vector<TelephonyObserverRegistration> chunk(registrations.begin() + begin,
+            registrations.begin() + std::min(begin + maxCount, registrations.size()));
+        std::vector<int32_t> results;
+        SendRegistrations(static_cast<uint32_t>(StateNotifyInterfaceCodeEx::ADD_OBSERVERS), true, chunk, results);
+        for (size_t i = 0; i < chunk.size(); i++) {
+            if (i < results.size() && results[i] == TELEPHONY_SUCCESS) {
+                continue;
+            }
+            // Rejected by the service, a request which did not get through stays for the next recovery.
+            if (i < results.size()) {
+                failedCount++;
+                JournalRemove(chunk[i].slotId, chunk[i].mask);
+            } else {
+                unsentCount++;
+            }
+        }
+    }
+    for (const auto &[registration, policy] : policyRegistrations) {
+        int32_t result = AddStateObserver(
+            registration.observer, registration.slotId, registration.mask, registration.notifyNow, policy);
+        if (result == TELEPHONY_SUCCESS) {
+            continue;
+        }
+        if (result == TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL) {
+            unsentCount++;
+        } else {
+            failedCount++;
+            JournalRemove(registration.slotId, registration.mask);
+        }
+    }
+    int64_t recoveryTimeMs = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - diedTime).count());
+    {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        recoveryStats_.recoveries++;
+        recoveryStats_.failedRegistrations += failedCount;
+        recoveryStats_.unsentRegistrations += unsentCount;
+        recoveryStats_.lastRecoveryTimeMs = recoveryTimeMs;
+        recoveryStats_.maxRecoveryTimeMs = std::max(recoveryStats_.maxRecoveryTimeMs, recoveryTimeMs);
+        // The observers left in the journal are added again once the service is back, unless a newer recovery
+        // already waits for it.
+        if (unsentCount > 0 && !recovering_ && listener != nullptr) {
+            recovering_ = true;
+            statusListener_ = listener;
+            listener = nullptr;
+        }
+    }
+    sptr<ISystemAbilityManager> sam = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (sam != nullptr && listener != nullptr) {
+        sam->UnSubscribeSystemAbility(TELEPHONY_STATE_REGISTRY_SYS_ABILITY_ID, listener);
+    }
+    TELEPHONY_LOGI("Recover %{public}zu observers in %{public}lld ms, %{public}u failed, %{public}u to retry",
+        registrations.size() + policyRegistrations.size(), static_cast<long long>(recoveryTimeMs), failedCount,
+        unsentCount);
+}
+
+TelephonyObserverClient::RecoveryStats TelephonyObserverClient::GetRecoveryStats()
+{
+    std::lock_guard<std::mutex> lock(journalMutex_);
+    return recoveryStats_;
+}
+
+void TelephonyObserverClient::JournalAdd(int32_t slotId, uint32_t mask,
+    const sptr<TelephonyObserverBroker> &observer, const TelephonyObserverDeliveryPolicy &policy, bool readsSequence)
+{
+    // The service keeps the first observer added with the same slot and mask.
+    std::lock_guard<std::mutex> lock(journalMutex_);
+    journal_.emplace(JournalKey(slotId, mask), JournalEntry { observer, policy, readsSequence });
+}
+
+void TelephonyObserverClient::JournalRemove(int32_t slotId, uint32_t mask)
+{
+    std::lock_guard<std::mutex> lock(journalMutex_);
+    journal_.erase(JournalKey(slotId, mask));
+}
+
+void TelephonyObserverClient::JournalModify(int32_t slotId, uint32_t mask, uint32_t newMask)
+{
+    std::lock_guard<std::mutex> lock(journalMutex_);
+    auto it = journal_.find(JournalKey(slotId, mask));
+    if (it == journal_.end() || newMask == mask) {
+        return;
+    }
+    JournalEntry entry = it->second;
+    journal_.erase(it);
+    // Merged into the observer already added with the new mask, if any.
+    if (newMask != 0) {
+        journal_.emplace(JournalKey(slotId, newMask), entry);
+    }
 }
 
 int32_t TelephonyObserverClient::AddStateObserver(const sptr<TelephonyObserverBroker> &telephonyObserver,
@@ -87,7 +256,301 @@ int32_t TelephonyObserverClient::AddStateObserver(const sptr<TelephonyObserverBr
         TELEPHONY_LOGE("proxy is null!");
         return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
     }
-    return proxy->RegisterStateChange(telephonyObserver, slotId, mask, isUpdate);
+    int32_t result = proxy->RegisterStateChange(telephonyObserver, slotId, mask, isUpdate);
+    if (result == TELEPHONY_SUCCESS && telephonyObserver != nullptr) {
+        JournalAdd(slotId, mask, telephonyObserver, TelephonyObserverDeliveryPolicy());
+    }
+    return result;
+}
+
+int32_t TelephonyObserverClient::AddStateObserver(const sptr<TelephonyObserverBroker> &telephonyObserver,
+    int32_t slotId, uint32_t mask, bool isUpdate, const TelephonyObserverDeliveryPolicy &policy)
+{
+    if (policy.IsDefault()) {
+        return AddStateObserver(telephonyObserver, slotId, mask, isUpdate);
+    }
+    if (telephonyObserver == nullptr || !policy.IsValid()) {
+        TELEPHONY_LOGE("AddStateObserver invalid observer or policy");
+        return TELEPHONY_ERR_ARGUMENT_INVALID;
+    }
+    auto proxy = GetProxy();
+    if (proxy == nullptr || proxy->AsObject() == nullptr) {
+        TELEPHONY_LOGE("proxy is null!");
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel in;
+    MessageParcel out;
+    MessageOption option;
+    if (!in.WriteInterfaceToken(ITelephonyStateNotify::GetDescriptor()) || !in.WriteInt32(slotId) ||
+        !in.WriteInt32(static_cast<int32_t>(mask)) || !in.WriteBool(isUpdate) ||
+        !in.WriteRemoteObject(telephonyObserver->AsObject()) || !policy.Marshalling(in)) {
+        TELEPHONY_LOGE("AddStateObserver write data failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    int32_t result = proxy->AsObject()->SendRequest(
+        static_cast<uint32_t>(StateNotifyInterfaceCodeEx::ADD_OBSERVER_WITH_POLICY), in, out, option);
+    if (result != ERR_NONE) {
+        TELEPHONY_LOGE("AddStateObserver with policy failed, error code is %{public}d", result);
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    result = out.ReadInt32();
+    if (result == TELEPHONY_SUCCESS) {
+        JournalAdd(slotId, mask, telephonyObserver, policy);
+    }
+    return result;
+}
+
+int32_t TelephonyObserverClient::AddStateObservers(
+    const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results)
+{
+    int32_t result = SendRegistrations(
+        static_cast<uint32_t>(StateNotifyInterfaceCodeEx::ADD_OBSERVERS), true, registrations, results);
+    for (size_t i = 0; i < results.size() && i < registrations.size(); i++) {
+        if (results[i] == TELEPHONY_SUCCESS) {
+            JournalAdd(registrations[i].slotId, registrations[i].mask, registrations[i].observer,
+                TelephonyObserverDeliveryPolicy(), registrations[i].readsSequence);
+        }
+    }
+    return result;
+}
+
+int32_t TelephonyObserverClient::RemoveStateObservers(
+    const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results)
+{
+    int32_t result = SendRegistrations(
+        static_cast<uint32_t>(StateNotifyInterfaceCodeEx::REMOVE_OBSERVERS), false, registrations, results);
+    for (size_t i = 0; i < results.size() && i < registrations.size(); i++) {
+        if (results[i] == TELEPHONY_SUCCESS) {
+            JournalRemove(registrations[i].slotId, registrations[i].mask);
+        }
+    }
+    return result;
+}
+
+int32_t TelephonyObserverClient::SendRegistrations(uint32_t code, bool withObserver,
+    const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results)
+{
+    results.clear();
+    if (registrations.empty() ||
+        registrations.size() > static_cast<size_t>(TelephonyObserverRegistration::MAX_ENTRY_COUNT)) {
+        TELEPHONY_LOGE("SendRegistrations count %{public}zu invalid", registrations.size());
+        return TELEPHONY_ERR_ARGUMENT_INVALID;
+    }
+    auto proxy = GetProxy();
+    if (proxy == nullptr || proxy->AsObject() == nullptr) {
+        TELEPHONY_LOGE("proxy is null!");
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel in;
+    MessageParcel out;
+    MessageOption option;
+    bool written = in.WriteInterfaceToken(ITelephonyStateNotify::GetDescriptor()) &&
+        in.WriteInt32(static_cast<int32_t>(registrations.size()));
+    for (const auto &registration : registrations) {
+        if (withObserver && registration.observer == nullptr) {
+            TELEPHONY_LOGE("SendRegistrations observer is null");
+            return TELEPHONY_ERR_ARGUMENT_INVALID;
+        }
+        written = written && in.WriteInt32(registration.slotId) && in.WriteUint32(registration.mask) &&
+            in.WriteBool(registration.notifyNow) && in.WriteUint64(registration.sinceSequence) &&
+            in.WriteBool(registration.readsSequence) &&
+            (!withObserver || in.WriteRemoteObject(registration.observer->AsObject()));
+    }
+    if (!written) {
+        TELEPHONY_LOGE("SendRegistrations write data failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    int32_t result = proxy->AsObject()->SendRequest(code, in, out, option);
+    if (result != ERR_NONE) {
+        TELEPHONY_LOGE("SendRegistrations failed, error code is %{public}d", result);
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    result = out.ReadInt32();
+    if (!out.ReadInt32Vector(&results)) {
+        results.clear();
+    }
+    return result;
+}
+
+int32_t TelephonyObserverClient::RemoveAllStateObservers()
+{
+    auto proxy = GetProxy();
+    if (proxy == nullptr || proxy->AsObject() == nullptr) {
+        TELEPHONY_LOGE("proxy is null!");
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel in;
+    MessageParcel out;
+    MessageOption option;
+    if (!in.WriteInterfaceToken(ITelephonyStateNotify::GetDescriptor())) {
+        TELEPHONY_LOGE("RemoveAllStateObservers write data failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    int32_t result = proxy->AsObject()->SendRequest(
+        static_cast<uint32_t>(StateNotifyInterfaceCodeEx::REMOVE_ALL_OBSERVERS), in, out, option);
+    if (result != ERR_NONE) {
+        TELEPHONY_LOGE("RemoveAllStateObservers failed, error code is %{public}d", result);
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    result = out.ReadInt32();
+    if (result == TELEPHONY_SUCCESS) {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        journal_.clear();
+    }
+    return result;
+}
+
+int32_t TelephonyObserverClient::GetStateSnapshot(int32_t slotId, std::vector<TelephonyStateSnapshot> &snapshots)
+{
+    auto proxy = GetProxy();
+    if (proxy == nullptr || proxy->AsObject() == nullptr) {
+        TELEPHONY_LOGE("proxy is null!");
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel in;
+    MessageParcel out;
+    MessageOption option;
+    if (!in.WriteInterfaceToken(ITelephonyStateNotify::GetDescriptor()) || !in.WriteInt32(slotId)) {
+        TELEPHONY_LOGE("GetStateSnapshot write data failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    int32_t result = proxy->AsObject()->SendRequest(
+        static_cast<uint32_t>(StateNotifyInterfaceCodeEx::GET_STATE_SNAPSHOT), in, out, option);
+    if (result != ERR_NONE) {
+        TELEPHONY_LOGE("GetStateSnapshot failed, error code is %{public}d", result);
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    result = out.ReadInt32();
+    snapshots.clear();
+    if (result != TELEPHONY_SUCCESS) {
+        return result;
+    }
+    int32_t count = out.ReadInt32();
+    // One per slot, the slot -1 included.
+    if (count < 0 || count > MAX_SLOT_COUNT + 1) {
+        TELEPHONY_LOGE("GetStateSnapshot count %{public}d invalid", count);
+        return TELEPHONY_ERR_READ_DATA_FAIL;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        TelephonyStateSnapshot snapshot;
+        if (!snapshot.ReadFromParcel(out)) {
+            TELEPHONY_LOGE("GetStateSnapshot read data failed");
+            snapshots.clear();
+            return TELEPHONY_ERR_READ_DATA_FAIL;
+        }
+        snapshots.push_back(std::move(snapshot));
+    }
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyObserverClient::GetStatePage(std::shared_ptr<TelephonyStatePageReader> &reader)
+{
+    auto proxy = GetProxy();
+    if (proxy == nullptr || proxy->AsObject() == nullptr) {
+        TELEPHONY_LOGE("proxy is null!");
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel in;
+    MessageParcel out;
+    MessageOption option;
+    if (!in.WriteInterfaceToken(ITelephonyStateNotify::GetDescriptor())) {
+        TELEPHONY_LOGE("GetStatePage write data failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    int32_t result = proxy->AsObject()->SendRequest(
+        static_cast<uint32_t>(StateNotifyInterfaceCodeEx::GET_STATE_PAGE), in, out, option);
+    if (result != ERR_NONE) {
+        TELEPHONY_LOGE("GetStatePage failed, error code is %{public}d", result);
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    result = out.ReadInt32();
+    reader = nullptr;
+    if (result != TELEPHONY_SUCCESS) {
+        return result;
+    }
+    reader = TelephonyStatePageReader::Create(out.ReadAshmem());
+    if (reader == nullptr) {
+        return TELEPHONY_ERR_READ_DATA_FAIL;
+    }
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyObserverClient::GetEventRing(
+    int32_t slotId, uint32_t mask, std::shared_ptr<TelephonyEventRingReader> &reader)
+{
+    auto proxy = GetProxy();
+    if (proxy == nullptr || proxy->AsObject() == nullptr) {
+        TELEPHONY_LOGE("proxy is null!");
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    sptr<IRemoteObject> ringClient;
+    {
+        std::lock_guard<std::mutex> lock(mutexProxy_);
+        if (ringClient_ == nullptr) {
+            ringClient_ = new (std::nothrow) IPCObjectStub(u"ohos.telephony.EventRingClient");
+        }
+        ringClient = ringClient_;
+    }
+    MessageParcel in;
+    MessageParcel out;
+    MessageOption option;
+    if (ringClient == nullptr || !in.WriteInterfaceToken(ITelephonyStateNotify::GetDescriptor()) ||
+        !in.WriteInt32(slotId) || !in.WriteUint32(mask) || !in.WriteRemoteObject(ringClient)) {
+        TELEPHONY_LOGE("GetEventRing write data failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    int32_t result = proxy->AsObject()->SendRequest(
+        static_cast<uint32_t>(StateNotifyInterfaceCodeEx::GET_EVENT_RING), in, out, option);
+    if (result != ERR_NONE) {
+        TELEPHONY_LOGE("GetEventRing failed, error code is %{public}d", result);
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    result = out.ReadInt32();
+    reader = nullptr;
+    if (result != TELEPHONY_SUCCESS) {
+        return result;
+    }
+    reader = TelephonyEventRingReader::Create(out.ReadAshmem());
+    if (reader == nullptr) {
+        return TELEPHONY_ERR_READ_DATA_FAIL;
+    }
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyObserverClient::UpdateStates(const TelephonyObserverUpdateBatch &batch, std::vector<int32_t> &results)
+{
+    int32_t count = batch.GetEntryCount();
+    if (count <= 0) {
+        TELEPHONY_LOGE("UpdateStates batch is empty");
+        return TELEPHONY_ERR_ARGUMENT_INVALID;
+    }
+    auto proxy = GetProxy();
+    if (proxy == nullptr || proxy->AsObject() == nullptr) {
+        TELEPHONY_LOGE("proxy is null!");
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel in;
+    MessageParcel out;
+    MessageOption option;
+    if (!in.WriteInterfaceToken(ITelephonyStateNotify::GetDescriptor()) || !batch.Marshalling(in)) {
+        TELEPHONY_LOGE("UpdateStates write data failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    int32_t result = proxy->AsObject()->SendRequest(
+        static_cast<uint32_t>(StateNotifyInterfaceCodeEx::BATCH_UPDATE), in, out, option);
+    if (result != ERR_NONE) {
+        TELEPHONY_LOGE("UpdateStates failed, error code is %{public}d", result);
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    result = out.ReadInt32();
+    int32_t resultCount = out.ReadInt32();
+    results.clear();
+    for (int32_t i = 0; i < resultCount && i < count; i++) {
+        results.push_back(out.ReadInt32());
+    }
+    // A batch rejected before its entries were read has no result per entry, none of them was published.
+    results.resize(static_cast<size_t>(count), result != TELEPHONY_SUCCESS ? result : TELEPHONY_ERR_READ_DATA_FAIL);
+    return result;
 }
 
 int32_t TelephonyObserverClient::RemoveStateObserver(int32_t slotId, uint32_t mask)
@@ -97,7 +560,41 @@ int32_t TelephonyObserverClient::RemoveStateObserver(int32_t slotId, uint32_t ma
         TELEPHONY_LOGE("proxy is null!");
         return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
     }
-    return proxy->UnregisterStateChange(slotId, mask);
+    int32_t result = proxy->UnregisterStateChange(slotId, mask);
+    if (result == TELEPHONY_SUCCESS) {
+        JournalRemove(slotId, mask);
+    }
+    return result;
+}
+
+int32_t TelephonyObserverClient::ModifyStateObserver(
+    int32_t slotId, uint32_t mask, uint32_t addMask, uint32_t removeMask, bool notifyNow)
+{
+    auto proxy = GetProxy();
+    if (proxy == nullptr || proxy->AsObject() == nullptr) {
+        TELEPHONY_LOGE("proxy is null!");
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    MessageParcel in;
+    MessageParcel out;
+    MessageOption option;
+    if (!in.WriteInterfaceToken(ITelephonyStateNotify::GetDescriptor()) || !in.WriteInt32(slotId) ||
+        !in.WriteUint32(mask) || !in.WriteUint32(addMask) || !in.WriteUint32(removeMask) ||
+        !in.WriteBool(notifyNow)) {
+        TELEPHONY_LOGE("ModifyStateObserver write data failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    int32_t result = proxy->AsObject()->SendRequest(
+        static_cast<uint32_t>(StateNotifyInterfaceCodeEx::MODIFY_OBSERVER_MASK), in, out, option);
+    if (result != ERR_NONE) {
+        TELEPHONY_LOGE("ModifyStateObserver failed, error code is %{public}d", result);
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    result = out.ReadInt32();
+    if (result == TELEPHONY_SUCCESS) {
+        JournalModify(slotId, mask, (mask | addMask) & ~removeMask);
+    }
+    return result;
 }
 }
 }
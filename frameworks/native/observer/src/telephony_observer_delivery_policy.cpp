@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_observer_delivery_policy.h"
+
+#include "parcel.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+// One day, longer intervals are surely a unit mistake of the caller.
+constexpr int32_t MAX_MIN_INTERVAL_MS = 24 * 60 * 60 * 1000;
+constexpr int32_t MAX_SIGNAL_DELTA_DBM = 200;
+} // namespace
+
+bool TelephonyObserverDeliveryPolicy::IsDefault() const
+{
+    return minIntervalMs == 0 && signalDeltaDbm == 0 && !levelChangeOnly;
+}
+
+bool TelephonyObserverDeliveryPolicy::IsValid() const
+{
+    return minIntervalMs >= 0 && minIntervalMs <= MAX_MIN_INTERVAL_MS && signalDeltaDbm >= 0 &&
+        signalDeltaDbm <= MAX_SIGNAL_DELTA_DBM;
+}
+
+bool TelephonyObserverDeliveryPolicy::operator==(const TelephonyObserverDeliveryPolicy &other) const
+{
+    return minIntervalMs == other.minIntervalMs && signalDeltaDbm == other.signalDeltaDbm &&
+        levelChangeOnly == other.levelChangeOnly;
+}
+
+bool TelephonyObserverDeliveryPolicy::operator!=(const TelephonyObserverDeliveryPolicy &other) const
+{
+    return !(*this == other);
+}
+
+bool TelephonyObserverDeliveryPolicy::Marshalling(Parcel &parcel) const
+{
+    return parcel.WriteInt32(minIntervalMs) && parcel.WriteInt32(signalDeltaDbm) && parcel.WriteBool(levelChangeOnly);
+}
+
+bool TelephonyObserverDeliveryPolicy::ReadFromParcel(Parcel &parcel)
+{
+    return parcel.ReadInt32(minIntervalMs) && parcel.ReadInt32(signalDeltaDbm) && parcel.ReadBool(levelChangeOnly);
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -21,6 +21,57 @@
 
 namespace OHOS {
 namespace Telephony {
+namespace {
+thread_local uint64_t g_currentSequence = 0;
+thread_local bool g_sequenceSent = false;
+
+bool IsSequenceSent()
+{
+    return g_sequenceSent && g_currentSequence != 0;
+}
+} // namespace
+
+TelephonyObserverProxy::SequenceScope::SequenceScope(uint64_t sequence, bool sent)
+    : previousSequence_(g_currentSequence), previousSent_(g_sequenceSent)
+{
+    g_currentSequence = sequence;
+    g_sequenceSent = sent;
+}
+
+TelephonyObserverProxy::SequenceScope::~SequenceScope()
+{
+    g_currentSequence = previousSequence_;
+    g_sequenceSent = previousSent_;
+}
+
+uint64_t TelephonyObserverProxy::GetCurrentSequence()
+{
+    return g_currentSequence;
+}
+
+bool TelephonyObserverProxy::WriteRequestHeader(MessageParcel &dataParcel)
+{
+    if (!dataParcel.WriteInterfaceToken(TelephonyObserverBroker::GetDescriptor())) {
+        return false;
+    }
+    return !IsSequenceSent() || dataParcel.WriteUint64(g_currentSequence);
+}
+
+uint32_t TelephonyObserverProxy::GetRequestCode(uint32_t code)
+{
+    return IsSequenceSent() ? (code | SEQUENCED_CODE_FLAG) : code;
+}
+
+bool TelephonyObserverProxy::ReadSequence(uint32_t &code, MessageParcel &dataParcel, uint64_t &sequence)
+{
+    sequence = 0;
+    if ((code & SEQUENCED_CODE_FLAG) == 0) {
+        return true;
+    }
+    code &= ~SEQUENCED_CODE_FLAG;
+    return dataParcel.ReadUint64(sequence);
+}
+
 TelephonyObserverProxy::TelephonyObserverProxy(const sptr<IRemoteObject> &impl)
     : IRemoteProxy<TelephonyObserverBroker>(impl)
 {}
@@ -33,7 +84,7 @@ int32_t TelephonyObserverProxy::SendRequest(
         TELEPHONY_LOGE("TelephonyObserverProxy remote is nullptr!, msgId: %{public}d", msgId);
         return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
     }
-    return remote->SendRequest(msgId, dataParcel, replyParcel, option);
+    return remote->SendRequest(GetRequestCode(static_cast<uint32_t>(msgId)), dataParcel, replyParcel, option);
 }
 
 void TelephonyObserverProxy::OnCallStateUpdated(
@@ -43,8 +94,8 @@ void TelephonyObserverProxy::OnCallStateUpdated(
     MessageParcel replyParcel;
     MessageOption option;
     option.SetFlags(MessageOption::TF_ASYNC);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnCallStateUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnCallStateUpdated WriteRequestHeader failed!");
         return;
     }
     dataParcel.WriteInt32(slotId);
@@ -62,8 +113,8 @@ void TelephonyObserverProxy::OnCallStateUpdatedEx(
     MessageParcel replyParcel;
     MessageOption option;
     option.SetFlags(MessageOption::TF_ASYNC);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnCallStateUpdatedEx WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnCallStateUpdatedEx WriteRequestHeader failed!");
         return;
     }
     dataParcel.WriteInt32(slotId);
@@ -80,8 +131,8 @@ void TelephonyObserverProxy::OnSimStateUpdated(
     MessageParcel replyParcel;
     MessageOption option;
     option.SetFlags(MessageOption::TF_ASYNC);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnSimStateUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnSimStateUpdated WriteRequestHeader failed!");
         return;
     }
     dataParcel.WriteInt32(slotId);
@@ -100,20 +151,13 @@ void TelephonyObserverProxy::OnSignalInfoUpdated(
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     option.SetFlags(MessageOption::TF_ASYNC | MessageOption::TF_ASYNC_WAKEUP_LATER);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnSignalInfoUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnSignalInfoUpdated WriteRequestHeader failed!");
         return;
     }
-    int32_t size = static_cast<int32_t>(vec.size());
-    if (size < 0 || size > SignalInformation::MAX_SIGNAL_NUM) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnSignalInfoUpdated size error!");
+    if (!WriteSignalInfo(dataParcel, slotId, vec)) {
         return;
     }
-    dataParcel.WriteInt32(slotId);
-    dataParcel.WriteInt32(size);
-    for (const auto &v : vec) {
-        v->Marshalling(dataParcel);
-    }
     auto code = SendRequest(
         static_cast<int32_t>(ObserverBrokerCode::ON_SIGNAL_INFO_UPDATED), dataParcel, replyParcel, option);
     TELEPHONY_LOGD("TelephonyObserverProxy::OnSignalInfoUpdated##error: %{public}d.", code);
@@ -126,50 +170,82 @@ void TelephonyObserverProxy::OnCellInfoUpdated(
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     option.SetFlags(MessageOption::TF_ASYNC);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnCellInfoUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnCellInfoUpdated WriteRequestHeader failed!");
         return;
     }
+    if (!WriteCellInfo(dataParcel, slotId, vec)) {
+        return;
+    }
+    auto code = SendRequest(
+        static_cast<int32_t>(ObserverBrokerCode::ON_CELL_INFO_UPDATED), dataParcel, replyParcel, option);
+    TELEPHONY_LOGD("TelephonyObserverProxy::OnCellInfoUpdated##error: %{public}d.", code);
+}
+
+void TelephonyObserverProxy::OnNetworkStateUpdated(
+    int32_t slotId, const sptr<NetworkState> &networkState)
+{
+    MessageOption option;
+    MessageParcel dataParcel;
+    MessageParcel replyParcel;
+    option.SetFlags(MessageOption::TF_ASYNC | MessageOption::TF_ASYNC_WAKEUP_LATER);
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnNetworkStateUpdated WriteRequestHeader failed!");
+        return;
+    }
+    WriteNetworkState(dataParcel, slotId, networkState);
+    auto code = SendRequest(
+        static_cast<int32_t>(ObserverBrokerCode::ON_NETWORK_STATE_UPDATED), dataParcel, replyParcel, option);
+    TELEPHONY_LOGD("TelephonyObserverProxy::OnNetworkStateUpdated##error: %{public}d.", code);
+}
+
+bool TelephonyObserverProxy::WriteSignalInfo(
+    MessageParcel &dataParcel, int32_t slotId, const std::vector<sptr<SignalInformation>> &vec)
+{
+    int32_t size = static_cast<int32_t>(vec.size());
+    if (size < 0 || size > SignalInformation::MAX_SIGNAL_NUM) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnSignalInfoUpdated size error!");
+        return false;
+    }
+    dataParcel.WriteInt32(slotId);
+    dataParcel.WriteInt32(size);
+    for (const auto &v : vec) {
+        v->Marshalling(dataParcel);
+    }
+    return true;
+}
+
+bool TelephonyObserverProxy::WriteCellInfo(
+    MessageParcel &dataParcel, int32_t slotId, const std::vector<sptr<CellInformation>> &vec)
+{
     dataParcel.WriteInt32(slotId);
     int32_t size = static_cast<int32_t>(vec.size());
     if (size <= 0) {
         TELEPHONY_LOGE("Cellinformation array length is less than or equal to 0!");
-        return;
+        return false;
     }
     if (size > CellInformation::MAX_CELL_NUM) {
         TELEPHONY_LOGE("Cellinformation array length is greater than MAX_CELL_NUM!");
-        return;
+        return false;
     }
     if (!dataParcel.WriteInt32(size)) {
         TELEPHONY_LOGE("Failed to write Cellinformation array size!");
-        return;
+        return false;
     }
     for (const auto &v : vec) {
         v->Marshalling(dataParcel);
     }
-    auto code = SendRequest(
-        static_cast<int32_t>(ObserverBrokerCode::ON_CELL_INFO_UPDATED), dataParcel, replyParcel, option);
-    TELEPHONY_LOGD("TelephonyObserverProxy::OnCellInfoUpdated##error: %{public}d.", code);
+    return true;
 }
 
-void TelephonyObserverProxy::OnNetworkStateUpdated(
-    int32_t slotId, const sptr<NetworkState> &networkState)
+bool TelephonyObserverProxy::WriteNetworkState(
+    MessageParcel &dataParcel, int32_t slotId, const sptr<NetworkState> &networkState)
 {
-    MessageOption option;
-    MessageParcel dataParcel;
-    MessageParcel replyParcel;
-    option.SetFlags(MessageOption::TF_ASYNC | MessageOption::TF_ASYNC_WAKEUP_LATER);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnNetworkStateUpdated WriteInterfaceToken failed!");
-        return;
-    }
     dataParcel.WriteInt32(slotId);
     if (networkState != nullptr) {
         networkState->Marshalling(dataParcel);
     }
-    auto code = SendRequest(
-        static_cast<int32_t>(ObserverBrokerCode::ON_NETWORK_STATE_UPDATED), dataParcel, replyParcel, option);
-    TELEPHONY_LOGD("TelephonyObserverProxy::OnNetworkStateUpdated##error: %{public}d.", code);
+    return true;
 }
 
 void TelephonyObserverProxy::OnCellularDataConnectStateUpdated(
@@ -179,8 +255,8 @@ void TelephonyObserverProxy::OnCellularDataConnectStateUpdated(
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     option.SetFlags(MessageOption::TF_ASYNC);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnCellularDataConnectStateUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnCellularDataConnectStateUpdated WriteRequestHeader failed!");
         return;
     }
     dataParcel.WriteInt32(slotId);
@@ -199,8 +275,8 @@ void TelephonyObserverProxy::OnCellularDataFlowUpdated(
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     option.SetFlags(MessageOption::TF_ASYNC | MessageOption::TF_ASYNC_WAKEUP_LATER);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnCellularDataFlowUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnCellularDataFlowUpdated WriteRequestHeader failed!");
         return;
     }
     dataParcel.WriteInt32(slotId);
@@ -216,8 +292,8 @@ void TelephonyObserverProxy::OnCfuIndicatorUpdated(int32_t slotId, bool cfuResul
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     option.SetFlags(MessageOption::TF_ASYNC);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnCfuIndicatorUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnCfuIndicatorUpdated WriteRequestHeader failed!");
         return;
     }
     dataParcel.WriteInt32(slotId);
@@ -233,8 +309,8 @@ void TelephonyObserverProxy::OnVoiceMailMsgIndicatorUpdated(int32_t slotId, bool
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     option.SetFlags(MessageOption::TF_ASYNC);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnVoiceMailMsgIndicatorUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnVoiceMailMsgIndicatorUpdated WriteRequestHeader failed!");
         return;
     }
     dataParcel.WriteInt32(slotId);
@@ -248,8 +324,8 @@ void TelephonyObserverProxy::OnVoiceMailMsgIndicatorUpdated(int32_t slotId, bool
 void TelephonyObserverProxy::OnIccAccountUpdated()
 {
     MessageParcel dataParcel;
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("WriteRequestHeader failed!");
         return;
     }
     MessageOption option;
@@ -267,8 +343,8 @@ void TelephonyObserverProxy::OnCCallStateUpdated(
     MessageParcel replyParcel;
     MessageOption option;
     option.SetFlags(MessageOption::TF_ASYNC);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnCCallStateUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnCCallStateUpdated WriteRequestHeader failed!");
         return;
     }
     dataParcel.WriteInt32(slotId);
@@ -285,8 +361,8 @@ void TelephonyObserverProxy::OnSimActiveStateUpdated(int32_t slotId, bool enable
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     option.SetFlags(MessageOption::TF_ASYNC);
-    if (!dataParcel.WriteInterfaceToken(GetDescriptor())) {
-        TELEPHONY_LOGE("TelephonyObserverProxy::OnSimActiveStateUpdated WriteInterfaceToken failed!");
+    if (!WriteRequestHeader(dataParcel)) {
+        TELEPHONY_LOGE("TelephonyObserverProxy::OnSimActiveStateUpdated WriteRequestHeader failed!");
         return;
     }
     dataParcel.WriteInt32(slotId);
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_observer_update_batch.h"
+
+#include "message_parcel.h"
+#include "state_registry_ipc_interface_code.h"
+#include "telephony_log_wrapper.h"
+#include "telephony_observer_proxy.h"
+
+namespace OHOS {
+namespace Telephony {
+bool TelephonyObserverUpdateBatch::AddSignalInfo(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec)
+{
+    return AddEntry(static_cast<uint32_t>(StateNotifyInterfaceCode::SIGNAL_INFO),
+        [slotId, &vec](MessageParcel &parcel) { return TelephonyObserverProxy::WriteSignalInfo(parcel, slotId, vec); });
+}
+
+bool TelephonyObserverUpdateBatch::AddCellInfo(int32_t slotId, const std::vector<sptr<CellInformation>> &vec)
+{
+    return AddEntry(static_cast<uint32_t>(StateNotifyInterfaceCode::CELL_INFO),
+        [slotId, &vec](MessageParcel &parcel) { return TelephonyObserverProxy::WriteCellInfo(parcel, slotId, vec); });
+}
+
+bool TelephonyObserverUpdateBatch::AddNetworkState(int32_t slotId, const sptr<NetworkState> &networkState)
+{
+    if (networkState == nullptr) {
+        TELEPHONY_LOGE("AddNetworkState networkState is null");
+        return false;
+    }
+    return AddEntry(static_cast<uint32_t>(StateNotifyInterfaceCode::NET_WORK_STATE),
+        [slotId, &networkState](MessageParcel &parcel) {
+            return TelephonyObserverProxy::WriteNetworkState(parcel, slotId, networkState);
+        });
+}
+
+bool TelephonyObserverUpdateBatch::AddCellularDataConnectState(int32_t slotId, int32_t dataState, int32_t networkType)
+{
+    return AddEntry(static_cast<uint32_t>(StateNotifyInterfaceCode::CELLULAR_DATA_STATE),
+        [slotId, dataState, networkType](MessageParcel &parcel) {
+            return parcel.WriteInt32(slotId) && parcel.WriteInt32(dataState) && parcel.WriteInt32(networkType);
+        });
+}
+
+bool TelephonyObserverUpdateBatch::AddCellularDataFlow(int32_t slotId, int32_t flowData)
+{
+    return AddEntry(static_cast<uint32_t>(StateNotifyInterfaceCode::CELLULAR_DATA_FLOW),
+        [slotId, flowData](MessageParcel &parcel) { return parcel.WriteInt32(slotId) && parcel.WriteInt32(flowData); });
+}
+
+int32_t TelephonyObserverUpdateBatch::GetEntryCount() const
+{
+    return static_cast<int32_t>(entries_.size());
+}
+
+void TelephonyObserverUpdateBatch::Clear()
+{
+    entries_.clear();
+}
+
+bool TelephonyObserverUpdateBatch::Marshalling(MessageParcel &parcel) const
+{
+    if (!parcel.WriteInt32(static_cast<int32_t>(entries_.size()))) {
+        return false;
+    }
+    for (const auto &entry : entries_) {
+        if (!parcel.WriteUint32(entry.code) || !parcel.WriteInt32(static_cast<int32_t>(entry.arguments.size())) ||
+            !parcel.WriteBuffer(entry.arguments.data(), entry.arguments.size())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Writer>
+bool TelephonyObserverUpdateBatch::AddEntry(uint32_t code, Writer writer)
+{
+    if (entries_.size() >= MAX_ENTRY_COUNT) {
+        TELEPHONY_LOGE("TelephonyObserverUpdateBatch is full, code %{public}u", code);
+        return false;
+    }
+    MessageParcel parcel;
+    if (!writer(parcel) || parcel.GetDataSize() == 0) {
+        TELEPHONY_LOGE("TelephonyObserverUpdateBatch write code %{public}u failed", code);
+        return false;
+    }
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(parcel.GetData());
+    entries_.push_back({ code, std::vector<uint8_t>(data, data + parcel.GetDataSize()) });
+    return true;
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -30,10 +30,57 @@ int32_t TelephonyStateManager::AddStateObserver(const sptr<TelephonyObserverBrok
         telephonyObserver, slotId, mask, notifyNow);
 }
 
+int32_t TelephonyStateManager::AddStateObserver(const sptr<TelephonyObserverBroker> &telephonyObserver,
+    int32_t slotId, uint32_t mask, bool notifyNow, const TelephonyObserverDeliveryPolicy &policy)
+{
+    return DelayedRefSingleton<TelephonyObserverClient>::GetInstance().AddStateObserver(
+        telephonyObserver, slotId, mask, notifyNow, policy);
+}
+
 int32_t TelephonyStateManager::RemoveStateObserver(int32_t slotId, uint32_t mask)
 {
     return DelayedRefSingleton<TelephonyObserverClient>::GetInstance().
         RemoveStateObserver(slotId, mask);
 }
+
+int32_t TelephonyStateManager::ModifyStateObserver(
+    int32_t slotId, uint32_t mask, uint32_t addMask, uint32_t removeMask, bool notifyNow)
+{
+    return DelayedRefSingleton<TelephonyObserverClient>::GetInstance().ModifyStateObserver(
+        slotId, mask, addMask, removeMask, notifyNow);
+}
+
+int32_t TelephonyStateManager::AddStateObservers(
+    const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results)
+{
+    return DelayedRefSingleton<TelephonyObserverClient>::GetInstance().AddStateObservers(registrations, results);
+}
+
+int32_t TelephonyStateManager::RemoveStateObservers(
+    const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results)
+{
+    return DelayedRefSingleton<TelephonyObserverClient>::GetInstance().RemoveStateObservers(registrations, results);
+}
+
+int32_t TelephonyStateManager::RemoveAllStateObservers()
+{
+    return DelayedRefSingleton<TelephonyObserverClient>::GetInstance().RemoveAllStateObservers();
+}
+
+int32_t TelephonyStateManager::GetStateSnapshot(int32_t slotId, std::vector<TelephonyStateSnapshot> &snapshots)
+{
+    return DelayedRefSingleton<TelephonyObserverClient>::GetInstance().GetStateSnapshot(slotId, snapshots);
+}
+
+int32_t TelephonyStateManager::GetStatePage(std::shared_ptr<TelephonyStatePageReader> &reader)
+{
+    return DelayedRefSingleton<TelephonyObserverClient>::GetInstance().GetStatePage(reader);
+}
+
+int32_t TelephonyStateManager::GetEventRing(
+    int32_t slotId, uint32_t mask, std::shared_ptr<TelephonyEventRingReader> &reader)
+{
+    return DelayedRefSingleton<TelephonyObserverClient>::GetInstance().GetEventRing(slotId, mask, reader);
+}
 } // namespace Telephony
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,343 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_multiplexer.h"
+
+#include "state_registry_errors.h"
+#include "telephony_errors.h"
+#include "telephony_log_wrapper.h"
+#include "telephony_observer_client.h"
+
+namespace OHOS {
+namespace Telephony {
+class TelephonyStateMultiplexer::SlotObserver : public TelephonyObserver {
+public:
+    SlotObserver(TelephonyStateMultiplexer &multiplexer, int32_t slotId)
+        : multiplexer_(multiplexer), slotId_(slotId)
+    {}
+    ~SlotObserver() = default;
+
+    void OnCallStateUpdated(int32_t slotId, int32_t callState, const std::u16string &phoneNumber) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE,
+            [slotId, callState, phoneNumber](const TelephonyStateListener &listener) {
+                if (listener.onCallStateUpdated) {
+                    listener.onCallStateUpdated(slotId, callState, phoneNumber);
+                }
+            });
+    }
+
+    void OnSignalInfoUpdated(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS,
+            [slotId, vec](const TelephonyStateListener &listener) {
+                if (listener.onSignalInfoUpdated) {
+                    listener.onSignalInfoUpdated(slotId, vec);
+                }
+            });
+    }
+
+    void OnNetworkStateUpdated(int32_t slotId, const sptr<NetworkState> &networkState) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE,
+            [slotId, networkState](const TelephonyStateListener &listener) {
+                if (listener.onNetworkStateUpdated) {
+                    listener.onNetworkStateUpdated(slotId, networkState);
+                }
+            });
+    }
+
+    void OnCellInfoUpdated(int32_t slotId, const std::vector<sptr<CellInformation>> &vec) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO,
+            [slotId, vec](const TelephonyStateListener &listener) {
+                if (listener.onCellInfoUpdated) {
+                    listener.onCellInfoUpdated(slotId, vec);
+                }
+            });
+    }
+
+    void OnSimStateUpdated(int32_t slotId, CardType type, SimState state, LockReason reason) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE,
+            [slotId, type, state, reason](const TelephonyStateListener &listener) {
+                if (listener.onSimStateUpdated) {
+                    listener.onSimStateUpdated(slotId, type, state, reason);
+                }
+            });
+    }
+
+    void OnCellularDataConnectStateUpdated(int32_t slotId, int32_t dataState, int32_t networkType) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE,
+            [slotId, dataState, networkType](const TelephonyStateListener &listener) {
+                if (listener.onCellularDataConnectStateUpdated) {
+                    listener.onCellularDataConnectStateUpdated(slotId, dataState, networkType);
+                }
+            });
+    }
+
+    void OnCellularDataFlowUpdated(int32_t slotId, int32_t dataFlowType) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW,
+            [slotId, dataFlowType](const TelephonyStateListener &listener) {
+                if (listener.onCellularDataFlowUpdated) {
+                    listener.onCellularDataFlowUpdated(slotId, dataFlowType);
+                }
+            });
+    }
+
+    void OnCfuIndicatorUpdated(int32_t slotId, bool cfuResult) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR,
+            [slotId, cfuResult](const TelephonyStateListener &listener) {
+                if (listener.onCfuIndicatorUpdated) {
+                    listener.onCfuIndicatorUpdated(slotId, cfuResult);
+                }
+            });
+    }
+
+    void OnVoiceMailMsgIndicatorUpdated(int32_t slotId, bool voiceMailMsgResult) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR,
+            [slotId, voiceMailMsgResult](const TelephonyStateListener &listener) {
+                if (listener.onVoiceMailMsgIndicatorUpdated) {
+                    listener.onVoiceMailMsgIndicatorUpdated(slotId, voiceMailMsgResult);
+                }
+            });
+    }
+
+    void OnIccAccountUpdated() override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT, [](const TelephonyStateListener &listener) {
+            if (listener.onIccAccountUpdated) {
+                listener.onIccAccountUpdated();
+            }
+        });
+    }
+
+    void OnCallStateUpdatedEx(int32_t slotId, int32_t callStateEx) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX,
+            [slotId, callStateEx](const TelephonyStateListener &listener) {
+                if (listener.onCallStateUpdatedEx) {
+                    listener.onCallStateUpdatedEx(slotId, callStateEx);
+                }
+            });
+    }
+
+    void OnCCallStateUpdated(int32_t slotId, int32_t callState, const std::u16string &phoneNumber) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_CCALL_STATE,
+            [slotId, callState, phoneNumber](const TelephonyStateListener &listener) {
+                if (listener.onCCallStateUpdated) {
+                    listener.onCCallStateUpdated(slotId, callState, phoneNumber);
+                }
+            });
+    }
+
+    void OnSimActiveStateUpdated(int32_t slotId, bool enable) override
+    {
+        Dispatch(TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE,
+            [slotId, enable](const TelephonyStateListener &listener) {
+                if (listener.onSimActiveStateUpdated) {
+                    listener.onSimActiveStateUpdated(slotId, enable);
+                }
+            });
+    }
+
+private:
+    void Dispatch(uint32_t event, const Event &callback)
+    {
+        // Events are keyed by the slot the observer is registered for, the slot -1 receives the events of each slot.
+        multiplexer_.Dispatch(slotId_, event, callback);
+    }
+
+private:
+    TelephonyStateMultiplexer &multiplexer_;
+    int32_t slotId_ = 0;
+};
+
+TelephonyStateMultiplexer::TelephonyStateMultiplexer() = default;
+TelephonyStateMultiplexer::~TelephonyStateMultiplexer() = default;
+
+int32_t TelephonyStateMultiplexer::AddListener(int32_t slotId, uint32_t mask, const TelephonyStateListener &listener,
+    bool notifyNow, int32_t &listenerId)
+{
+    if (mask == 0) {
+        TELEPHONY_LOGE("AddListener mask is empty");
+        return TELEPHONY_ERR_ARGUMENT_INVALID;
+    }
+    auto sharedListener = std::make_shared<const TelephonyStateListener>(listener);
+    std::vector<Event> replays;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        WaitRegistration(lock, slotId);
+        SlotEntry &slot = slots_[slotId];
+        uint32_t registeredMask = slot.mask;
+        uint32_t addedMask = mask & ~registeredMask;
+        sptr<TelephonyObserver> observer = slot.observer;
+        bool created = observer == nullptr;
+        if (created) {
+            observer = new (std::nothrow) SlotObserver(*this, slotId);
+            slot.observer = observer;
+        }
+        int32_t result = TELEPHONY_SUCCESS;
+        if (observer == nullptr) {
+            result = TELEPHONY_ERR_LOCAL_PTR_NULL;
+        } else if (created || addedMask != 0) {
+            // The slot is kept while pending, its events received meanwhile are recorded for the replay below.
+            slot.pending = true;
+            lock.unlock();
+            auto &client = DelayedRefSingleton<TelephonyObserverClient>::GetInstance();
+            result = created ? client.AddStateObserver(observer, slotId, mask, notifyNow) :
+                client.ModifyStateObserver(slotId, registeredMask, addedMask, 0, notifyNow);
+            lock.lock();
+            EndRegistration(slot);
+        }
+        if (result != TELEPHONY_SUCCESS) {
+            TELEPHONY_LOGE("AddListener slotId %{public}d mask %{public}u failed %{public}d", slotId, mask, result);
+            if (slot.mask == 0) {
+                slots_.erase(slotId);
+            }
+            return result;
+        }
+        if (notifyNow) {
+            // The events already received are replayed, the initial state notified by the service included.
+            for (const auto &lastEvent : slot.lastEvents) {
+                if ((mask & lastEvent.first) != 0) {
+                    replays.push_back(lastEvent.second);
+                }
+            }
+        }
+        slot.mask |= mask;
+        listenerId = ++nextListenerId_;
+        listeners_[listenerId] = { slotId, mask, sharedListener };
+        TELEPHONY_LOGI("AddListener %{public}d slotId %{public}d mask %{public}u, registered mask %{public}u",
+            listenerId, slotId, mask, slot.mask);
+    }
+    for (const auto &replay : replays) {
+        replay(*sharedListener);
+    }
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyStateMultiplexer::RemoveListener(int32_t listenerId)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = listeners_.find(listenerId);
+    while (it != listeners_.end()) {
+        int32_t slotId = it->second.slotId;
+        auto slotIt = slots_.find(slotId);
+        if (slotIt == slots_.end() || !slotIt->second.pending) {
+            break;
+        }
+        WaitRegistration(lock, slotId);
+        it = listeners_.find(listenerId);
+    }
+    if (it == listeners_.end()) {
+        TELEPHONY_LOGE("RemoveListener %{public}d not exist", listenerId);
+        return TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST;
+    }
+    int32_t slotId = it->second.slotId;
+    listeners_.erase(it);
+    auto slotIt = slots_.find(slotId);
+    if (slotIt == slots_.end()) {
+        return TELEPHONY_SUCCESS;
+    }
+    SlotEntry &slot = slotIt->second;
+    uint32_t mask = GetListenerMask(slotId);
+    if (mask == slot.mask) {
+        return TELEPHONY_SUCCESS;
+    }
+    uint32_t registeredMask = slot.mask;
+    slot.pending = true;
+    lock.unlock();
+    auto &client = DelayedRefSingleton<TelephonyObserverClient>::GetInstance();
+    int32_t result = mask == 0 ? client.RemoveStateObserver(slotId, registeredMask) :
+        client.ModifyStateObserver(slotId, registeredMask, 0, registeredMask & ~mask, false);
+    lock.lock();
+    EndRegistration(slot);
+    // On failure the slot keeps the registered mask, the observer is still registered with it.
+    if (result == TELEPHONY_SUCCESS && mask == 0) {
+        slots_.erase(slotId);
+    } else if (result == TELEPHONY_SUCCESS) {
+        for (auto eventIt = slot.lastEvents.begin(); eventIt != slot.lastEvents.end();) {
+            eventIt = (eventIt->first & mask) != 0 ? std::next(eventIt) : slot.lastEvents.erase(eventIt);
+        }
+        slot.mask = mask;
+    }
+    TELEPHONY_LOGI("RemoveListener %{public}d slotId %{public}d, registered mask %{public}u result %{public}d",
+        listenerId, slotId, mask, result);
+    return result;
+}
+
+uint32_t TelephonyStateMultiplexer::GetRegisteredMask(int32_t slotId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = slots_.find(slotId);
+    return it == slots_.end() ? 0 : it->second.mask;
+}
+
+uint32_t TelephonyStateMultiplexer::GetListenerMask(int32_t slotId)
+{
+    // Called with mutex_ held.
+    uint32_t mask = 0;
+    for (const auto &entry : listeners_) {
+        if (entry.second.slotId == slotId) {
+            mask |= entry.second.mask;
+        }
+    }
+    return mask;
+}
+
+void TelephonyStateMultiplexer::WaitRegistration(std::unique_lock<std::mutex> &lock, int32_t slotId)
+{
+    registrationDone_.wait(lock, [this, slotId]() {
+        auto it = slots_.find(slotId);
+        return it == slots_.end() || !it->second.pending;
+    });
+}
+
+void TelephonyStateMultiplexer::EndRegistration(SlotEntry &slot)
+{
+    // Called with mutex_ held, a pending slot is never erased so the entry is still valid.
+    slot.pending = false;
+    registrationDone_.notify_all();
+}
+
+void TelephonyStateMultiplexer::Dispatch(int32_t slotId, uint32_t event, const Event &callback)
+{
+    std::vector<std::shared_ptr<const TelephonyStateListener>> listeners;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto slotIt = slots_.find(slotId);
+        if (slotIt == slots_.end()) {
+            return;
+        }
+        slotIt->second.lastEvents[event] = callback;
+        for (const auto &entry : listeners_) {
+            if (entry.second.slotId == slotId && (entry.second.mask & event) != 0) {
+                listeners.push_back(entry.second.listener);
+            }
+        }
+    }
+    // Called out of the lock, a listener may add or remove listeners.
+    for (const auto &listener : listeners) {
+        callback(*listener);
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
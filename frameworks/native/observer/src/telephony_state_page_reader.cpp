@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_page_reader.h"
+
+#include <thread>
+
+#include "telephony_log_wrapper.h"
+#include "telephony_state_page.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr int32_t ALL_SLOT_ID = -1;
+// The service may die in the middle of a write, a reader never waits for it forever.
+constexpr uint32_t MAX_READ_RETRY_COUNT = 1000;
+} // namespace
+
+std::shared_ptr<TelephonyStatePageReader> TelephonyStatePageReader::Create(const sptr<Ashmem> &ashmem)
+{
+    if (ashmem == nullptr || !ashmem->MapReadOnlyAshmem()) {
+        TELEPHONY_LOGE("StatePageReader map ashmem failed");
+        return nullptr;
+    }
+    int32_t size = ashmem->GetAshmemSize();
+    const void *address = nullptr;
+    if (size >= static_cast<int32_t>(sizeof(TelephonyStatePage::Header))) {
+        address = ashmem->ReadFromAshmem(size, 0);
+    }
+    auto header = reinterpret_cast<const TelephonyStatePage::Header *>(address);
+    if (header == nullptr || header->magic != TelephonyStatePage::MAGIC ||
+        header->layoutVersion != TelephonyStatePage::LAYOUT_VERSION ||
+        header->fieldCount != TelephonyStatePage::FIELD_COUNT ||
+        TelephonyStatePage::GetSize(header->slotCount) > static_cast<size_t>(size)) {
+        TELEPHONY_LOGE("StatePageReader page of size %{public}d invalid", size);
+        ashmem->UnmapAshmem();
+        ashmem->CloseAshmem();
+        return nullptr;
+    }
+    return std::make_shared<TelephonyStatePageReader>(ashmem, address, header->slotCount);
+}
+
+TelephonyStatePageReader::TelephonyStatePageReader(
+    const sptr<Ashmem> &ashmem, const void *address, uint32_t slotCount)
+    : ashmem_(ashmem), address_(address), slotCount_(slotCount)
+{}
+
+TelephonyStatePageReader::~TelephonyStatePageReader()
+{
+    if (ashmem_ != nullptr) {
+        ashmem_->UnmapAshmem();
+        ashmem_->CloseAshmem();
+    }
+}
+
+bool TelephonyStatePageReader::Read(int32_t slotId, TelephonyStateSnapshot &snapshot) const
+{
+    int64_t index = static_cast<int64_t>(slotId) - ALL_SLOT_ID;
+    if (index < 0 || index >= static_cast<int64_t>(slotCount_)) {
+        return false;
+    }
+    auto header = reinterpret_cast<const TelephonyStatePage::Header *>(address_);
+    auto slot = reinterpret_cast<const TelephonyStatePage::Slot *>(
+        reinterpret_cast<const uint8_t *>(address_) + sizeof(TelephonyStatePage::Header)) + index;
+    uint32_t validFields = 0;
+    int32_t values[TelephonyStatePage::FIELD_COUNT] = { 0 };
+    uint64_t versions[TelephonyStatePage::FIELD_COUNT] = { 0 };
+    for (uint32_t retry = 0; retry < MAX_READ_RETRY_COUNT; retry++) {
+        uint32_t commit = header->commitSequence.load(std::memory_order_acquire);
+        uint32_t begin = slot->sequence.load(std::memory_order_acquire);
+        if ((commit & 1u) != 0 || (begin & 1u) != 0) {
+            // A batch update is short, the writer is given the processor instead of spinning.
+            std::this_thread::yield();
+            continue;
+        }
+        validFields = slot->validFields.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < TelephonyStatePage::FIELD_COUNT; i++) {
+            values[i] = slot->values[i].load(std::memory_order_relaxed);
+            versions[i] = slot->versions[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) != begin ||
+            header->commitSequence.load(std::memory_order_relaxed) != commit) {
+            continue;
+        }
+        snapshot = TelephonyStateSnapshot();
+        snapshot.slotId = slotId;
+        for (uint32_t i = 0; i < TelephonyStatePage::FIELD_COUNT; i++) {
+            if ((validFields & (1u << i)) != 0) {
+                snapshot.Set(static_cast<TelephonyStateSnapshot::Field>(i), values[i], versions[i]);
+            }
+        }
+        return true;
+    }
+    TELEPHONY_LOGE("StatePageReader slot %{public}d is being written", slotId);
+    return false;
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_snapshot.h"
+
+#include "parcel.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr uint32_t ALL_FIELDS = (1u << TelephonyStateSnapshot::FIELD_COUNT) - 1;
+} // namespace
+
+bool TelephonyStateSnapshot::Has(Field field) const
+{
+    uint32_t index = static_cast<uint32_t>(field);
+    return index < FIELD_COUNT && (fields & (1u << index)) != 0;
+}
+
+int32_t TelephonyStateSnapshot::Get(Field field) const
+{
+    return Has(field) ? values[static_cast<uint32_t>(field)] : 0;
+}
+
+uint64_t TelephonyStateSnapshot::GetSequence(Field field) const
+{
+    return Has(field) ? sequences[static_cast<uint32_t>(field)] : 0;
+}
+
+void TelephonyStateSnapshot::Set(Field field, int32_t value, uint64_t sequence)
+{
+    uint32_t index = static_cast<uint32_t>(field);
+    if (index >= FIELD_COUNT) {
+        return;
+    }
+    fields |= (1u << index);
+    values[index] = value;
+    sequences[index] = sequence;
+}
+
+bool TelephonyStateSnapshot::Marshalling(Parcel &parcel) const
+{
+    if (!parcel.WriteInt32(slotId) || !parcel.WriteUint32(fields)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < FIELD_COUNT; i++) {
+        if ((fields & (1u << i)) == 0) {
+            continue;
+        }
+        if (!parcel.WriteInt32(values[i]) || !parcel.WriteUint64(sequences[i])) {
+            return false;
+        }
+    }
+    if (Has(Field::CALL_INCOMING_NUMBER)) {
+        return parcel.WriteString16(callIncomingNumber);
+    }
+    return true;
+}
+
+bool TelephonyStateSnapshot::ReadFromParcel(Parcel &parcel)
+{
+    if (!parcel.ReadInt32(slotId) || !parcel.ReadUint32(fields) || (fields & ~ALL_FIELDS) != 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < FIELD_COUNT; i++) {
+        if ((fields & (1u << i)) == 0) {
+            continue;
+        }
+        if (!parcel.ReadInt32(values[i]) || !parcel.ReadUint64(sequences[i])) {
+            return false;
+        }
+    }
+    if (Has(Field::CALL_INCOMING_NUMBER)) {
+        return parcel.ReadString16(callIncomingNumber);
+    }
+    return true;
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_EVENT_RING_READER_H
+#define TELEPHONY_EVENT_RING_READER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ashmem.h"
+#include "telephony_observer.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * @brief Read-only mapping of a signal or cell event ring of the service.
+ *
+ * Events are read straight from the shared memory and delivered to a TelephonyObserver as if they were received
+ * from the service. A reader starts with the events written after it is created and is used by one thread at a time.
+ */
+class TelephonyEventRingReader {
+public:
+    /**
+     * @brief Map an event ring read-only.
+     *
+     * @param ashmem Indicates the ring received from the service.
+     * @return Return the reader, nullptr if the ring can not be mapped or its layout is not supported.
+     */
+    static std::shared_ptr<TelephonyEventRingReader> Create(const sptr<Ashmem> &ashmem);
+
+    TelephonyEventRingReader(const sptr<Ashmem> &ashmem, const void *address);
+    ~TelephonyEventRingReader();
+
+    /**
+     * @brief Deliver the events written since the last poll.
+     *
+     * @param observer Indicates the observer receiving the events through OnSignalInfoUpdated or OnCellInfoUpdated.
+     * @param maxEvents Indicates the maximum number of events to deliver.
+     * @return Return the number of events delivered.
+     */
+    uint32_t Poll(TelephonyObserver &observer, uint32_t maxEvents);
+
+    /**
+     * @brief Block until an event is written or the timeout expires.
+     *
+     * @param timeoutMs Indicates the timeout in milliseconds, negative to wait without timeout.
+     * @return Return true if an event is ready to be polled.
+     */
+    bool Wait(int32_t timeoutMs) const;
+
+    /**
+     * @brief Number of events overwritten before this reader could poll them.
+     */
+    uint64_t GetLostCount() const;
+
+    int32_t GetSlotId() const;
+
+private:
+    struct Event {
+        uint32_t code = 0;
+        uint64_t stateSequence = 0;
+        std::vector<uint8_t> arguments;
+    };
+
+    bool ReadEvent(uint64_t sequence, Event &event) const;
+    void Deliver(TelephonyObserver &observer, const Event &event) const;
+
+private:
+    sptr<Ashmem> ashmem_;
+    const void *address_ = nullptr;
+    uint64_t next_ = 1;
+    uint64_t lost_ = 0;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_EVENT_RING_READER_H
@@ -147,6 +147,15 @@ public:
      */
     void OnSimActiveStateUpdated(int32_t slotId, bool enable) override;
 
+    /**
+     * @brief Get the sequence number of the state notified by the callback running on the calling thread.
+     *
+     * Sequence numbers increase with every change of the state of the service, across every slot and event.
+     *
+     * @return Return the sequence number, 0 if the service did not send one.
+     */
+    static uint64_t GetUpdateSequence();
+
 private:
     using TelephonyObserverFunc = std::function<void(MessageParcel &data, MessageParcel &reply)>;
 
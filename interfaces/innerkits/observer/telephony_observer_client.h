@@ -16,18 +16,42 @@
 #ifndef TELEPHONY_OBSERVER_CLIENT_H
 #define TELEPHONY_OBSERVER_CLIENT_H
 
+#include <chrono>
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <iremote_object.h>
 #include <singleton.h>
 
 #include "i_telephony_state_notify.h"
+#include "system_ability_status_change_stub.h"
+#include "telephony_event_ring_reader.h"
+#include "telephony_observer_delivery_policy.h"
+#include "telephony_observer_registration.h"
+#include "telephony_observer_update_batch.h"
+#include "telephony_state_page_reader.h"
+#include "telephony_state_snapshot.h"
 
 namespace OHOS {
 namespace Telephony {
+/**
+ * The observers added through the client are kept in a journal. When the state registry service dies, they are added
+ * again in bulk once the service is back, with their current state notified.
+ */
 class TelephonyObserverClient : public DelayedRefSingleton<TelephonyObserverClient> {
     DECLARE_DELAYED_REF_SINGLETON(TelephonyObserverClient);
 
 public:
+    struct RecoveryStats {
+        uint32_t recoveries = 0;
+        // Rejected by the restarted service, removed from the journal.
+        uint32_t failedRegistrations = 0;
+        // Not sent because the request failed, kept in the journal for the next recovery.
+        uint32_t unsentRegistrations = 0;
+        int64_t lastRecoveryTimeMs = 0;
+        int64_t maxRecoveryTimeMs = 0;
+    };
+
     /**
      * @brief Add state observer.
      *
@@ -40,6 +64,19 @@ public:
     int32_t AddStateObserver(const sptr<TelephonyObserverBroker> &telephonyObserver,
         int32_t slotId, uint32_t mask, bool isUpdate);
 
+    /**
+     * @brief Add state observer with a delivery policy.
+     *
+     * @param telephonyObserver Indicates the TelephonyObserverBroker.
+     * @param slotId Indicates the slot identification.
+     * @param mask Indicates the event type mask.
+     * @param isUpdate Whether to update data immediately.
+     * @param policy Indicates how often the signal and cell information are notified.
+     * @return Return 0 if add succeed, others if add failed.
+     */
+    int32_t AddStateObserver(const sptr<TelephonyObserverBroker> &telephonyObserver,
+        int32_t slotId, uint32_t mask, bool isUpdate, const TelephonyObserverDeliveryPolicy &policy);
+
     /**
      * @brief Remove state observer.
      *
@@ -49,6 +86,92 @@ public:
      */
     int32_t RemoveStateObserver(int32_t slotId, uint32_t mask);
 
+    /**
+     * @brief Add and remove event types of an added state observer in place.
+     *
+     * @param slotId Indicates the slot identification.
+     * @param mask Indicates the event type mask the observer is added with.
+     * @param addMask Indicates the event types to add.
+     * @param removeMask Indicates the event types to remove, the observer is removed when none is left.
+     * @param notifyNow Whether to update the data of the added event types immediately.
+     * @return Return 0 if modify successful, others if modify failed.
+     */
+    int32_t ModifyStateObserver(int32_t slotId, uint32_t mask, uint32_t addMask, uint32_t removeMask, bool notifyNow);
+
+    /**
+     * @brief Add several state observers in one request.
+     *
+     * @param registrations Indicates the observer, slot, event type mask and notifyNow of each pair.
+     * @param results Set to the result of each pair, in the order of the registrations.
+     * @return Return 0 if the request is handled, others if it failed as a whole.
+     */
+    int32_t AddStateObservers(
+        const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results);
+
+    /**
+     * @brief Remove several state observers in one request.
+     *
+     * @param registrations Indicates the slot and event type mask of each pair.
+     * @param results Set to the result of each pair, in the order of the registrations.
+     * @return Return 0 if the request is handled, others if it failed as a whole.
+     */
+    int32_t RemoveStateObservers(
+        const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results);
+
+    /**
+     * @brief Remove every state observer added by this process.
+     *
+     * @return Return 0 if remove successful, others if remove failed.
+     */
+    int32_t RemoveAllStateObservers();
+
+    /**
+     * @brief Read the cached state of a slot in one request.
+     *
+     * @param slotId Indicates the slot identification, TelephonyStateSnapshot::ALL_SLOTS for every slot.
+     * @param snapshots Set to the state of the slot, or of every slot which has a state.
+     * @return Return 0 if read successful, others if read failed.
+     */
+    int32_t GetStateSnapshot(int32_t slotId, std::vector<TelephonyStateSnapshot> &snapshots);
+
+    /**
+     * @brief Map the page the service publishes the scalar state of every slot into.
+     *
+     * The page only holds the fields the caller is permitted to observe, the others are never valid in it.
+     *
+     * @param reader Set to the read-only mapping of the page, it is read with no IPC.
+     * @return Return 0 if map successful, a permission error if the caller can not observe any scalar state.
+     */
+    int32_t GetStatePage(std::shared_ptr<TelephonyStatePageReader> &reader);
+
+    /**
+     * @brief Map the ring the signal or cell events of a slot are written into.
+     *
+     * The service writes the ring from the first request on, until every process that requested it died. The events
+     * are polled from the ring with no IPC, an observer only reading the ring does not need to be added.
+     *
+     * @param slotId Indicates the slot identification.
+     * @param mask Indicates OBSERVER_MASK_SIGNAL_STRENGTHS or OBSERVER_MASK_CELL_INFO.
+     * @param reader Set to the read-only mapping of the ring.
+     * @return Return 0 if map successful, others if map failed.
+     */
+    int32_t GetEventRing(int32_t slotId, uint32_t mask, std::shared_ptr<TelephonyEventRingReader> &reader);
+
+    /**
+     * @brief Publish several state updates in one request.
+     *
+     * The slot, the permissions and the request code of every update are checked first, a batch with a rejected
+     * update publishes none of them. An update which fails to decode afterwards is the only one left out, the batch
+     * is then published in part. The observers still get one callback per update, queued back to back, not one
+     * callback for the whole batch.
+     *
+     * @param batch Indicates the updates, in the order they are committed.
+     * @param results Set to the result of each update, in the order of the batch. When the batch is rejected, an
+     * update which passed the checks is set to the failure of the batch.
+     * @return Return 0 if every update is published, otherwise the first failure.
+     */
+    int32_t UpdateStates(const TelephonyObserverUpdateBatch &batch, std::vector<int32_t> &results);
+
     /**
      * @brief Get the state registry proxy.
      *
@@ -56,6 +179,14 @@ public:
      */
     sptr<ITelephonyStateNotify> GetProxy();
 
+    /**
+     * @brief Get the totals of the observer recoveries after a restart of the service.
+     *
+     * @return Return the number of recoveries, of the observers the restarted service rejected, and the time from
+     * the death of the service to the end of the last and of the slowest recovery.
+     */
+    RecoveryStats GetRecoveryStats();
+
 private:
     class StateRegistryDeathRecipient : public IRemoteObject::DeathRecipient {
     public:
@@ -70,12 +201,55 @@ private:
         TelephonyObserverClient &client_;
     };
 
+    class StateRegistryStatusListener : public SystemAbilityStatusChangeStub {
+    public:
+        explicit StateRegistryStatusListener(TelephonyObserverClient &client) : client_(client) {}
+        ~StateRegistryStatusListener() override = default;
+        void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override
+        {
+            client_.Recover();
+        }
+        void OnRemoveSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override {}
+
+    private:
+        TelephonyObserverClient &client_;
+    };
+
+    struct JournalEntry {
+        sptr<TelephonyObserverBroker> observer = nullptr;
+        TelephonyObserverDeliveryPolicy policy;
+        bool readsSequence = false;
+    };
+    using JournalKey = std::pair<int32_t, uint32_t>;
+
     void OnRemoteDied(const wptr<IRemoteObject> &remote);
+    void JournalAdd(int32_t slotId, uint32_t mask, const sptr<TelephonyObserverBroker> &observer,
+        const TelephonyObserverDeliveryPolicy &policy, bool readsSequence = false);
+    void JournalRemove(int32_t slotId, uint32_t mask);
+    void JournalModify(int32_t slotId, uint32_t mask, uint32_t newMask);
+    /**
+     * Subscribe to the service being added back, when there is an observer to recover.
+     */
+    void WaitForService();
+    /**
+     * Add the observers of the journal to the restarted service.
+     */
+    void Recover();
+    int32_t SendRegistrations(uint32_t code, bool withObserver,
+        const std::vector<TelephonyObserverRegistration> &registrations, std::vector<int32_t> &results);
 
 private:
     std::mutex mutexProxy_;
     sptr<ITelephonyStateNotify> proxy_ {nullptr};
     sptr<IRemoteObject::DeathRecipient> deathRecipient_ {nullptr};
+    // Kept alive as long as the process, the service drops the event rings once it died, guarded by mutexProxy_.
+    sptr<IRemoteObject> ringClient_ {nullptr};
+    std::mutex journalMutex_;
+    std::map<JournalKey, JournalEntry> journal_;
+    sptr<ISystemAbilityStatusChange> statusListener_ {nullptr};
+    bool recovering_ = false;
+    std::chrono::steady_clock::time_point diedTime_;
+    RecoveryStats recoveryStats_;
 };
 } // namespace Telephony
 } // namespace OHOS
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_MULTIPLEXER_H
+#define TELEPHONY_STATE_MULTIPLEXER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <singleton.h>
+#include <string>
+#include <vector>
+
+#include "telephony_observer.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * @brief In-process callbacks of a state listener, a callback left empty is not called.
+ */
+struct TelephonyStateListener {
+    std::function<void(int32_t slotId, int32_t callState, const std::u16string &phoneNumber)> onCallStateUpdated;
+    std::function<void(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec)> onSignalInfoUpdated;
+    std::function<void(int32_t slotId, const sptr<NetworkState> &networkState)> onNetworkStateUpdated;
+    std::function<void(int32_t slotId, const std::vector<sptr<CellInformation>> &vec)> onCellInfoUpdated;
+    std::function<void(int32_t slotId, CardType type, SimState state, LockReason reason)> onSimStateUpdated;
+    std::function<void(int32_t slotId, int32_t dataState, int32_t networkType)> onCellularDataConnectStateUpdated;
+    std::function<void(int32_t slotId, int32_t dataFlowType)> onCellularDataFlowUpdated;
+    std::function<void(int32_t slotId, bool cfuResult)> onCfuIndicatorUpdated;
+    std::function<void(int32_t slotId, bool voiceMailMsgResult)> onVoiceMailMsgIndicatorUpdated;
+    std::function<void()> onIccAccountUpdated;
+    std::function<void(int32_t slotId, int32_t callStateEx)> onCallStateUpdatedEx;
+    std::function<void(int32_t slotId, int32_t callState, const std::u16string &phoneNumber)> onCCallStateUpdated;
+    std::function<void(int32_t slotId, bool enable)> onSimActiveStateUpdated;
+};
+
+/**
+ * @brief Process-wide multiplexer of the state observers.
+ *
+ * The listeners of a slot share one observer registered with the union of their event type masks, so the service
+ * keeps one record and sends one callback per event to the process whatever the number of listeners. The mask of
+ * the observer is only modified when the union changes.
+ */
+class TelephonyStateMultiplexer : public DelayedRefSingleton<TelephonyStateMultiplexer> {
+    DECLARE_DELAYED_REF_SINGLETON(TelephonyStateMultiplexer);
+
+public:
+    /**
+     * @brief Add a listener.
+     *
+     * @param slotId Indicates the slot identification.
+     * @param mask Indicates the event type mask.
+     * @param listener Indicates the callbacks, called on the binder threads of the process.
+     * @param notifyNow Whether to notify the current state of the events immediately.
+     * @param listenerId Set to the identification of the listener.
+     * @return Return 0 if add succeed, others if add failed.
+     */
+    int32_t AddListener(int32_t slotId, uint32_t mask, const TelephonyStateListener &listener, bool notifyNow,
+        int32_t &listenerId);
+
+    /**
+     * @brief Remove a listener.
+     *
+     * @param listenerId Indicates the identification returned by AddListener.
+     * @return Return 0 if remove succeed, others if remove failed.
+     */
+    int32_t RemoveListener(int32_t listenerId);
+
+    /**
+     * @brief Get the event type mask the observer of a slot is registered with.
+     *
+     * @return Return the union of the masks of the listeners of the slot, 0 if it has none.
+     */
+    uint32_t GetRegisteredMask(int32_t slotId);
+
+private:
+    using Event = std::function<void(const TelephonyStateListener &listener)>;
+
+    class SlotObserver;
+
+    struct ListenerEntry {
+        int32_t slotId = 0;
+        uint32_t mask = 0;
+        std::shared_ptr<const TelephonyStateListener> listener;
+    };
+
+    struct SlotEntry {
+        sptr<TelephonyObserver> observer;
+        uint32_t mask = 0;
+        /**
+         * Last event received for each mask bit, replayed to the listeners added with notifyNow.
+         */
+        std::map<uint32_t, Event> lastEvents;
+        /**
+         * Set while the registration of the observer is changed out of mutex_, the other changes of the slot wait.
+         */
+        bool pending = false;
+    };
+
+    void Dispatch(int32_t slotId, uint32_t event, const Event &callback);
+    uint32_t GetListenerMask(int32_t slotId);
+    /**
+     * Wait until no registration of the slot is pending, mutex_ is released meanwhile.
+     */
+    void WaitRegistration(std::unique_lock<std::mutex> &lock, int32_t slotId);
+    void EndRegistration(SlotEntry &slot);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable registrationDone_;
+    std::map<int32_t, SlotEntry> slots_;
+    std::map<int32_t, ListenerEntry> listeners_;
+    int32_t nextListenerId_ = 0;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_MULTIPLEXER_H
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_PAGE_READER_H
+#define TELEPHONY_STATE_PAGE_READER_H
+
+#include <cstdint>
+#include <memory>
+
+#include "ashmem.h"
+#include "telephony_state_snapshot.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * @brief Read-only mapping of the state page of the service.
+ *
+ * Reads take no IPC, each one returns a consistent copy of the scalar state of a slot. The page never holds the
+ * call incoming number.
+ */
+class TelephonyStatePageReader {
+public:
+    /**
+     * @brief Map a state page read-only.
+     *
+     * @param ashmem Indicates the page received from the service.
+     * @return Return the reader, nullptr if the page can not be mapped or its layout is not supported.
+     */
+    static std::shared_ptr<TelephonyStatePageReader> Create(const sptr<Ashmem> &ashmem);
+
+    TelephonyStatePageReader(const sptr<Ashmem> &ashmem, const void *address, uint32_t slotCount);
+    ~TelephonyStatePageReader();
+
+    /**
+     * @brief Read the scalar state of a slot.
+     *
+     * @param slotId Indicates the slot identification, -1 for the call state of all slots.
+     * @param snapshot Set to the published fields of the slot and their sequence number.
+     * @return Return true if read successful, false if the slot is out of the page or the page is being written
+     * for too long.
+     */
+    bool Read(int32_t slotId, TelephonyStateSnapshot &snapshot) const;
+
+private:
+    sptr<Ashmem> ashmem_;
+    const void *address_ = nullptr;
+    uint32_t slotCount_ = 0;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_PAGE_READER_H
@@ -816,6 +816,35 @@ declare namespace observer {
      * @since 11
      */
     slotId: number;
+
+    /**
+     * Indicates the minimum interval in milliseconds between two signal or cell information notifications.
+     * A notification coming earlier is held back and only the latest one is delivered when the interval expires.
+     *
+     * @type { ?number }
+     * @syscap SystemCapability.Telephony.StateRegistry
+     * @since 20
+     */
+    minInterval?: number;
+
+    /**
+     * Indicates the change in dBm of the signal below which a signal or cell information notification is dropped
+     * when the signal level is unchanged.
+     *
+     * @type { ?number }
+     * @syscap SystemCapability.Telephony.StateRegistry
+     * @since 20
+     */
+    signalDelta?: number;
+
+    /**
+     * Indicates whether signal or cell information is only notified when the signal level changes.
+     *
+     * @type { ?boolean }
+     * @syscap SystemCapability.Telephony.StateRegistry
+     * @since 20
+     */
+    levelChangeOnly?: boolean;
   }
 
   /**
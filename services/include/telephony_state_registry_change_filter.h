@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_CHANGE_FILTER_H
+#define TELEPHONY_STATE_REGISTRY_CHANGE_FILTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Suppression of the updates which repeat the state already published.
+ *
+ * The events it applies to are read from the system parameter persist.telephony.state_registry.suppress_mask,
+ * a mask of observer mask bits, signal strengths, network state, data connection state and data flow by default.
+ * Besides the counters, the filter keeps the fingerprint of the last update parcel of each event and slot so that
+ * the stub can drop a repeated update before decoding it. A fingerprint is bound to the version of the state its
+ * update committed or matched, it is only kept while that version is still the last one committed.
+ */
+class TelephonyStateRegistryChangeFilter {
+public:
+    explicit TelephonyStateRegistryChangeFilter(int32_t slotSize);
+    ~TelephonyStateRegistryChangeFilter() = default;
+
+    bool IsEnabled(uint32_t event) const;
+
+    /**
+     * Hash of the bytes of an update parcel.
+     */
+    static uint64_t Fingerprint(const uint8_t *data, size_t size);
+
+    /**
+     * Whether the fingerprint is the one of the last update of the event and slot, false while a commit is running.
+     */
+    bool IsSameFingerprint(uint32_t event, int32_t slotId, uint64_t fingerprint) const;
+
+    /**
+     * Keep the fingerprint of an update of the event and slot.
+     *
+     * @param version Version of the state the update committed or matched.
+     * @return bool false when the state changed since, or is being changed, and the fingerprint is not kept.
+     */
+    bool SetFingerprint(uint32_t event, int32_t slotId, uint64_t version, uint64_t fingerprint);
+
+    /**
+     * Bracket a commit of the state of the event and slot. The fingerprint kept is forgotten and none is kept until
+     * the commit ends, EndCommit takes the version of the committed state.
+     */
+    void BeginCommit(uint32_t event, int32_t slotId);
+    void EndCommit(uint32_t event, int32_t slotId, uint64_t version);
+
+    /**
+     * Account an update suppressed.
+     *
+     * @param event Observer mask bit of the event.
+     * @param fromParcel Whether the update was dropped by its fingerprint before being decoded.
+     */
+    void CountSuppressed(uint32_t event, bool fromParcel);
+
+    uint64_t GetSuppressedCount(uint32_t event) const;
+    uint64_t GetParcelSuppressedCount() const;
+
+private:
+    struct Entry {
+        uint64_t fingerprint = 0;
+        uint64_t version = 0;
+        uint32_t runningCommits = 0;
+    };
+
+    static int32_t GetEventIndex(uint32_t event);
+    Entry *GetEntry(uint32_t event, int32_t slotId) const;
+
+private:
+    static constexpr int32_t EVENT_COUNT = 4;
+    uint32_t enabledEvents_ = 0;
+    int32_t slotCount_ = 0;
+    // Guards the entries, held for a few loads and stores.
+    mutable std::mutex mutex_;
+    std::unique_ptr<Entry[]> entries_;
+    std::atomic<uint64_t> suppressed_[EVENT_COUNT] = {};
+    std::atomic<uint64_t> parcelSuppressed_ { 0 };
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_CHANGE_FILTER_H
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_DISPATCHER_H
+#define TELEPHONY_STATE_REGISTRY_DISPATCHER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Runs the notification jobs of the state updates on dedicated threads.
+ *
+ * Jobs are sharded by slot: all the jobs of one slot run on the same worker, in the order they were dispatched, so
+ * observers see the updates of a slot in the order the producers committed them. Workers are started on the first
+ * dispatch and drain their queue before stopping.
+ */
+class TelephonyStateRegistryDispatcher {
+public:
+    using Job = std::function<void()>;
+
+    /**
+     * @param workerCount Number of worker threads, at least one.
+     */
+    explicit TelephonyStateRegistryDispatcher(uint32_t workerCount);
+    ~TelephonyStateRegistryDispatcher();
+
+    /**
+     * Queue a job behind the previous jobs of the same slot.
+     *
+     * @param slotId Slot the job notifies, -1 for the jobs which are not bound to a slot.
+     * @param job Notification job.
+     * @return bool false when the job could not be queued and has been run on the calling thread.
+     */
+    bool Dispatch(int32_t slotId, Job job);
+
+    /**
+     * Block until every job queued before the call has run.
+     */
+    void Flush();
+
+    /**
+     * Run the remaining jobs then stop and join the workers.
+     */
+    void Stop();
+
+    size_t GetPendingCount();
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::condition_variable idleCondition;
+        std::deque<Job> jobs;
+        bool running = false;
+        bool stopping = false;
+        bool busy = false;
+        std::thread thread;
+    };
+
+    bool StartWorker(Worker &worker, uint32_t index);
+    void Run(Worker &worker);
+
+private:
+    std::vector<std::unique_ptr<Worker>> workers_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_DISPATCHER_H
@@ -29,12 +29,16 @@ public:
     explicit TelephonyStateRegistryDumpHelper();
     ~TelephonyStateRegistryDumpHelper() = default;
     bool Dump(const std::vector<std::string> &args,
-        std::vector<TelephonyStateRegistryRecord> &stateRecords, std::string &result) const;
+        const TelephonyStateRegistrySubscribers &subscribers, std::string &result) const;
 
 private:
     bool ShowTelephonyStateRegistryInfo(
-        std::vector<TelephonyStateRegistryRecord> &stateRecords, std::string &result) const;
+        const TelephonyStateRegistrySubscribers &subscribers, std::string &result) const;
     void ShowTelephonyChangeState(std::string &result) const;
+    /**
+     * Print the fan-out metrics, then clear them when reset is true.
+     */
+    bool ShowMetrics(bool reset, std::string &result) const;
     bool WhetherHasSimCard(const int32_t slotId) const;
 };
 } // namespace Telephony
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_EVENT_PUBLISHER_H
+#define TELEPHONY_STATE_REGISTRY_EVENT_PUBLISHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Publishes the common events of the state updates on a dedicated thread.
+ *
+ * Events are published in the order they were posted. The state-like kinds coalesce per slot: an event posted while
+ * the previous one of the same kind and slot is still queued replaces it, and an event of such a kind is held back
+ * until the minimum interval of its kind has passed since the last one of the same slot was published. Call and
+ * SIM state events are transitions, they are never coalesced nor held back. A coalescing kind has one queued event
+ * per slot at most, so the capacity only bounds the transitions: when it is reached the oldest transition is dropped,
+ * logged and counted under its kind.
+ */
+class TelephonyStateRegistryEventPublisher {
+public:
+    using Publish = std::function<bool()>;
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    enum class Kind : uint32_t {
+        CALL_STATE = 0,
+        CALL_STATE_WITH_NUMBER,
+        SIM_STATE,
+        SIGNAL_INFO,
+        NETWORK_STATE,
+        DATA_CONNECT_STATE,
+        KIND_COUNT,
+    };
+
+    struct Stats {
+        size_t depth = 0;
+        uint64_t published = 0;
+        uint64_t coalesced = 0;
+        uint64_t failed = 0;
+        uint64_t dropped = 0;
+        uint64_t droppedKinds[static_cast<uint32_t>(Kind::KIND_COUNT)] = { 0 };
+    };
+
+    /**
+     * The minimum intervals are read from the system parameters persist.telephony.state_registry.event_interval.*,
+     * in milliseconds, signal information defaults to one second and the other kinds to no interval.
+     */
+    explicit TelephonyStateRegistryEventPublisher(size_t capacity = DEFAULT_CAPACITY);
+    ~TelephonyStateRegistryEventPublisher();
+
+    static bool IsCoalescing(Kind kind);
+
+    /**
+     * Name of the common event action published for a kind.
+     */
+    static const char *GetKindName(Kind kind);
+
+    /**
+     * Queue an event.
+     *
+     * @param kind Kind of the event.
+     * @param slotId Slot of the event.
+     * @param publish Builds and publishes the event, returns whether it was published.
+     */
+    void Post(Kind kind, int32_t slotId, Publish publish);
+
+    /**
+     * Set the minimum interval between two events of a coalescing kind and slot, ignored for the other kinds.
+     */
+    void SetMinInterval(Kind kind, uint32_t intervalMs);
+
+    /**
+     * Block until every queued event has been published, held back events included.
+     */
+    void Flush();
+
+    /**
+     * Drop the queued events then stop and join the thread.
+     */
+    void Stop();
+
+    Stats GetStats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Key = std::pair<uint32_t, int32_t>;
+
+    struct Entry {
+        Key key;
+        bool coalesce = false;
+        Publish publish;
+    };
+
+    void Run();
+    Clock::time_point GetReadyTime(const Entry &entry) const;
+    void CountDropped(const Entry &entry);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable idleCondition_;
+    std::deque<Entry> entries_;
+    std::map<Key, Clock::time_point> lastPublishTimes_;
+    uint32_t intervalsMs_[static_cast<uint32_t>(Kind::KIND_COUNT)] = { 0 };
+    size_t capacity_ = DEFAULT_CAPACITY;
+    // Queued events of the kinds which do not coalesce.
+    size_t transitionCount_ = 0;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+    Stats stats_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_EVENT_PUBLISHER_H
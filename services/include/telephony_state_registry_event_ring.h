@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_EVENT_RING_H
+#define TELEPHONY_STATE_REGISTRY_EVENT_RING_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ashmem.h"
+#include "telephony_event_ring.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Writing side of a shared memory event ring, see TelephonyEventRing.
+ *
+ * Writes are serialized by the ring. Each write wakes the readers waiting on the ring, no binder transaction is
+ * involved.
+ */
+class TelephonyStateRegistryEventRing {
+public:
+    /**
+     * Map a shared memory region for writing and lay the ring out in it.
+     *
+     * The caller reduces the protection of the region afterwards so that the readers can only map it read-only.
+     *
+     * @param ashmem Region of at least TelephonyEventRing::GetSize bytes.
+     * @param slotId Slot of the events.
+     * @param mask Observer mask bit of the events.
+     * @param entryCount Number of entries, rounded up to a power of two.
+     * @param entrySize Maximum size of the arguments of an event.
+     * @return Ring, nullptr when the region is too small or can not be mapped.
+     */
+    static std::shared_ptr<TelephonyStateRegistryEventRing> Create(const sptr<Ashmem> &ashmem, int32_t slotId,
+        uint32_t mask, uint32_t entryCount = TelephonyEventRing::DEFAULT_ENTRY_COUNT,
+        uint32_t entrySize = TelephonyEventRing::DEFAULT_ENTRY_SIZE);
+
+    TelephonyStateRegistryEventRing(const sptr<Ashmem> &ashmem, void *address, size_t size);
+    ~TelephonyStateRegistryEventRing();
+
+    /**
+     * Append an event.
+     *
+     * @param code Observer broker code of the event.
+     * @param stateSequence Sequence number of the state the event carries.
+     * @param arguments Encoded callback arguments.
+     * @return bool false when the arguments do not fit in an entry, the readers see the event as lost.
+     */
+    bool Write(uint32_t code, uint64_t stateSequence, const std::vector<uint8_t> &arguments);
+
+    sptr<Ashmem> GetAshmem() const;
+
+private:
+    TelephonyEventRing::Header *GetHeader() const;
+    TelephonyEventRing::Entry *GetEntry(uint64_t sequence) const;
+
+private:
+    std::mutex writeMutex_;
+    sptr<Ashmem> ashmem_;
+    void *address_ = nullptr;
+    size_t size_ = 0;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_EVENT_RING_H
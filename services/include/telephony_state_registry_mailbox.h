@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_MAILBOX_H
+#define TELEPHONY_STATE_REGISTRY_MAILBOX_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Bounded outbound queue of one observer.
+ *
+ * Deliveries run in the order they were posted. A coalescing delivery replaces the undelivered one posted with the
+ * same key, so a slow observer only receives the latest value of a state. When the queue is full the oldest
+ * coalescing delivery is dropped. A delivery which does not coalesce is never dropped: when no coalescing one is
+ * left the observer is marked for resync, a resync delivery notifying its current state is queued in place of the
+ * deliveries posted until it runs.
+ */
+class TelephonyStateRegistryMailbox {
+public:
+    using Job = std::function<void()>;
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    struct Stats {
+        size_t depth = 0;
+        uint64_t delivered = 0;
+        uint64_t coalesced = 0;
+        uint64_t dropped = 0;
+        uint64_t resyncs = 0;
+        /**
+         * Deliveries replaced by a resync.
+         */
+        uint64_t resynced = 0;
+        uint64_t deadObjectErrors = 0;
+    };
+
+    explicit TelephonyStateRegistryMailbox(size_t capacity = DEFAULT_CAPACITY);
+    ~TelephonyStateRegistryMailbox() = default;
+
+    /**
+     * Build the coalescing key of an event of a slot.
+     *
+     * @param event Observer mask bit of the event.
+     * @param slotId Slot of the event.
+     */
+    static uint64_t MakeKey(uint32_t event, int32_t slotId);
+
+    /**
+     * Set the delivery notifying the current state of the observer, queued when the mailbox overflows. Without one
+     * the mailbox grows past its capacity instead.
+     */
+    void SetResync(Job resync);
+
+    /**
+     * Queue a delivery.
+     *
+     * @param key Coalescing key, see MakeKey.
+     * @param coalesce Whether the delivery replaces an undelivered one with the same key.
+     * @param job Delivery.
+     * @return bool true when the mailbox was idle and has to be scheduled.
+     */
+    bool Post(uint64_t key, bool coalesce, Job job);
+
+    /**
+     * Run some queued deliveries.
+     *
+     * @param maxJobs Maximum number of deliveries to run.
+     * @return bool true when deliveries remain and the mailbox has to be scheduled again.
+     */
+    bool Drain(size_t maxJobs);
+
+    /**
+     * Drop every queued delivery, they are counted as dropped.
+     */
+    void Clear();
+
+    /**
+     * Account the outcome of a delivery to the observer.
+     *
+     * @param deadObject Whether the observer was found dead after the delivery.
+     * @return uint32_t Number of consecutive deliveries which found the observer dead.
+     */
+    uint32_t RecordDeliveryResult(bool deadObject);
+
+    Stats GetStats();
+
+private:
+    struct Entry {
+        uint64_t key = 0;
+        bool coalesce = false;
+        bool resync = false;
+        Job job;
+    };
+
+    bool Schedule();
+
+private:
+    std::mutex mutex_;
+    std::deque<Entry> entries_;
+    size_t capacity_ = DEFAULT_CAPACITY;
+    bool scheduled_ = false;
+    Job resync_;
+    // A resync delivery is queued, the deliveries posted until it runs are covered by it.
+    bool resyncPending_ = false;
+    uint32_t consecutiveDeadObjectErrors_ = 0;
+    Stats stats_;
+};
+
+/**
+ * Threads draining the mailboxes which have pending deliveries.
+ *
+ * A mailbox is drained by one thread at a time and goes back to the end of the ready queue after a batch, so an
+ * observer that is slow to receive only holds one thread and does not delay the others.
+ */
+class TelephonyStateRegistryDeliveryPool {
+public:
+    explicit TelephonyStateRegistryDeliveryPool(uint32_t threadCount);
+    ~TelephonyStateRegistryDeliveryPool();
+
+    void Schedule(const std::shared_ptr<TelephonyStateRegistryMailbox> &mailbox);
+
+    /**
+     * Block until every scheduled mailbox is empty.
+     */
+    void Flush();
+
+    /**
+     * Drain the scheduled mailboxes then stop and join the threads.
+     */
+    void Stop();
+
+private:
+    void Run();
+
+private:
+    static constexpr size_t DRAIN_BATCH_SIZE = 8;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable idleCondition_;
+    std::deque<std::shared_ptr<TelephonyStateRegistryMailbox>> ready_;
+    std::vector<std::thread> threads_;
+    uint32_t threadCount_ = 1;
+    uint32_t busyCount_ = 0;
+    bool stopping_ = false;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_MAILBOX_H
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_METRICS_H
+#define TELEPHONY_STATE_REGISTRY_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Lock free log-linear histogram, each power of two range is split in four linear buckets so the percentiles are
+ * within 25% of the recorded values.
+ */
+class TelephonyStateRegistryHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 2;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;
+    static constexpr uint32_t BUCKET_COUNT = 96;
+
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+        uint64_t p50 = 0;
+        uint64_t p90 = 0;
+        uint64_t p99 = 0;
+    };
+
+    void Record(uint64_t value);
+    Snapshot GetSnapshot() const;
+
+    static uint32_t GetBucketIndex(uint64_t value);
+    /**
+     * Smallest value of a bucket, the values of bucket i are in [GetBucketLowerBound(i), GetBucketLowerBound(i + 1)).
+     */
+    static uint64_t GetBucketLowerBound(uint32_t index);
+
+private:
+    uint64_t GetPercentile(uint64_t count, uint32_t percent) const;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_ {};
+    std::atomic<uint64_t> sum_ { 0 };
+    std::atomic<uint64_t> max_ { 0 };
+};
+
+/**
+ * Always on fan-out instrumentation per event and slot.
+ *
+ * The counters are relaxed atomics, the cell of an event and slot is created on its first update. Reset swaps the
+ * cells out, the fan-outs still in flight finish on the cells they started on.
+ */
+class TelephonyStateRegistryMetrics {
+public:
+    static constexpr uint32_t EVENT_COUNT = 32;
+    static constexpr int32_t MIN_SLOT_ID = -1;
+    static constexpr int32_t MAX_SLOT_ID = 3;
+    static constexpr uint32_t SLOT_COUNT = static_cast<uint32_t>(MAX_SLOT_ID - MIN_SLOT_ID + 1);
+
+    struct Cell {
+        std::atomic<uint64_t> updates { 0 };
+        std::atomic<uint64_t> matched { 0 };
+        std::atomic<uint64_t> notified { 0 };
+        std::atomic<uint64_t> ipcFailures { 0 };
+        TelephonyStateRegistryHistogram fanOutTimeUs;
+        TelephonyStateRegistryHistogram sendTimeUs;
+    };
+
+    /**
+     * One update fanned out to its matched subscribers, the wall time is recorded once every delivery holding it
+     * has run or has been dropped.
+     */
+    class FanOut {
+    public:
+        explicit FanOut(std::shared_ptr<Cell> cell);
+        ~FanOut();
+
+        /**
+         * Account a delivery to one observer.
+         *
+         * @param sendTimeUs Time spent sending the notification.
+         * @param ipcFailed Whether the observer was found dead after the notification.
+         */
+        void RecordNotification(uint64_t sendTimeUs, bool ipcFailed);
+
+    private:
+        std::shared_ptr<Cell> cell_;
+        std::chrono::steady_clock::time_point begin_;
+    };
+
+    TelephonyStateRegistryMetrics();
+    ~TelephonyStateRegistryMetrics() = default;
+
+    /**
+     * Account an update and start timing its fan-out.
+     *
+     * @param event Observer mask bit of the event.
+     * @param slotId Slot of the event.
+     * @param matched Number of subscribers the update is delivered to.
+     * @return nullptr when the event or the slot is not tracked.
+     */
+    std::shared_ptr<FanOut> BeginFanOut(uint32_t event, int32_t slotId, size_t matched);
+
+    void Reset();
+    void Dump(std::string &result) const;
+
+private:
+    static bool GetCellIndex(uint32_t event, int32_t slotId, uint32_t &index);
+    static const char *GetEventName(uint32_t bit);
+
+private:
+    std::array<std::shared_ptr<Cell>, EVENT_COUNT * SLOT_COUNT> cells_;
+    std::atomic<int64_t> resetTimeMs_ { 0 };
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_METRICS_H
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_PAYLOAD_H
+#define TELEPHONY_STATE_REGISTRY_PAYLOAD_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "message_parcel.h"
+#include "telephony_observer_broker.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Observer callback arguments encoded once and sent as is to every remote observer.
+ *
+ * The bytes are the ones TelephonyObserverProxy writes after the interface token. Observers living in the service
+ * process are not remote, they keep receiving the decoded arguments.
+ */
+class TelephonyStateRegistryPayload {
+public:
+    struct Stats {
+        uint64_t events = 0;
+        uint64_t sends = 0;
+        uint64_t savedMarshalTimeUs = 0;
+    };
+
+    static std::shared_ptr<TelephonyStateRegistryPayload> CreateSignalInfo(
+        int32_t slotId, const std::vector<sptr<SignalInformation>> &vec);
+    static std::shared_ptr<TelephonyStateRegistryPayload> CreateCellInfo(
+        int32_t slotId, const std::vector<sptr<CellInformation>> &vec);
+    static std::shared_ptr<TelephonyStateRegistryPayload> CreateNetworkState(
+        int32_t slotId, const sptr<NetworkState> &networkState);
+
+    /**
+     * Totals of the payloads released so far, the saved time is the encoding time of each payload multiplied by
+     * the number of extra observers it was sent to.
+     */
+    static Stats GetStats();
+
+    TelephonyStateRegistryPayload(uint32_t code, uint32_t flags);
+    ~TelephonyStateRegistryPayload();
+
+    /**
+     * Send the payload to an observer.
+     *
+     * @param observer Observer to notify.
+     * @return bool false when the observer is not remote, the caller uses the observer interface instead.
+     */
+    bool SendTo(const sptr<TelephonyObserverBroker> &observer);
+
+    uint32_t GetCode() const;
+    const std::vector<uint8_t> &GetBody() const;
+
+private:
+    template<typename Writer>
+    bool Encode(Writer writer);
+    static std::unique_ptr<MessageParcel> AcquireParcel();
+    static void ReleaseParcel(std::unique_ptr<MessageParcel> parcel);
+
+private:
+    uint32_t code_ = 0;
+    uint32_t flags_ = 0;
+    std::vector<uint8_t> body_;
+    uint64_t encodeTimeNs_ = 0;
+    std::atomic<uint32_t> sendCount_ { 0 };
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_PAYLOAD_H
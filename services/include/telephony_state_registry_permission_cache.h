@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_PERMISSION_CACHE_H
+#define TELEPHONY_STATE_REGISTRY_PERMISSION_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "perm_state_change_callback_customize.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Permission decisions of the observers notified of call states.
+ *
+ * The decisions of a tracked token are verified once, then kept up to date by an access token permission state
+ * change callback, so that notifying a call state does not verify any permission. Tokens which are not tracked, or
+ * whose callback could not be registered, are verified on every query.
+ */
+class TelephonyStateRegistryPermissionCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t changes = 0;
+    };
+
+    TelephonyStateRegistryPermissionCache() = default;
+    ~TelephonyStateRegistryPermissionCache();
+
+    /**
+     * Track exactly the given tokens, the new ones are verified and the others released.
+     *
+     * @param tokenIds Tokens of the registered call state observers.
+     */
+    void SetTrackedTokens(const std::set<int32_t> &tokenIds);
+
+    /**
+     * Whether a token is granted a permission.
+     */
+    bool Verify(int32_t tokenId, const std::string &permission);
+
+    /**
+     * Refresh the decision of a tracked token after its permission state changed.
+     */
+    void OnPermissionChanged(int32_t tokenId, const std::string &permission);
+
+    Stats GetStats() const;
+
+private:
+    class PermissionChangeCallback : public Security::AccessToken::PermStateChangeCallbackCustomize {
+    public:
+        PermissionChangeCallback(
+            const Security::AccessToken::PermStateChangeScope &scope, TelephonyStateRegistryPermissionCache &cache)
+            : PermStateChangeCallbackCustomize(scope), cache_(cache)
+        {}
+        ~PermissionChangeCallback() override = default;
+        void PermStateChangeCallback(Security::AccessToken::PermStateChangeInfo &result) override
+        {
+            cache_.OnPermissionChanged(static_cast<int32_t>(result.tokenID), result.permissionName);
+        }
+
+    private:
+        TelephonyStateRegistryPermissionCache &cache_;
+    };
+
+    struct Entry {
+        std::shared_ptr<PermissionChangeCallback> callback;
+        std::map<std::string, bool> decisions;
+        // Bumped by each permission change, a verification started before a change is not kept.
+        uint64_t generation = 0;
+    };
+
+    void Track(int32_t tokenId);
+    static bool VerifyAccessToken(int32_t tokenId, const std::string &permission);
+
+private:
+    mutable std::mutex mutex_;
+    std::map<int32_t, Entry> entries_;
+    std::atomic<uint64_t> hits_ = 0;
+    std::atomic<uint64_t> misses_ = 0;
+    std::atomic<uint64_t> changes_ = 0;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_PERMISSION_CACHE_H
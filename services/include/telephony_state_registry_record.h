@@ -24,7 +24,7 @@ namespace OHOS {
 namespace Telephony {
 class TelephonyStateRegistryRecord {
 public:
-    bool IsCanReadCallHistory();
+    bool IsCanReadCallHistory() const;
     /**
      * IsExistStateListener
      *
@@ -43,6 +43,8 @@ public:
     unsigned int mask_ = 0;
     int slotId_ = 0;
     std::string appIdentifier_ = "";
+    // Whether the callbacks sent to the observer carry the sequence numbers, negotiated at registration.
+    bool readsSequence_ = false;
     sptr<TelephonyObserverBroker> telephonyObserver_ = nullptr;
 };
 } // namespace Telephony
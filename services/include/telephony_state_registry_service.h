@@ -16,18 +16,37 @@
 #ifndef TELEPHONY_STATE_REGISTRY_SERVICE_H
 #define TELEPHONY_STATE_REGISTRY_SERVICE_H
 
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
+#include <set>
 #include <shared_mutex>
 #include <mutex>
 #include <string>
+#include <tuple>
 
 #include "singleton.h"
 #include "system_ability.h"
 #include "common_event_manager.h"
 #include "want.h"
 
+#include "telephony_ext_wrapper.h"
+#include "telephony_state_registry_change_filter.h"
+#include "telephony_state_registry_dispatcher.h"
+#include "telephony_state_registry_event_publisher.h"
+#include "telephony_state_registry_event_ring.h"
+#include "telephony_state_registry_mailbox.h"
+#include "telephony_state_registry_metrics.h"
+#include "telephony_state_registry_payload.h"
+#include "telephony_state_registry_permission_cache.h"
 #include "telephony_state_registry_record.h"
+#include "telephony_state_registry_slot_table.h"
+#include "telephony_state_registry_state_page.h"
 #include "telephony_state_registry_stub.h"
+#include "telephony_state_registry_subscriber_index.h"
+#include "telephony_state_registry_throttle.h"
+#include "telephony_state_registry_timer_wheel.h"
 #include "sim_state_type.h"
 
 namespace OHOS {
@@ -63,6 +82,20 @@ public:
         const std::string &bundleName, bool notifyNow, pid_t pid, int32_t uid, int32_t tokenId,
         const std::string &appIdentifier) override;
     int32_t UnregisterStateChange(int32_t slotId, uint32_t mask, int32_t tokenId, pid_t pid) override;
+    int32_t SetDeliveryPolicy(int32_t slotId, uint32_t mask, int32_t tokenId, pid_t pid,
+        const TelephonyObserverDeliveryPolicy &policy) override;
+    int32_t ModifyObserverMask(int32_t slotId, uint32_t mask, uint32_t addMask, uint32_t removeMask,
+        bool notifyNow, int32_t tokenId, pid_t pid) override;
+    int32_t RegisterStateChanges(const std::vector<TelephonyObserverRegistration> &registrations,
+        const TelephonyStateRegistryRecord &caller, std::vector<int32_t> &results) override;
+    int32_t UnregisterStateChanges(const std::vector<TelephonyObserverRegistration> &registrations, int32_t tokenId,
+        pid_t pid, std::vector<int32_t> &results) override;
+    int32_t UnregisterAllStateChanges(int32_t tokenId, pid_t pid) override;
+    int32_t GetStateSnapshot(
+        int32_t slotId, int32_t tokenId, std::vector<TelephonyStateSnapshot> &snapshots) override;
+    int32_t GetStatePage(sptr<Ashmem> &ashmem) override;
+    int32_t GetEventRing(
+        int32_t slotId, uint32_t mask, const sptr<IRemoteObject> &client, sptr<Ashmem> &ashmem) override;
     int32_t GetServiceRunningState();
     int32_t GetSimState(int32_t slotId);
     int32_t GetCallState(int32_t slotId);
@@ -72,16 +105,216 @@ public:
     int32_t GetCellularDataConnectionNetworkType(int32_t slotId);
     int32_t GetLockReason(int32_t slotId);
 
+    struct ObserverPurgeStats {
+        uint64_t died = 0;
+        uint64_t evicted = 0;
+        uint64_t purgedRecords = 0;
+    };
+    ObserverPurgeStats GetObserverPurgeStats();
+
+    struct SuppressedUpdateStats {
+        uint64_t signalInfo = 0;
+        uint64_t networkState = 0;
+        uint64_t cellularDataConnectState = 0;
+        uint64_t cellularDataFlow = 0;
+        uint64_t parcel = 0;
+    };
+    SuppressedUpdateStats GetSuppressedUpdateStats();
+
+    struct BatchUpdateStats {
+        uint64_t batches = 0;
+        uint64_t updates = 0;
+    };
+    BatchUpdateStats GetBatchUpdateStats();
+    TelephonyStateRegistryPermissionCache::Stats GetPermissionCacheStats();
+    TelephonyStateRegistryEventPublisher::Stats GetEventPublisherStats();
+    TelephonyStateRegistryMetrics &GetMetrics();
+
+protected:
+    bool IsRepeatedUpdate(uint32_t event, int32_t slotId, uint64_t fingerprint, int32_t &result) override;
+    void OnUpdateHandled(uint32_t event, int32_t slotId, uint64_t fingerprint) override;
+    int32_t CheckBatchUpdateEntry(StateNotifyInterfaceCode code, int32_t slotId) override;
+    int32_t RunBatchUpdate(const std::function<void()> &updates) override;
+
+private:
+    class ObserverDeathRecipient : public IRemoteObject::DeathRecipient {
+    public:
+        explicit ObserverDeathRecipient(TelephonyStateRegistryService &service) : service_(service) {}
+        ~ObserverDeathRecipient() override = default;
+        void OnRemoteDied(const wptr<IRemoteObject> &remote) override
+        {
+            service_.OnObserverDied(remote);
+        }
+
+    private:
+        TelephonyStateRegistryService &service_;
+    };
+
+    class EventRingDeathRecipient : public IRemoteObject::DeathRecipient {
+    public:
+        explicit EventRingDeathRecipient(TelephonyStateRegistryService &service) : service_(service) {}
+        ~EventRingDeathRecipient() override = default;
+        void OnRemoteDied(const wptr<IRemoteObject> &remote) override
+        {
+            service_.OnEventRingClientDied(remote);
+        }
+
+    private:
+        TelephonyStateRegistryService &service_;
+    };
+
+    struct EventRingEntry {
+        std::shared_ptr<TelephonyStateRegistryEventRing> ring;
+        // Processes that requested the ring, it is dropped once the last one dies.
+        std::map<IRemoteObject *, sptr<IRemoteObject>> clients;
+    };
+
+    void OnObserverDied(const wptr<IRemoteObject> &remote);
+    /**
+     * Forget a dead client of the event rings and drop the rings no client is left for.
+     */
+    void OnEventRingClientDied(const wptr<IRemoteObject> &remote);
+    /**
+     * Remove every record of an observer and publish the remaining ones.
+     *
+     * @return size_t Number of removed records.
+     */
+    size_t RemoveObserverRecords(const sptr<IRemoteObject> &remote);
+    bool HasObserverRecord(const sptr<IRemoteObject> &remote);
+    /**
+     * @return bool Whether the remote of the observer died.
+     */
+    bool CheckObserverAlive(const TelephonyStateRegistryRecord &record, TelephonyStateRegistryMailbox &mailbox);
+    /**
+     * Whether an update is dropped because it repeats the state published for the slot.
+     *
+     * @param isSame Compares the update with the published state, only called when the event is suppressible.
+     * @return bool true when the update must not be published.
+     */
+    bool SuppressUnchangedUpdate(uint32_t event, int32_t slotId, const std::function<bool()> &isSame);
+    /**
+     * End the commit of an update which was not suppressed.
+     *
+     * @param version Version of the committed state.
+     */
+    void EndCommit(uint32_t event, int32_t slotId, uint64_t version);
+    /**
+     * Check a permission of the producer of an update, once per batch when the update belongs to one.
+     */
+    bool CheckUpdatePermission(const std::string &permission);
+    /**
+     * Queue the notification job of a committed update, held back until the end of the batch it belongs to.
+     */
+    void DispatchUpdate(int32_t slotId, TelephonyStateRegistryDispatcher::Job job);
+    /**
+     * @return The ring of a slot and event, nullptr when no client requested it.
+     */
+    std::shared_ptr<TelephonyStateRegistryEventRing> FindEventRing(int32_t slotId, uint32_t mask);
+
 private:
     void Finalize();
-    void UpdateData(const TelephonyStateRegistryRecord &record);
-    void UpdateDataEx(const TelephonyStateRegistryRecord &record);
+    /**
+     * Bits of the SlotStateField values the caller is permitted to observe.
+     */
+    uint32_t GetReadableFields();
+    /**
+     * Build the snapshots of slots firstSlot to lastSlot holding the readable fields.
+     */
+    void ReadSnapshots(int32_t slotId, int32_t firstSlot, int32_t lastSlot, uint32_t readableFields,
+        bool canReadCallLog, std::vector<TelephonyStateSnapshot> &snapshots);
+    /**
+     * Queue the callbacks of the current state of records registered with notifyNow, as one delivery in the mailbox
+     * of their observer.
+     *
+     * @param records Records of a same observer.
+     */
+    void PostInitialState(const std::vector<TelephonyStateRegistryRecord> &records, uint64_t sinceSequence = 0);
+    /**
+     * Create the mailbox of an observer, it resyncs the observer when it overflows.
+     */
+    std::shared_ptr<TelephonyStateRegistryMailbox> CreateMailbox();
+    void ResyncObserver(const TelephonyStateRegistryMailbox &mailbox);
+    /**
+     * Notify the current state of the events of a record.
+     *
+     * @param sinceSequence Only the state changed after this sequence number is notified, 0 notifies every event.
+     */
+    void UpdateData(const TelephonyStateRegistryRecord &record, uint64_t sinceSequence = 0);
+    void UpdateDataEx(const TelephonyStateRegistryRecord &record, uint64_t sinceSequence = 0);
+    /**
+     * Version of the state notified by an event, 0 when the event has no state.
+     */
+    uint64_t GetStateVersion(int32_t slotId, const SlotStateValues &values, uint32_t event);
+    void NotifyInitialState(const TelephonyStateRegistryRecord &record, const SlotStateValues &values, uint32_t event,
+        uint64_t sinceSequence, const std::function<void()> &notify);
+    std::shared_ptr<const TelephonyStateRegistrySubscribers> GetSubscribers();
+    void InvalidateSubscribers();
+    std::shared_ptr<const TelephonyStateRegistrySubscribers> PublishSubscribers();
+    void RefreshSubscribers();
+    /**
+     * Check the system API use and the permissions of a mask to register or unregister.
+     */
+    int32_t CheckRegistration(uint32_t mask);
+    /**
+     * Erase the matching records and publish the subscribers when any was erased, called with lock_ held exclusively.
+     *
+     * @return size_t Number of erased records.
+     */
+    size_t EraseRecords(const std::function<bool(const TelephonyStateRegistryRecord &record)> &matches);
+    int32_t MatchSubscribers(TelephonyStateRegistrySubscriberIndex::Cursor cursor,
+        const TelephonyStateRegistrySubscribers &subscribers, std::vector<uint32_t> &positions);
+    /**
+     * Block until the notifications queued so far have been delivered.
+     */
+    void FlushNotifications();
+    using Delivery = std::function<void(const TelephonyStateRegistryRecord &record)>;
+    using FanOutPtr = std::shared_ptr<TelephonyStateRegistryMetrics::FanOut>;
+    /**
+     * Queue a delivery in the mailbox of every matched subscriber.
+     *
+     * @param event Observer mask bit of the event, state-like events coalesce per slot.
+     * @param sequence Version of the notified state, sent along the callbacks.
+     * @param sample Signal of the event, records with a delivery policy are throttled on it when not nullptr.
+     * @param fanOut Fan-out the deliveries are accounted to, a new one is started when nullptr.
+     */
+    void Deliver(const std::shared_ptr<const TelephonyStateRegistrySubscribers> &subscribers,
+        const std::vector<uint32_t> &positions, uint32_t event, int32_t slotId, uint64_t sequence,
+        const Delivery &delivery, const TelephonyStateRegistryThrottle::Sample *sample = nullptr,
+        FanOutPtr fanOut = nullptr);
+    void PostDelivery(const std::shared_ptr<const TelephonyStateRegistrySubscribers> &subscribers, uint32_t position,
+        uint64_t key, bool coalesce, uint64_t sequence, const std::shared_ptr<const Delivery> &delivery,
+        const FanOutPtr &fanOut);
+    /**
+     * Run a batch ext hook once for the matched subscribers and group them by the value it picked for them.
+     *
+     * @param hook Batch hook, every subscriber gets the unchanged value when it is not loaded.
+     * @param visitor Called for each non empty group with its positions, its value, whether it is a variant and the
+     * fan-out of the event.
+     */
+    template<typename Value, typename BatchHook, typename Visitor>
+    void ForEachExtVariant(BatchHook hook, TelephonyExtWrapper::Hook hookId,
+        const TelephonyStateRegistrySubscribers &subscribers, const std::vector<uint32_t> &positions, uint32_t event,
+        int32_t slotId, const Value &value, Visitor visitor);
+    void ScheduleThrottleFlush(
+        const std::shared_ptr<TelephonyStateRegistryThrottle> &throttle, uint32_t event, uint32_t delayMs);
+    int32_t CommitCallState(int32_t slotId, int32_t callState, const std::u16string &number);
+    void NotifyCallState(
+        const TelephonyStateRegistryRecord &record, int32_t slotId, int32_t callState, const std::u16string &number);
+    void NotifyCellularDataConnectState(
+        const TelephonyStateRegistryRecord &record, int32_t slotId, int32_t dataState, int32_t networkType);
+    void NotifySignalInfo(const TelephonyStateRegistryRecord &record, int32_t slotId,
+        const std::vector<sptr<SignalInformation>> &vec, const std::shared_ptr<TelephonyStateRegistryPayload> &payload);
+    void NotifyCellInfo(const TelephonyStateRegistryRecord &record, int32_t slotId,
+        const std::vector<sptr<CellInformation>> &vec, const std::shared_ptr<TelephonyStateRegistryPayload> &payload);
+    void NotifyNetworkState(const TelephonyStateRegistryRecord &record, int32_t slotId,
+        const sptr<NetworkState> &networkState, const std::shared_ptr<TelephonyStateRegistryPayload> &payload);
 
 private:
+    static sptr<NetworkState> CloneNetworkState(const sptr<NetworkState> &networkState);
     bool CheckCallerIsSystemApp(uint32_t mask);
     bool CheckPermission(uint32_t mask);
     bool VerifySlotId(int32_t slotId);
-    std::u16string GetCallIncomingNumberForSlotId(TelephonyStateRegistryRecord record, int32_t slotId);
+    std::u16string GetCallIncomingNumberForSlotId(const TelephonyStateRegistryRecord &record, int32_t slotId);
     bool PublishCommonEvent(const AAFwk::Want &want, int32_t eventCode, const std::string &eventData);
     void SendCallStateChanged(int32_t slotId, int32_t state);
     void SendCallStateChangedAsUserMultiplePermission(int32_t slotId, int32_t state, const std::u16string &number);
@@ -98,21 +331,42 @@ private:
     int64_t bindStartTime_ = 0L;
     int64_t bindEndTime_ = 0L;
     int64_t bindSpendTime_ = 0L;
-    std::map<int32_t, bool> cfuResult_;
-    std::map<int32_t, bool> voiceMailMsgResult_;
-    std::map<int32_t, int32_t> callState_;
-    std::map<int32_t, std::u16string> callIncomingNumber_;
-    std::map<int32_t, std::vector<sptr<SignalInformation>>> signalInfos_;
-    std::map<int32_t, std::vector<sptr<CellInformation>>> cellInfos_;
-    std::map<int32_t, sptr<NetworkState>> searchNetworkState_;
+    std::unique_ptr<TelephonyStateRegistrySlotTable> slotStates_;
+    // Page of each set of readable fields, created on the first request for it, guarded by statePageMutex_.
+    std::map<uint32_t, std::shared_ptr<TelephonyStateRegistryStatePage>> statePages_;
+    std::mutex statePageMutex_;
+    // Event ring of each slot and event, created on the first request, guarded by eventRingMutex_.
+    std::map<std::pair<int32_t, uint32_t>, EventRingEntry> eventRings_;
+    std::mutex eventRingMutex_;
+    sptr<IRemoteObject::DeathRecipient> eventRingDeathRecipient_ = nullptr;
+    std::unique_ptr<TelephonyStateRegistryChangeFilter> changeFilter_;
+    std::unique_ptr<TelephonyStateRegistryPermissionCache> permissionCache_;
+    // Tokens of the call state observers last handed to permissionCache_, guarded by publishMutex_.
+    std::set<int32_t> trackedTokens_;
+    std::unique_ptr<TelephonyStateRegistryEventPublisher> eventPublisher_;
+    std::unique_ptr<TelephonyStateRegistryMetrics> metrics_;
     std::vector<TelephonyStateRegistryRecord> stateRecords_;
-    std::map<int32_t, SimState> simState_;
-    std::map<int32_t, CardType> cardType_;
-    std::map<int32_t, LockReason> simReason_;
-    std::map<int32_t, int32_t> cellularDataConnectionState_;
-    std::map<int32_t, int32_t> cellularDataConnectionNetworkType_;
-    std::map<int32_t, int32_t> cellularDataFlow_;
-    std::map<int32_t, bool> simActiveResult_;
+    std::shared_ptr<const TelephonyStateRegistrySubscribers> subscribers_ =
+        std::make_shared<const TelephonyStateRegistrySubscribers>();
+    // Bumped on every change of stateRecords_, subscribers_ is rebuilt when it is older.
+    std::atomic<uint64_t> recordsGeneration_ = 0;
+    // Serializes the rebuilds of subscribers_, taken before lock_.
+    std::mutex publishMutex_;
+    std::unique_ptr<TelephonyStateRegistryDispatcher> dispatcher_;
+    std::unique_ptr<TelephonyStateRegistryDeliveryPool> deliveryPool_;
+    // Mailbox of each registered observer, guarded by lock_ held exclusively, or shared with publishMutex_.
+    std::map<const TelephonyObserverBroker *, std::shared_ptr<TelephonyStateRegistryMailbox>> mailboxes_;
+    // Slot, mask, token id and pid of a record.
+    using RecordKey = std::tuple<int32_t, uint32_t, int32_t, pid_t>;
+    // Throttle of each record registered with a delivery policy, guarded like mailboxes_.
+    std::map<RecordKey, std::shared_ptr<TelephonyStateRegistryThrottle>> throttles_;
+    std::unique_ptr<TelephonyStateRegistryTimerWheel> timerWheel_;
+    sptr<IRemoteObject::DeathRecipient> deathRecipient_ = nullptr;
+    std::atomic<uint64_t> diedObserverCount_ = 0;
+    std::atomic<uint64_t> evictedObserverCount_ = 0;
+    std::atomic<uint64_t> purgedRecordCount_ = 0;
+    std::atomic<uint64_t> batchUpdateCount_ = 0;
+    std::atomic<uint64_t> batchedUpdateCount_ = 0;
 };
 } // namespace Telephony
 } // namespace OHOS
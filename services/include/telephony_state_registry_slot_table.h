@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_SLOT_TABLE_H
+#define TELEPHONY_STATE_REGISTRY_SLOT_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "telephony_observer_broker.h"
+
+namespace OHOS {
+namespace Telephony {
+class TelephonyStateRegistryStatePage;
+
+/**
+ * Scalar fields of the per-slot state.
+ */
+enum class SlotStateField : uint32_t {
+    CALL_STATE = 0,
+    SIM_STATE,
+    CARD_TYPE,
+    LOCK_REASON,
+    DATA_CONNECTION_STATE,
+    DATA_CONNECTION_NETWORK_TYPE,
+    DATA_FLOW,
+    CFU_INDICATOR,
+    VOICE_MAIL_MSG_INDICATOR,
+    SIM_ACTIVE_STATE,
+    FIELD_COUNT,
+};
+
+/**
+ * Object fields of the per-slot state.
+ */
+enum class SlotStateObject : uint32_t {
+    CALL_INCOMING_NUMBER = 0,
+    SIGNAL_INFO,
+    CELL_INFO,
+    NETWORK_STATE,
+    OBJECT_COUNT,
+};
+
+/**
+ * Consistent copy of the scalar fields of one slot.
+ */
+struct SlotStateValues {
+    uint32_t validFields = 0;
+    int32_t values[static_cast<uint32_t>(SlotStateField::FIELD_COUNT)] = { 0 };
+    /**
+     * Version of each field, see TelephonyStateRegistrySlotTable::GetVersion.
+     */
+    uint64_t versions[static_cast<uint32_t>(SlotStateField::FIELD_COUNT)] = { 0 };
+
+    bool IsValid(SlotStateField field) const
+    {
+        return (validFields & (1u << static_cast<uint32_t>(field))) != 0;
+    }
+
+    int32_t Get(SlotStateField field) const
+    {
+        return values[static_cast<uint32_t>(field)];
+    }
+
+    uint64_t GetVersion(SlotStateField field) const
+    {
+        return versions[static_cast<uint32_t>(field)];
+    }
+};
+
+/**
+ * Fixed-size table of the last state published for each slot.
+ *
+ * Slot -1 (call state of all slots) takes the first entry. Scalar fields are published under a per-slot sequence
+ * lock so that readers never block and always see the fields written together; the number, signal, cell and
+ * network values are immutable objects swapped atomically. Writers are serialized by the table.
+ */
+class TelephonyStateRegistrySlotTable {
+public:
+    /**
+     * Scope in which the writes of the calling thread are committed together. The other writers wait for its end,
+     * the readers of the table and of the page see all of its scalar writes or none of them.
+     */
+    class WriteSection {
+    public:
+        explicit WriteSection(TelephonyStateRegistrySlotTable &table);
+        ~WriteSection();
+        WriteSection(const WriteSection &) = delete;
+        WriteSection &operator=(const WriteSection &) = delete;
+
+    private:
+        TelephonyStateRegistrySlotTable &table_;
+    };
+
+    explicit TelephonyStateRegistrySlotTable(int32_t slotSize);
+    ~TelephonyStateRegistrySlotTable() = default;
+
+    bool IsValidSlot(int32_t slotId) const;
+
+    /**
+     * Number of slot entries, the slot -1 included.
+     */
+    int32_t GetSlotCount() const;
+
+    /**
+     * Publish some scalar fields of a slot at once.
+     *
+     * @param slotId Slot id, -1 means all slots.
+     * @param fields Fields and their new value.
+     * @return uint64_t Version of the written fields, 0 when the slot is out of the table.
+     */
+    uint64_t Write(int32_t slotId, std::initializer_list<std::pair<SlotStateField, int32_t>> fields);
+
+    /**
+     * Forget a scalar field of a slot, following reads report it as never published.
+     */
+    void Invalidate(int32_t slotId, SlotStateField field);
+
+    /**
+     * Read one scalar field of a slot.
+     *
+     * @param value Set to the field value when it has been published.
+     * @return bool true when the field has been published.
+     */
+    bool Read(int32_t slotId, SlotStateField field, int32_t &value) const;
+
+    /**
+     * Read all the scalar fields of a slot at once.
+     *
+     * @return bool false when the slot is out of the table.
+     */
+    bool Read(int32_t slotId, SlotStateValues &values) const;
+
+    /**
+     * Run some reads of the table until none of them overlaps a write section, they see the scalar writes of a
+     * section all together.
+     */
+    void ReadCommitted(const std::function<void()> &read) const;
+
+    /**
+     * The setters of the object fields return the version of the new value, 0 when the slot is out of the table.
+     */
+    uint64_t SetCallIncomingNumber(int32_t slotId, const std::u16string &number);
+    std::u16string GetCallIncomingNumber(int32_t slotId) const;
+    uint64_t SetSignalInfos(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec);
+    std::vector<sptr<SignalInformation>> GetSignalInfos(int32_t slotId) const;
+    uint64_t SetCellInfos(int32_t slotId, const std::vector<sptr<CellInformation>> &vec);
+    std::vector<sptr<CellInformation>> GetCellInfos(int32_t slotId) const;
+    uint64_t SetNetworkState(int32_t slotId, const sptr<NetworkState> &networkState);
+    sptr<NetworkState> GetNetworkState(int32_t slotId) const;
+
+    /**
+     * Whether the values are the ones published for the slot, false when nothing has been published yet.
+     */
+    bool IsSameSignalInfos(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec) const;
+    bool IsSameNetworkState(int32_t slotId, const sptr<NetworkState> &networkState) const;
+
+    /**
+     * Version of the last change of the table. Every write or invalidation of a field stamps the field with a new
+     * version, so versions increase monotonically across all the fields of all the slots and 0 means never written.
+     */
+    uint64_t GetVersion() const;
+    uint64_t GetVersion(int32_t slotId, SlotStateObject object) const;
+
+    /**
+     * Mirror the scalar fields of every slot into a shared memory page, from their current value on. Several pages
+     * can be attached, each one keeps the fields it was created for.
+     */
+    void AttachPage(const std::shared_ptr<TelephonyStateRegistryStatePage> &page);
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr uint32_t FIELD_COUNT = static_cast<uint32_t>(SlotStateField::FIELD_COUNT);
+    static constexpr uint32_t OBJECT_COUNT = static_cast<uint32_t>(SlotStateObject::OBJECT_COUNT);
+
+    struct alignas(CACHE_LINE_SIZE) SlotState {
+        std::atomic<uint32_t> sequence { 0 };
+        std::atomic<uint32_t> validFields { 0 };
+        std::atomic<int32_t> values[FIELD_COUNT] = {};
+        std::atomic<uint64_t> versions[FIELD_COUNT] = {};
+        std::atomic<uint64_t> objectVersions[OBJECT_COUNT] = {};
+        std::shared_ptr<const std::u16string> callIncomingNumber;
+        std::shared_ptr<const std::vector<sptr<SignalInformation>>> signalInfos;
+        std::shared_ptr<const std::vector<sptr<CellInformation>>> cellInfos;
+        std::shared_ptr<const sptr<NetworkState>> networkState;
+    };
+
+    SlotState *GetSlot(int32_t slotId);
+    const SlotState *GetSlot(int32_t slotId) const;
+    uint64_t StampObject(SlotState &slot, SlotStateObject object);
+    void PublishToPages(int32_t slotId, const SlotState &slot);
+    static SlotStateValues LoadValues(const SlotState &slot);
+    std::unique_lock<std::mutex> LockWrite();
+    uint32_t BeginRead() const;
+    bool EndRead(uint32_t begin) const;
+
+private:
+    int32_t slotCount_ = 0;
+    std::unique_ptr<SlotState[]> slots_;
+    std::mutex writeMutex_;
+    // Odd while a write section is open.
+    std::atomic<uint32_t> commitSequence_ { 0 };
+    std::atomic<uint64_t> version_ { 0 };
+    // Guarded by writeMutex_.
+    std::vector<std::shared_ptr<TelephonyStateRegistryStatePage>> pages_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_SLOT_TABLE_H
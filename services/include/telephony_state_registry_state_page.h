@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_STATE_PAGE_H
+#define TELEPHONY_STATE_REGISTRY_STATE_PAGE_H
+
+#include <cstdint>
+#include <memory>
+
+#include "ashmem.h"
+#include "telephony_state_page.h"
+#include "telephony_state_registry_slot_table.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Writable side of the shared memory state page, see TelephonyStatePage.
+ *
+ * The region is mapped once for writing by the service, then its protection is reduced so that the processes it is
+ * shared with can only map it read-only. A page only holds the fields it was created for, the others are never
+ * valid in it. Publish calls must be serialized by the caller.
+ */
+class TelephonyStateRegistryStatePage {
+public:
+    /**
+     * Create the page.
+     *
+     * @param slotCount Number of slot entries, the slot -1 included.
+     * @param fieldMask Bits of the SlotStateField values the page holds.
+     * @return Page, nullptr when the shared memory can not be created.
+     */
+    static std::shared_ptr<TelephonyStateRegistryStatePage> Create(int32_t slotCount, uint32_t fieldMask);
+
+    TelephonyStateRegistryStatePage(const sptr<Ashmem> &ashmem, void *address, int32_t slotCount, uint32_t fieldMask);
+    ~TelephonyStateRegistryStatePage();
+
+    /**
+     * Copy the scalar state of a slot into its entry.
+     *
+     * @param slotId Slot id, -1 means all slots.
+     * @param values State of the slot.
+     */
+    void Publish(int32_t slotId, const SlotStateValues &values);
+
+    /**
+     * Open and close a commit, readers see the entries published in between all together.
+     */
+    void BeginCommit();
+    void EndCommit();
+
+    sptr<Ashmem> GetAshmem() const;
+    uint32_t GetFieldMask() const;
+
+private:
+    sptr<Ashmem> ashmem_;
+    void *address_ = nullptr;
+    int32_t slotCount_ = 0;
+    uint32_t fieldMask_ = 0;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_STATE_PAGE_H
@@ -16,13 +16,21 @@
 #ifndef TELEPHONY_STATE_REGISTRY_STUB_H
 #define TELEPHONY_STATE_REGISTRY_STUB_H
 
+#include <functional>
 #include <map>
+#include <vector>
 
+#include "ashmem.h"
 #include "iremote_stub.h"
 
 #include "telephony_log_wrapper.h"
 #include "i_telephony_state_notify.h"
 #include "state_registry_ipc_interface_code.h"
+#include "state_registry_ipc_interface_code_ex.h"
+#include "telephony_observer_delivery_policy.h"
+#include "telephony_observer_registration.h"
+#include "telephony_state_registry_record.h"
+#include "telephony_state_snapshot.h"
 
 namespace OHOS {
 namespace Telephony {
@@ -40,6 +48,102 @@ public:
 
     virtual int32_t UnregisterStateChange(int32_t slotId, uint32_t mask, int32_t tokenId, pid_t pid) = 0;
 
+    virtual int32_t SetDeliveryPolicy(int32_t slotId, uint32_t mask, int32_t tokenId, pid_t pid,
+        const TelephonyObserverDeliveryPolicy &policy) = 0;
+
+    /**
+     * Add and remove mask bits of a registered record in place.
+     *
+     * @param mask Mask the record is registered with.
+     * @param addMask Bits to add, checked like the mask of a registration.
+     * @param removeMask Bits to remove, the record is removed when no bit is left.
+     * @param notifyNow Whether the current state of the added bits is notified.
+     * @return TELEPHONY_STATE_REGISTRY_DATA_EXIST when another observer of the caller has the resulting mask.
+     */
+    virtual int32_t ModifyObserverMask(int32_t slotId, uint32_t mask, uint32_t addMask, uint32_t removeMask,
+        bool notifyNow, int32_t tokenId, pid_t pid) = 0;
+
+    /**
+     * Register the pairs of a bulk request under one lock acquisition.
+     *
+     * @param caller Identity of the caller, every field but the slot, the mask and the observer is used.
+     * @param results Set to the result of each pair, in the order of the request.
+     */
+    virtual int32_t RegisterStateChanges(const std::vector<TelephonyObserverRegistration> &registrations,
+        const TelephonyStateRegistryRecord &caller, std::vector<int32_t> &results) = 0;
+
+    /**
+     * Unregister the pairs of a bulk request under one lock acquisition.
+     *
+     * @param results Set to the result of each pair, in the order of the request.
+     */
+    virtual int32_t UnregisterStateChanges(const std::vector<TelephonyObserverRegistration> &registrations,
+        int32_t tokenId, pid_t pid, std::vector<int32_t> &results) = 0;
+
+    /**
+     * Unregister every record of a caller.
+     */
+    virtual int32_t UnregisterAllStateChanges(int32_t tokenId, pid_t pid) = 0;
+
+    /**
+     * Read the cached state of a slot, or of every slot with TelephonyStateSnapshot::ALL_SLOTS.
+     *
+     * @param snapshots Set to one snapshot per slot holding the fields the caller is permitted to see.
+     */
+    virtual int32_t GetStateSnapshot(
+        int32_t slotId, int32_t tokenId, std::vector<TelephonyStateSnapshot> &snapshots) = 0;
+
+    /**
+     * Get the shared memory page the scalar state of every slot is published into, see TelephonyStatePage.
+     *
+     * @param ashmem Set to the page, the caller can only map it read-only.
+     */
+    virtual int32_t GetStatePage(sptr<Ashmem> &ashmem) = 0;
+
+    /**
+     * Get the shared memory ring the signal or cell events of a slot are written into, see TelephonyEventRing.
+     *
+     * @param mask OBSERVER_MASK_SIGNAL_STRENGTHS or OBSERVER_MASK_CELL_INFO.
+     * @param client Object of the calling process, the ring is dropped once every requesting process died.
+     * @param ashmem Set to the ring, the caller can only map it read-only.
+     */
+    virtual int32_t GetEventRing(
+        int32_t slotId, uint32_t mask, const sptr<IRemoteObject> &client, sptr<Ashmem> &ashmem) = 0;
+
+protected:
+    /**
+     * Whether an update parcel repeats the last one published, checked before the parcel is decoded.
+     *
+     * @param event Observer mask bit of the update.
+     * @param slotId Slot of the update.
+     * @param fingerprint Fingerprint of the parcel arguments.
+     * @param result Set to the result replied for a dropped update, the one of the unchanged update it repeats.
+     * @return bool true when the update has to be dropped.
+     */
+    virtual bool IsRepeatedUpdate(uint32_t event, int32_t slotId, uint64_t fingerprint, int32_t &result);
+
+    /**
+     * Called once the update of a parcel has been handled.
+     */
+    virtual void OnUpdateHandled(uint32_t event, int32_t slotId, uint64_t fingerprint);
+
+    /**
+     * Check an entry of a batch request before any entry of the batch runs.
+     *
+     * @param code Update request code of the entry.
+     * @param slotId Slot of the entry.
+     * @return int32_t TELEPHONY_SUCCESS when the entry can run, otherwise the batch is rejected as a whole.
+     */
+    virtual int32_t CheckBatchUpdateEntry(StateNotifyInterfaceCode code, int32_t slotId);
+
+    /**
+     * Run the updates of a batch request.
+     *
+     * @param updates Handles the entries of the batch, each one through its single update request handler.
+     * @return int32_t TELEPHONY_SUCCESS when the updates ran, an error when the batch is rejected as a whole.
+     */
+    virtual int32_t RunBatchUpdate(const std::function<void()> &updates);
+
 private:
     int32_t ReadData(MessageParcel &data, MessageParcel &reply, sptr<TelephonyObserverBroker> &callback);
     int32_t RegisterStateChange(const sptr<TelephonyObserverBroker> &telephonyObserver,
@@ -49,6 +153,21 @@ private:
         MessageParcel &data, const int32_t size, std::vector<sptr<SignalInformation>> &result);
     void ParseLteNrSignalInfos(
         MessageParcel &data, std::vector<sptr<SignalInformation>> &result, SignalInformation::NetworkType type);
+    static uint64_t GetUpdateFingerprint(MessageParcel &data);
+    struct BatchUpdateEntry {
+        StateNotifyInterfaceCode code = StateNotifyInterfaceCode::SIGNAL_INFO;
+        // Arguments of the single update request, pointing into the batch parcel.
+        const uint8_t *arguments = nullptr;
+        size_t size = 0;
+    };
+
+    /**
+     * Read and check an entry of a batch request.
+     *
+     * @return bool false when the entry can not be read, the following ones can not either.
+     */
+    bool ReadBatchUpdateEntry(MessageParcel &data, BatchUpdateEntry &entry, int32_t &result);
+    int32_t RunBatchUpdateEntry(const BatchUpdateEntry &entry);
 
 private:
     using TelephonyStateFunc = std::function<int32_t(MessageParcel &data, MessageParcel &reply)>;
@@ -61,6 +180,18 @@ private:
     int32_t OnUpdateSimState(MessageParcel &data, MessageParcel &reply);
     int32_t OnRegisterStateChange(MessageParcel &data, MessageParcel &reply);
     int32_t OnUnregisterStateChange(MessageParcel &data, MessageParcel &reply);
+    int32_t OnRegisterStateChangeWithPolicy(MessageParcel &data, MessageParcel &reply);
+    int32_t OnModifyObserverMask(MessageParcel &data, MessageParcel &reply);
+    int32_t OnRegisterStateChanges(MessageParcel &data, MessageParcel &reply);
+    int32_t OnUnregisterStateChanges(MessageParcel &data, MessageParcel &reply);
+    int32_t OnUnregisterAllStateChanges(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetStateSnapshot(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetStatePage(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetEventRing(MessageParcel &data, MessageParcel &reply);
+    bool ReadRegistrations(
+        MessageParcel &data, bool withObserver, std::vector<TelephonyObserverRegistration> &registrations);
+    TelephonyStateRegistryRecord GetCaller();
+    int32_t OnBatchUpdate(MessageParcel &data, MessageParcel &reply);
     int32_t OnUpdateCellularDataConnectState(MessageParcel &data, MessageParcel &reply);
     int32_t OnUpdateCellularDataFlow(MessageParcel &data, MessageParcel &reply);
     int32_t OnUpdateCfuIndicator(MessageParcel &data, MessageParcel &reply);
@@ -72,6 +203,7 @@ private:
 
 private:
     std::map<StateNotifyInterfaceCode, TelephonyStateFunc> memberFuncMap_;
+    std::map<StateNotifyInterfaceCodeEx, TelephonyStateFunc> memberFuncMapEx_;
     std::map<uint32_t, std::string> collieCodeStringMap_ = {
         { uint32_t(StateNotifyInterfaceCode::ADD_OBSERVER), "ADD_OBSERVER" },
     };
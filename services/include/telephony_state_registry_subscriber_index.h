@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_SUBSCRIBER_INDEX_H
+#define TELEPHONY_STATE_REGISTRY_SUBSCRIBER_INDEX_H
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "telephony_state_registry_mailbox.h"
+#include "telephony_state_registry_record.h"
+#include "telephony_state_registry_throttle.h"
+#include "telephony_types.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Subscriber lookup table keyed by (observer mask bit, slotId).
+ *
+ * Each bucket holds the positions of the matching records in the record list the index was built from, in
+ * ascending order, so that a lookup yields subscribers in registration order.
+ */
+class TelephonyStateRegistrySubscriberIndex {
+public:
+    /**
+     * Slot id passed to Find to match the subscribers of every slot.
+     */
+    static constexpr int32_t ANY_SLOT_ID = INT32_MIN;
+    /**
+     * Slot id used by observers that listen to the default data connection of all slots.
+     */
+    static constexpr int32_t DEFAULT_CONN_SLOT_ID = 999;
+
+    /**
+     * Rebuild the whole index from the record list.
+     *
+     * @param records Registered records, the position in this list is what the index stores.
+     */
+    void Rebuild(const std::vector<TelephonyStateRegistryRecord> &records);
+
+    /**
+     * Append one record which has been pushed at the end of the record list.
+     *
+     * @param record Registered record.
+     * @param position Position of the record in the record list.
+     */
+    void Add(const TelephonyStateRegistryRecord &record, uint32_t position);
+
+    void Clear();
+
+    /**
+     * Iterates, in registration order and at most once each, over the records listening to any bit of a mask on
+     * any of a few slots.
+     */
+    class Cursor {
+    public:
+        /**
+         * Move to the next matching record.
+         *
+         * @param position Position of the record in the record list.
+         * @return bool false when there is no more matching record.
+         */
+        bool Next(uint32_t &position);
+
+    private:
+        friend class TelephonyStateRegistrySubscriberIndex;
+        static constexpr size_t MAX_MERGE_LISTS = 8;
+        const std::vector<uint32_t> *lists_[MAX_MERGE_LISTS] = { nullptr };
+        size_t offsets_[MAX_MERGE_LISTS] = { 0 };
+        size_t listCount_ = 0;
+        bool hasLast_ = false;
+        uint32_t last_ = 0;
+    };
+
+    /**
+     * Look up the records listening to any bit of mask on any of the given slots.
+     *
+     * @param mask Listening type bitmask.
+     * @param slotIds Slots to look up, ANY_SLOT_ID matches every slot.
+     * @return Cursor over the positions of the matching records.
+     */
+    Cursor Find(uint32_t mask, std::initializer_list<int32_t> slotIds) const;
+
+private:
+    static constexpr uint32_t MASK_BIT_COUNT = 32;
+    // Buckets of slot -1 to MAX_SLOT_COUNT, then the default connection slot, then all slots.
+    static constexpr int32_t SLOT_BUCKET_COUNT = MAX_SLOT_COUNT + 2;
+    static constexpr int32_t DEFAULT_CONN_BUCKET = SLOT_BUCKET_COUNT;
+    static constexpr int32_t ANY_SLOT_BUCKET = SLOT_BUCKET_COUNT + 1;
+    static constexpr int32_t BUCKET_COUNT = SLOT_BUCKET_COUNT + 2;
+    static int32_t GetBucket(int32_t slotId);
+
+private:
+    std::array<std::array<std::vector<uint32_t>, BUCKET_COUNT>, MASK_BIT_COUNT> buckets_;
+};
+
+/**
+ * Immutable snapshot of the registered records and their index.
+ *
+ * Writers publish a new snapshot on every registration change, notify paths load the current one and iterate it
+ * without any lock.
+ */
+struct TelephonyStateRegistrySubscribers {
+    std::vector<TelephonyStateRegistryRecord> records;
+    TelephonyStateRegistrySubscriberIndex index;
+    // Mailbox of the observer of each record, records of the same observer share it.
+    std::vector<std::shared_ptr<TelephonyStateRegistryMailbox>> mailboxes;
+    // Delivery policy state of each record, nullptr when the record has no policy.
+    std::vector<std::shared_ptr<TelephonyStateRegistryThrottle>> throttles;
+    // Generation of the records the snapshot was built from.
+    uint64_t generation = 0;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_SUBSCRIBER_INDEX_H
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_THROTTLE_H
+#define TELEPHONY_STATE_REGISTRY_THROTTLE_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "refbase.h"
+#include "telephony_observer_delivery_policy.h"
+
+namespace OHOS {
+namespace Telephony {
+class SignalInformation;
+class CellInformation;
+
+/**
+ * Applies the delivery policy of a record to its signal and cell information notifications.
+ *
+ * A notification is dropped when its signal does not differ enough from the last one delivered, and held back when
+ * it comes within the minimum interval. Only the latest held back notification is kept, the caller arms a timer to
+ * flush it when the interval expires.
+ */
+class TelephonyStateRegistryThrottle {
+public:
+    using Job = std::function<void()>;
+
+    enum class Decision {
+        DELIVER,
+        DROP,
+        DEFER,
+    };
+
+    /**
+     * Signal of a notification the policy is evaluated on.
+     */
+    struct Sample {
+        int32_t level = 0;
+        int32_t dbm = 0;
+    };
+
+    struct Stats {
+        uint64_t dropped = 0;
+        uint64_t deferred = 0;
+        uint64_t flushed = 0;
+    };
+
+    explicit TelephonyStateRegistryThrottle(const TelephonyObserverDeliveryPolicy &policy);
+    ~TelephonyStateRegistryThrottle() = default;
+
+    static bool IsThrottledEvent(uint32_t event);
+    static Sample MakeSample(const std::vector<sptr<SignalInformation>> &vec);
+    static Sample MakeSample(const std::vector<sptr<CellInformation>> &vec);
+
+    const TelephonyObserverDeliveryPolicy &GetPolicy() const;
+
+    /**
+     * Evaluate a notification.
+     *
+     * @param event Observer mask bit of the notification.
+     * @param sample Signal of the notification.
+     * @param job Delivery, kept when the notification is deferred.
+     * @param flushDelayMs Set to the delay of the timer to arm when a deferred notification needs one, 0 otherwise.
+     * @return Decision What the caller does with the notification.
+     */
+    Decision Offer(uint32_t event, const Sample &sample, Job job, uint32_t &flushDelayMs);
+
+    /**
+     * Deliver the deferred notification of an event, called when its timer expires.
+     *
+     * @return uint32_t Delay of the timer to arm again when the interval is not over yet, 0 otherwise.
+     */
+    uint32_t Flush(uint32_t event);
+
+    /**
+     * Drop the deferred notifications, called when the record is removed.
+     */
+    void Close();
+
+    Stats GetStats();
+
+private:
+    struct EventState {
+        bool delivered = false;
+        Sample last;
+        int64_t lastTimeMs = 0;
+        bool timerArmed = false;
+        Job pending;
+        Sample pendingSample;
+    };
+
+    EventState *GetState(uint32_t event);
+    bool IsSignificant(const EventState &state, const Sample &sample) const;
+    static int64_t GetNowMs();
+
+private:
+    TelephonyObserverDeliveryPolicy policy_;
+    std::mutex mutex_;
+    EventState signalState_;
+    EventState cellState_;
+    bool closed_ = false;
+    Stats stats_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_THROTTLE_H
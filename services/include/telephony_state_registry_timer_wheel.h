@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_STATE_REGISTRY_TIMER_WHEEL_H
+#define TELEPHONY_STATE_REGISTRY_TIMER_WHEEL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Hashed timer wheel running one-shot tasks on its own thread.
+ *
+ * Scheduling is O(1) whatever the number of pending tasks, a task runs within one tick after its delay. The thread
+ * starts with the first task and sleeps while the wheel is empty.
+ */
+class TelephonyStateRegistryTimerWheel {
+public:
+    using Task = std::function<void()>;
+
+    TelephonyStateRegistryTimerWheel(uint32_t tickMs, uint32_t slotCount);
+    ~TelephonyStateRegistryTimerWheel();
+
+    /**
+     * Run a task once the delay has elapsed.
+     *
+     * @param delayMs Delay in milliseconds.
+     * @param task Task to run on the wheel thread.
+     * @return bool false when the wheel is stopped, the task is dropped.
+     */
+    bool Schedule(uint32_t delayMs, Task task);
+
+    /**
+     * Stop the thread, pending tasks are dropped.
+     */
+    void Stop();
+
+    size_t GetPendingCount();
+
+private:
+    struct Entry {
+        uint32_t rounds = 0;
+        Task task;
+    };
+
+    void Run();
+
+private:
+    uint32_t tickMs_ = 1;
+    std::vector<std::vector<Entry>> slots_;
+    size_t cursor_ = 0;
+    size_t pendingCount_ = 0;
+    bool stopping_ = false;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::thread thread_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // TELEPHONY_STATE_REGISTRY_TIMER_WHEEL_H
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_change_filter.h"
+
+#include <algorithm>
+
+#include "parameters.h"
+#include "telephony_log_wrapper.h"
+#include "telephony_observer_broker.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+const std::string SUPPRESS_MASK_KEY = "persist.telephony.state_registry.suppress_mask";
+constexpr uint32_t DEFAULT_SUPPRESS_MASK = TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS |
+    TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE |
+    TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE | TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+// 0 marks an empty fingerprint entry.
+constexpr uint64_t NO_FINGERPRINT = 0;
+} // namespace
+
+TelephonyStateRegistryChangeFilter::TelephonyStateRegistryChangeFilter(int32_t slotSize)
+{
+    enabledEvents_ = static_cast<uint32_t>(
+        OHOS::system::GetIntParameter(SUPPRESS_MASK_KEY, static_cast<int32_t>(DEFAULT_SUPPRESS_MASK)));
+    slotCount_ = slotSize > 0 ? slotSize : 1;
+    entries_ = std::make_unique<Entry[]>(static_cast<size_t>(EVENT_COUNT * slotCount_));
+    TELEPHONY_LOGI("ChangeFilter suppress mask %{public}u", enabledEvents_);
+}
+
+bool TelephonyStateRegistryChangeFilter::IsEnabled(uint32_t event) const
+{
+    return (enabledEvents_ & event) != 0 && GetEventIndex(event) >= 0;
+}
+
+uint64_t TelephonyStateRegistryChangeFilter::Fingerprint(const uint8_t *data, size_t size)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; data != nullptr && i < size; i++) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash == NO_FINGERPRINT ? FNV_OFFSET_BASIS : hash;
+}
+
+bool TelephonyStateRegistryChangeFilter::IsSameFingerprint(
+    uint32_t event, int32_t slotId, uint64_t fingerprint) const
+{
+    Entry *entry = GetEntry(event, slotId);
+    if (entry == nullptr || !IsEnabled(event)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entry->runningCommits == 0 && entry->fingerprint == fingerprint;
+}
+
+bool TelephonyStateRegistryChangeFilter::SetFingerprint(
+    uint32_t event, int32_t slotId, uint64_t version, uint64_t fingerprint)
+{
+    Entry *entry = GetEntry(event, slotId);
+    if (entry == nullptr || version == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    // An update racing with another one must not bind its fingerprint to the state the other one committed.
+    if (entry->runningCommits != 0 || entry->version != version) {
+        return false;
+    }
+    entry->fingerprint = fingerprint;
+    return true;
+}
+
+void TelephonyStateRegistryChangeFilter::BeginCommit(uint32_t event, int32_t slotId)
+{
+    Entry *entry = GetEntry(event, slotId);
+    if (entry == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry->runningCommits++;
+    entry->fingerprint = NO_FINGERPRINT;
+}
+
+void TelephonyStateRegistryChangeFilter::EndCommit(uint32_t event, int32_t slotId, uint64_t version)
+{
+    Entry *entry = GetEntry(event, slotId);
+    if (entry == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entry->runningCommits > 0) {
+        entry->runningCommits--;
+    }
+    // Commits may end out of order, the state is the one of the highest version.
+    entry->version = std::max(entry->version, version);
+    entry->fingerprint = NO_FINGERPRINT;
+}
+
+void TelephonyStateRegistryChangeFilter::CountSuppressed(uint32_t event, bool fromParcel)
+{
+    int32_t index = GetEventIndex(event);
+    if (index < 0) {
+        return;
+    }
+    suppressed_[index]++;
+    if (fromParcel) {
+        parcelSuppressed_++;
+    }
+}
+
+uint64_t TelephonyStateRegistryChangeFilter::GetSuppressedCount(uint32_t event) const
+{
+    int32_t index = GetEventIndex(event);
+    return index < 0 ? 0 : suppressed_[index].load();
+}
+
+uint64_t TelephonyStateRegistryChangeFilter::GetParcelSuppressedCount() const
+{
+    return parcelSuppressed_.load();
+}
+
+int32_t TelephonyStateRegistryChangeFilter::GetEventIndex(uint32_t event)
+{
+    switch (event) {
+        case TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS:
+            return 0;
+        case TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE:
+            return 1;
+        case TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE:
+            return 2;
+        case TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW:
+            return 3;
+        default:
+            return -1;
+    }
+}
+
+TelephonyStateRegistryChangeFilter::Entry *TelephonyStateRegistryChangeFilter::GetEntry(
+    uint32_t event, int32_t slotId) const
+{
+    int32_t index = GetEventIndex(event);
+    if (index < 0 || slotId < 0 || slotId >= slotCount_) {
+        return nullptr;
+    }
+    return &entries_[index * slotCount_ + slotId];
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_dispatcher.h"
+
+#include <pthread.h>
+#include <string>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr size_t PENDING_JOB_WARNING_THRESHOLD = 256;
+} // namespace
+
+TelephonyStateRegistryDispatcher::TelephonyStateRegistryDispatcher(uint32_t workerCount)
+{
+    if (workerCount == 0) {
+        workerCount = 1;
+    }
+    for (uint32_t i = 0; i < workerCount; i++) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+}
+
+TelephonyStateRegistryDispatcher::~TelephonyStateRegistryDispatcher()
+{
+    Stop();
+}
+
+bool TelephonyStateRegistryDispatcher::Dispatch(int32_t slotId, Job job)
+{
+    if (job == nullptr) {
+        return false;
+    }
+    // -1 takes the first worker, slots the following ones.
+    uint32_t index = slotId < -1 ? 0 : static_cast<uint32_t>(slotId + 1) % workers_.size();
+    Worker &worker = *workers_[index];
+    {
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        if (!worker.stopping && (worker.running || StartWorker(worker, index))) {
+            worker.jobs.push_back(std::move(job));
+            if (worker.jobs.size() == PENDING_JOB_WARNING_THRESHOLD) {
+                TELEPHONY_LOGW("Dispatch worker %{public}u has %{public}zu pending jobs", index, worker.jobs.size());
+            }
+            worker.condition.notify_one();
+            return true;
+        }
+    }
+    TELEPHONY_LOGW("Dispatch worker %{public}u unavailable, run slot %{public}d job inline", index, slotId);
+    job();
+    return false;
+}
+
+void TelephonyStateRegistryDispatcher::Flush()
+{
+    for (auto &worker : workers_) {
+        std::unique_lock<std::mutex> lock(worker->mutex);
+        worker->idleCondition.wait(lock, [&worker] { return worker->jobs.empty() && !worker->busy; });
+    }
+}
+
+void TelephonyStateRegistryDispatcher::Stop()
+{
+    for (auto &worker : workers_) {
+        {
+            std::unique_lock<std::mutex> lock(worker->mutex);
+            worker->stopping = true;
+            worker->condition.notify_one();
+        }
+        if (worker->thread.joinable() && worker->thread.get_id() != std::this_thread::get_id()) {
+            worker->thread.join();
+        }
+    }
+}
+
+size_t TelephonyStateRegistryDispatcher::GetPendingCount()
+{
+    size_t count = 0;
+    for (auto &worker : workers_) {
+        std::unique_lock<std::mutex> lock(worker->mutex);
+        count += worker->jobs.size() + (worker->busy ? 1 : 0);
+    }
+    return count;
+}
+
+bool TelephonyStateRegistryDispatcher::StartWorker(Worker &worker, uint32_t index)
+{
+    // Called with worker.mutex held, the new thread waits for it before looking at the queue.
+    worker.thread = std::thread([this, &worker]() { Run(worker); });
+    std::string name = "state_notify_" + std::to_string(index);
+    pthread_setname_np(worker.thread.native_handle(), name.c_str());
+    worker.running = true;
+    TELEPHONY_LOGI("Dispatch worker %{public}u started", index);
+    return true;
+}
+
+void TelephonyStateRegistryDispatcher::Run(Worker &worker)
+{
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    while (true) {
+        worker.condition.wait(lock, [&worker] { return worker.stopping || !worker.jobs.empty(); });
+        if (worker.jobs.empty()) {
+            break;
+        }
+        Job job = std::move(worker.jobs.front());
+        worker.jobs.pop_front();
+        worker.busy = true;
+        lock.unlock();
+        job();
+        lock.lock();
+        worker.busy = false;
+        if (worker.jobs.empty()) {
+            worker.idleCondition.notify_all();
+        }
+    }
+    worker.running = false;
+    worker.idleCondition.notify_all();
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -21,12 +21,22 @@
 
 namespace OHOS {
 namespace Telephony {
+namespace {
+const std::string METRICS_ARG = "-metrics";
+const std::string METRICS_RESET_ARG = "-metrics-reset";
+} // namespace
+
 bool TelephonyStateRegistryDumpHelper::Dump(const std::vector<std::string> &args,
-    std::vector<TelephonyStateRegistryRecord> &stateRecords, std::string &result) const
+    const TelephonyStateRegistrySubscribers &subscribers, std::string &result) const
 {
     result.clear();
+    for (const auto &arg : args) {
+        if (arg == METRICS_ARG || arg == METRICS_RESET_ARG) {
+            return ShowMetrics(arg == METRICS_RESET_ARG, result);
+        }
+    }
     ShowTelephonyChangeState(result);
-    return ShowTelephonyStateRegistryInfo(stateRecords, result);
+    return ShowTelephonyStateRegistryInfo(subscribers, result);
 }
 
 TelephonyStateRegistryDumpHelper::TelephonyStateRegistryDumpHelper() {}
@@ -39,11 +49,13 @@ bool TelephonyStateRegistryDumpHelper::WhetherHasSimCard(const int32_t slotId) c
 }
 
 bool TelephonyStateRegistryDumpHelper::ShowTelephonyStateRegistryInfo(
-    std::vector<TelephonyStateRegistryRecord> &stateRecords, std::string &result) const
+    const TelephonyStateRegistrySubscribers &subscribers, std::string &result) const
 {
+    const std::vector<TelephonyStateRegistryRecord> &stateRecords = subscribers.records;
     result.append("registrations: count= ").append(std::to_string(stateRecords.size())).append("\n");
     if (!stateRecords.empty()) {
-        for (const auto &item : stateRecords) {
+        for (size_t i = 0; i < stateRecords.size(); i++) {
+            const TelephonyStateRegistryRecord &item = stateRecords[i];
             if (item.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE)) {
                 result.append("CellularDataConnectState Register: ");
             } else if (item.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW)) {
@@ -68,10 +80,48 @@ bool TelephonyStateRegistryDumpHelper::ShowTelephonyStateRegistryInfo(
             result.append(" pid: ").append(std::to_string(item.pid_));
             result.append(" mask: ").append(std::to_string(item.mask_));
             result.append(" slotId: ").append(std::to_string(item.slotId_));
+            if (i < subscribers.mailboxes.size() && subscribers.mailboxes[i] != nullptr) {
+                TelephonyStateRegistryMailbox::Stats stats = subscribers.mailboxes[i]->GetStats();
+                result.append(" queueDepth: ").append(std::to_string(stats.depth));
+                result.append(" coalesced: ").append(std::to_string(stats.coalesced));
+                result.append(" dropped: ").append(std::to_string(stats.dropped));
+                result.append(" resyncs: ").append(std::to_string(stats.resyncs));
+                result.append(" deadObjectErrors: ").append(std::to_string(stats.deadObjectErrors));
+            }
+            if (i < subscribers.throttles.size() && subscribers.throttles[i] != nullptr) {
+                const TelephonyObserverDeliveryPolicy &policy = subscribers.throttles[i]->GetPolicy();
+                TelephonyStateRegistryThrottle::Stats stats = subscribers.throttles[i]->GetStats();
+                result.append(" minIntervalMs: ").append(std::to_string(policy.minIntervalMs));
+                result.append(" signalDeltaDbm: ").append(std::to_string(policy.signalDeltaDbm));
+                result.append(" levelChangeOnly: ").append(std::to_string(policy.levelChangeOnly));
+                result.append(" throttleDropped: ").append(std::to_string(stats.dropped));
+                result.append(" throttleDeferred: ").append(std::to_string(stats.deferred));
+                result.append(" throttleFlushed: ").append(std::to_string(stats.flushed));
+            }
             result.append(" }");
             result.append("\n");
         }
     }
+    TelephonyStateRegistryPayload::Stats payloadStats = TelephonyStateRegistryPayload::GetStats();
+    result.append("shared payloads: events= ").append(std::to_string(payloadStats.events));
+    result.append(" sends= ").append(std::to_string(payloadStats.sends));
+    result.append(" savedMarshalTimeUs= ").append(std::to_string(payloadStats.savedMarshalTimeUs)).append("\n");
+    return true;
+}
+
+bool TelephonyStateRegistryDumpHelper::ShowMetrics(bool reset, std::string &result) const
+{
+    std::shared_ptr<TelephonyStateRegistryService> service =
+        DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    if (service == nullptr) {
+        TELEPHONY_LOGE("Get state registry service failed");
+        return false;
+    }
+    service->GetMetrics().Dump(result);
+    if (reset) {
+        service->GetMetrics().Reset();
+        result.append("TelephonyStateRegistry Metrics reset\n");
+    }
     return true;
 }
 
@@ -95,6 +145,51 @@ void TelephonyStateRegistryDumpHelper::ShowTelephonyChangeState(std::string &res
     result.append("TelephonyStateRegistry ServiceRunningState = ");
     result.append(std::to_string(service->GetServiceRunningState()));
     result.append("\n");
+    TelephonyStateRegistryService::ObserverPurgeStats purgeStats = service->GetObserverPurgeStats();
+    result.append("TelephonyStateRegistry DiedObservers = ").append(std::to_string(purgeStats.died));
+    result.append(" EvictedObservers = ").append(std::to_string(purgeStats.evicted));
+    result.append(" PurgedRecords = ").append(std::to_string(purgeStats.purgedRecords)).append("\n");
+    TelephonyStateRegistryService::SuppressedUpdateStats suppressedStats = service->GetSuppressedUpdateStats();
+    result.append("TelephonyStateRegistry SuppressedUpdates SignalInfo = ");
+    result.append(std::to_string(suppressedStats.signalInfo));
+    result.append(" NetworkState = ").append(std::to_string(suppressedStats.networkState));
+    result.append(" CellularDataConnectState = ").append(std::to_string(suppressedStats.cellularDataConnectState));
+    result.append(" CellularDataFlow = ").append(std::to_string(suppressedStats.cellularDataFlow));
+    result.append(" BeforeDecoding = ").append(std::to_string(suppressedStats.parcel)).append("\n");
+    TelephonyStateRegistryService::BatchUpdateStats batchStats = service->GetBatchUpdateStats();
+    result.append("TelephonyStateRegistry BatchUpdates = ").append(std::to_string(batchStats.batches));
+    result.append(" NotifiedUpdates = ").append(std::to_string(batchStats.updates)).append("\n");
+    TelephonyStateRegistryPermissionCache::Stats permissionStats = service->GetPermissionCacheStats();
+    result.append("TelephonyStateRegistry PermissionCache Hits = ").append(std::to_string(permissionStats.hits));
+    result.append(" Misses = ").append(std::to_string(permissionStats.misses));
+    result.append(" Changes = ").append(std::to_string(permissionStats.changes)).append("\n");
+    TelephonyStateRegistryEventPublisher::Stats eventStats = service->GetEventPublisherStats();
+    result.append("TelephonyStateRegistry CommonEvents Published = ").append(std::to_string(eventStats.published));
+    result.append(" Coalesced = ").append(std::to_string(eventStats.coalesced));
+    result.append(" Failed = ").append(std::to_string(eventStats.failed));
+    result.append(" Dropped = ").append(std::to_string(eventStats.dropped));
+    result.append(" Pending = ").append(std::to_string(eventStats.depth)).append("\n");
+    for (uint32_t i = 0; i < static_cast<uint32_t>(TelephonyStateRegistryEventPublisher::Kind::KIND_COUNT); i++) {
+        if (eventStats.droppedKinds[i] == 0) {
+            continue;
+        }
+        auto kind = static_cast<TelephonyStateRegistryEventPublisher::Kind>(i);
+        result.append("TelephonyStateRegistry CommonEvent ");
+        result.append(TelephonyStateRegistryEventPublisher::GetKindName(kind));
+        result.append(" Dropped = ").append(std::to_string(eventStats.droppedKinds[i])).append("\n");
+    }
+    for (uint32_t i = 0; i < static_cast<uint32_t>(TelephonyExtWrapper::Hook::HOOK_COUNT); i++) {
+        auto hook = static_cast<TelephonyExtWrapper::Hook>(i);
+        TelephonyExtWrapper::HookStats hookStats = TELEPHONY_EXT_WRAPPER.GetHookStats(hook);
+        if (hookStats.calls == 0) {
+            continue;
+        }
+        result.append("TelephonyStateRegistry ExtHook ").append(TelephonyExtWrapper::GetHookName(hook));
+        result.append(" Calls = ").append(std::to_string(hookStats.calls));
+        result.append(" OverBudget = ").append(std::to_string(hookStats.overBudgetCalls));
+        result.append(" AvgUs = ").append(std::to_string(hookStats.totalTimeUs / hookStats.calls));
+        result.append(" MaxUs = ").append(std::to_string(hookStats.maxTimeUs)).append("\n");
+    }
     for (int32_t i = 0; i < SIM_SLOT_COUNT; i++) {
         if (WhetherHasSimCard(i)) {
             result.append("SlotId = ");
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_event_publisher.h"
+
+#include <pthread.h>
+#include <string>
+
+#include "parameters.h"
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+struct IntervalParameter {
+    TelephonyStateRegistryEventPublisher::Kind kind;
+    const char *key;
+    int32_t defaultIntervalMs;
+};
+
+// Signal information changes every few seconds on a moving device and each event carries every signal as text.
+const IntervalParameter INTERVAL_PARAMETERS[] = {
+    { TelephonyStateRegistryEventPublisher::Kind::SIGNAL_INFO,
+        "persist.telephony.state_registry.event_interval.signal_info", 1000 },
+    { TelephonyStateRegistryEventPublisher::Kind::NETWORK_STATE,
+        "persist.telephony.state_registry.event_interval.network_state", 0 },
+    { TelephonyStateRegistryEventPublisher::Kind::DATA_CONNECT_STATE,
+        "persist.telephony.state_registry.event_interval.data_connect_state", 0 },
+};
+} // namespace
+
+TelephonyStateRegistryEventPublisher::TelephonyStateRegistryEventPublisher(size_t capacity)
+    : capacity_(capacity > 0 ? capacity : DEFAULT_CAPACITY)
+{
+    for (const auto &parameter : INTERVAL_PARAMETERS) {
+        int32_t intervalMs = OHOS::system::GetIntParameter(std::string(parameter.key), parameter.defaultIntervalMs);
+        SetMinInterval(parameter.kind, intervalMs > 0 ? static_cast<uint32_t>(intervalMs) : 0);
+    }
+}
+
+TelephonyStateRegistryEventPublisher::~TelephonyStateRegistryEventPublisher()
+{
+    Stop();
+}
+
+bool TelephonyStateRegistryEventPublisher::IsCoalescing(Kind kind)
+{
+    return kind == Kind::SIGNAL_INFO || kind == Kind::NETWORK_STATE || kind == Kind::DATA_CONNECT_STATE;
+}
+
+const char *TelephonyStateRegistryEventPublisher::GetKindName(Kind kind)
+{
+    switch (kind) {
+        case Kind::CALL_STATE:
+            return "CALL_STATE_CHANGED";
+        case Kind::CALL_STATE_WITH_NUMBER:
+            return "CALL_STATE_CHANGED_WITH_NUMBER";
+        case Kind::SIM_STATE:
+            return "SIM_STATE_CHANGED";
+        case Kind::SIGNAL_INFO:
+            return "SIGNAL_INFO_CHANGED";
+        case Kind::NETWORK_STATE:
+            return "NETWORK_STATE_CHANGED";
+        case Kind::DATA_CONNECT_STATE:
+            return "CELLULAR_DATA_STATE_CHANGED";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+void TelephonyStateRegistryEventPublisher::Post(Kind kind, int32_t slotId, Publish publish)
+{
+    if (publish == nullptr || kind >= Kind::KIND_COUNT) {
+        return;
+    }
+    Key key(static_cast<uint32_t>(kind), slotId);
+    bool coalesce = IsCoalescing(kind);
+    // Released out of the lock, an event may hold the last reference of the state it publishes.
+    Publish replaced;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+        return;
+    }
+    if (coalesce) {
+        for (auto &entry : entries_) {
+            if (entry.coalesce && entry.key == key) {
+                replaced.swap(entry.publish);
+                entry.publish = std::move(publish);
+                stats_.coalesced++;
+                return;
+            }
+        }
+    }
+    if (!coalesce && transitionCount_ >= capacity_) {
+        auto victim = entries_.begin();
+        while (victim->coalesce) {
+            ++victim;
+        }
+        TELEPHONY_LOGE("EventPublisher full, drop %{public}s of slot %{public}d",
+            GetKindName(static_cast<Kind>(victim->key.first)), victim->key.second);
+        CountDropped(*victim);
+        replaced.swap(victim->publish);
+        entries_.erase(victim);
+        transitionCount_--;
+    }
+    entries_.push_back({ key, coalesce, std::move(publish) });
+    if (!coalesce) {
+        transitionCount_++;
+    }
+    if (!thread_.joinable()) {
+        thread_ = std::thread([this]() { Run(); });
+        pthread_setname_np(thread_.native_handle(), "state_event");
+    }
+    condition_.notify_one();
+}
+
+void TelephonyStateRegistryEventPublisher::SetMinInterval(Kind kind, uint32_t intervalMs)
+{
+    if (!IsCoalescing(kind)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    intervalsMs_[static_cast<uint32_t>(kind)] = intervalMs;
+    condition_.notify_one();
+}
+
+void TelephonyStateRegistryEventPublisher::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCondition_.wait(lock, [this] { return !thread_.joinable() || (entries_.empty() && !busy_); });
+}
+
+void TelephonyStateRegistryEventPublisher::Stop()
+{
+    std::thread thread;
+    std::deque<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (const auto &entry : entries_) {
+            CountDropped(entry);
+        }
+        entries.swap(entries_);
+        transitionCount_ = 0;
+        thread.swap(thread_);
+        condition_.notify_all();
+    }
+    if (thread.joinable()) {
+        if (thread.get_id() == std::this_thread::get_id()) {
+            thread.detach();
+        } else {
+            thread.join();
+        }
+    }
+    idleCondition_.notify_all();
+}
+
+TelephonyStateRegistryEventPublisher::Stats TelephonyStateRegistryEventPublisher::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.depth = entries_.size();
+    return stats;
+}
+
+TelephonyStateRegistryEventPublisher::Clock::time_point TelephonyStateRegistryEventPublisher::GetReadyTime(
+    const Entry &entry) const
+{
+    uint32_t intervalMs = intervalsMs_[entry.key.first];
+    auto it = lastPublishTimes_.find(entry.key);
+    if (!entry.coalesce || intervalMs == 0 || it == lastPublishTimes_.end()) {
+        return Clock::time_point::min();
+    }
+    return it->second + std::chrono::milliseconds(intervalMs);
+}
+
+void TelephonyStateRegistryEventPublisher::CountDropped(const Entry &entry)
+{
+    stats_.dropped++;
+    stats_.droppedKinds[entry.key.first]++;
+}
+
+void TelephonyStateRegistryEventPublisher::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (entries_.empty()) {
+            idleCondition_.notify_all();
+            condition_.wait(lock, [this] { return stopping_ || !entries_.empty(); });
+            continue;
+        }
+        // The first event which is not held back, a coalescing kind has one queued event per slot at most.
+        auto now = Clock::now();
+        auto next = Clock::time_point::max();
+        auto ready = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            auto readyTime = GetReadyTime(*it);
+            if (readyTime <= now) {
+                ready = it;
+                break;
+            }
+            next = std::min(next, readyTime);
+        }
+        if (ready == entries_.end()) {
+            condition_.wait_until(lock, next);
+            continue;
+        }
+        Entry entry = std::move(*ready);
+        entries_.erase(ready);
+        if (!entry.coalesce) {
+            transitionCount_--;
+        }
+        lastPublishTimes_[entry.key] = now;
+        busy_ = true;
+        lock.unlock();
+        bool published = entry.publish();
+        entry.publish = nullptr;
+        lock.lock();
+        busy_ = false;
+        published ? stats_.published++ : stats_.failed++;
+    }
+    idleCondition_.notify_all();
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_event_ring.h"
+
+#include <climits>
+#include <cstring>
+#include <linux/futex.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr uint32_t MAX_ENTRY_COUNT = 1024;
+} // namespace
+
+std::shared_ptr<TelephonyStateRegistryEventRing> TelephonyStateRegistryEventRing::Create(
+    const sptr<Ashmem> &ashmem, int32_t slotId, uint32_t mask, uint32_t entryCount, uint32_t entrySize)
+{
+    if (ashmem == nullptr || entryCount == 0 || entryCount > MAX_ENTRY_COUNT || entrySize == 0) {
+        return nullptr;
+    }
+    uint32_t count = 1;
+    while (count < entryCount) {
+        count <<= 1;
+    }
+    size_t size = TelephonyEventRing::GetSize(count, entrySize);
+    if (ashmem->GetAshmemSize() < 0 || static_cast<size_t>(ashmem->GetAshmemSize()) < size) {
+        TELEPHONY_LOGE("EventRing ashmem of size %{public}d too small", ashmem->GetAshmemSize());
+        return nullptr;
+    }
+    // This mapping is the only writable one once the caller reduced the protection of the region.
+    void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, ashmem->GetAshmemFd(), 0);
+    if (address == MAP_FAILED) {
+        TELEPHONY_LOGE("EventRing map ashmem failed");
+        return nullptr;
+    }
+    auto header = new (address) TelephonyEventRing::Header();
+    header->layoutVersion = TelephonyEventRing::LAYOUT_VERSION;
+    header->slotId = slotId;
+    header->mask = mask;
+    header->entryCount = count;
+    header->entrySize = entrySize;
+    auto entries = reinterpret_cast<uint8_t *>(address) + sizeof(TelephonyEventRing::Header);
+    for (uint32_t i = 0; i < count; i++) {
+        new (entries + TelephonyEventRing::GetEntryStride(entrySize) * i) TelephonyEventRing::Entry();
+    }
+    header->magic = TelephonyEventRing::MAGIC;
+    return std::make_shared<TelephonyStateRegistryEventRing>(ashmem, address, size);
+}
+
+TelephonyStateRegistryEventRing::TelephonyStateRegistryEventRing(
+    const sptr<Ashmem> &ashmem, void *address, size_t size)
+    : ashmem_(ashmem), address_(address), size_(size)
+{}
+
+TelephonyStateRegistryEventRing::~TelephonyStateRegistryEventRing()
+{
+    if (address_ != nullptr) {
+        munmap(address_, size_);
+    }
+    if (ashmem_ != nullptr) {
+        ashmem_->CloseAshmem();
+    }
+}
+
+TelephonyEventRing::Header *TelephonyStateRegistryEventRing::GetHeader() const
+{
+    return reinterpret_cast<TelephonyEventRing::Header *>(address_);
+}
+
+TelephonyEventRing::Entry *TelephonyStateRegistryEventRing::GetEntry(uint64_t sequence) const
+{
+    TelephonyEventRing::Header *header = GetHeader();
+    uint64_t index = (sequence - 1) & (header->entryCount - 1);
+    return reinterpret_cast<TelephonyEventRing::Entry *>(reinterpret_cast<uint8_t *>(address_) +
+        sizeof(TelephonyEventRing::Header) + TelephonyEventRing::GetEntryStride(header->entrySize) * index);
+}
+
+bool TelephonyStateRegistryEventRing::Write(
+    uint32_t code, uint64_t stateSequence, const std::vector<uint8_t> &arguments)
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    TelephonyEventRing::Header *header = GetHeader();
+    uint64_t sequence = header->head.load(std::memory_order_relaxed) + 1;
+    TelephonyEventRing::Entry *entry = GetEntry(sequence);
+    bool fits = arguments.size() <= header->entrySize;
+    entry->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry->stateSequence.store(stateSequence, std::memory_order_relaxed);
+    entry->code.store(fits ? code : 0, std::memory_order_relaxed);
+    entry->size.store(fits ? static_cast<uint32_t>(arguments.size()) : 0, std::memory_order_relaxed);
+    if (fits && !arguments.empty()) {
+        memcpy(reinterpret_cast<uint8_t *>(entry) + sizeof(TelephonyEventRing::Entry), arguments.data(),
+            arguments.size());
+    }
+    entry->sequence.store(sequence, std::memory_order_release);
+    header->head.store(sequence, std::memory_order_release);
+    header->wakeup.fetch_add(1, std::memory_order_release);
+    // The readers map the ring read-only and can not tell they are waiting, every write wakes them.
+    syscall(SYS_futex, &header->wakeup, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    if (!fits) {
+        TELEPHONY_LOGW("EventRing slot %{public}d event of %{public}zu bytes lost", header->slotId, arguments.size());
+    }
+    return fits;
+}
+
+sptr<Ashmem> TelephonyStateRegistryEventRing::GetAshmem() const
+{
+    return ashmem_;
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_mailbox.h"
+
+#include <algorithm>
+#include <pthread.h>
+#include <string>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr uint32_t SLOT_KEY_BITS = 32;
+} // namespace
+
+TelephonyStateRegistryMailbox::TelephonyStateRegistryMailbox(size_t capacity)
+    : capacity_(capacity > 0 ? capacity : DEFAULT_CAPACITY)
+{}
+
+uint64_t TelephonyStateRegistryMailbox::MakeKey(uint32_t event, int32_t slotId)
+{
+    return (static_cast<uint64_t>(event) << SLOT_KEY_BITS) | static_cast<uint32_t>(slotId);
+}
+
+void TelephonyStateRegistryMailbox::SetResync(Job resync)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    resync_ = std::move(resync);
+}
+
+bool TelephonyStateRegistryMailbox::Post(uint64_t key, bool coalesce, Job job)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (resyncPending_) {
+        // The resync reads the state when it runs, this delivery is already part of it.
+        stats_.resynced++;
+        return false;
+    }
+    if (coalesce) {
+        for (auto &entry : entries_) {
+            if (entry.coalesce && entry.key == key) {
+                entry.job = std::move(job);
+                stats_.coalesced++;
+                return false;
+            }
+        }
+    }
+    if (entries_.size() >= capacity_) {
+        auto victim = std::find_if(entries_.begin(), entries_.end(), [](const Entry &entry) { return entry.coalesce; });
+        if (victim != entries_.end()) {
+            TELEPHONY_LOGW("Mailbox full, drop event %{public}u", static_cast<uint32_t>(victim->key >> SLOT_KEY_BITS));
+            entries_.erase(victim);
+            stats_.dropped++;
+        } else if (resync_ != nullptr) {
+            TELEPHONY_LOGW("Mailbox full, resync observer instead of event %{public}u",
+                static_cast<uint32_t>(key >> SLOT_KEY_BITS));
+            resyncPending_ = true;
+            stats_.resyncs++;
+            stats_.resynced++;
+            entries_.push_back({ 0, false, true, resync_ });
+            return Schedule();
+        } else {
+            TELEPHONY_LOGW("Mailbox full, queue event %{public}u over capacity",
+                static_cast<uint32_t>(key >> SLOT_KEY_BITS));
+        }
+    }
+    entries_.push_back({ key, coalesce, false, std::move(job) });
+    return Schedule();
+}
+
+bool TelephonyStateRegistryMailbox::Schedule()
+{
+    // Called with mutex_ held.
+    if (scheduled_) {
+        return false;
+    }
+    scheduled_ = true;
+    return true;
+}
+
+bool TelephonyStateRegistryMailbox::Drain(size_t maxJobs)
+{
+    for (size_t i = 0; i < maxJobs; i++) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (entries_.empty()) {
+                break;
+            }
+            job = std::move(entries_.front().job);
+            // A delivery posted from now on may follow a state the resync has already read.
+            if (entries_.front().resync) {
+                resyncPending_ = false;
+            }
+            entries_.pop_front();
+        }
+        job();
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.delivered++;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.empty()) {
+        scheduled_ = false;
+        return false;
+    }
+    return true;
+}
+
+void TelephonyStateRegistryMailbox::Clear()
+{
+    // Released out of the lock, the deliveries may hold the last reference of other mailboxes.
+    std::deque<Entry> entries;
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.dropped += entries_.size();
+    entries.swap(entries_);
+    resyncPending_ = false;
+}
+
+uint32_t TelephonyStateRegistryMailbox::RecordDeliveryResult(bool deadObject)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!deadObject) {
+        consecutiveDeadObjectErrors_ = 0;
+        return 0;
+    }
+    stats_.deadObjectErrors++;
+    return ++consecutiveDeadObjectErrors_;
+}
+
+TelephonyStateRegistryMailbox::Stats TelephonyStateRegistryMailbox::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.depth = entries_.size();
+    return stats;
+}
+
+TelephonyStateRegistryDeliveryPool::TelephonyStateRegistryDeliveryPool(uint32_t threadCount)
+    : threadCount_(threadCount > 0 ? threadCount : 1)
+{}
+
+TelephonyStateRegistryDeliveryPool::~TelephonyStateRegistryDeliveryPool()
+{
+    Stop();
+}
+
+void TelephonyStateRegistryDeliveryPool::Schedule(const std::shared_ptr<TelephonyStateRegistryMailbox> &mailbox)
+{
+    if (mailbox == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_) {
+            if (threads_.empty()) {
+                for (uint32_t i = 0; i < threadCount_; i++) {
+                    threads_.emplace_back([this]() { Run(); });
+                    std::string name = "state_deliver_" + std::to_string(i);
+                    pthread_setname_np(threads_.back().native_handle(), name.c_str());
+                }
+            }
+            ready_.push_back(mailbox);
+            condition_.notify_one();
+            return;
+        }
+    }
+    while (mailbox->Drain(DRAIN_BATCH_SIZE)) {}
+}
+
+void TelephonyStateRegistryDeliveryPool::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCondition_.wait(lock, [this] { return threads_.empty() || (ready_.empty() && busyCount_ == 0); });
+}
+
+void TelephonyStateRegistryDeliveryPool::Stop()
+{
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        condition_.notify_all();
+        threads.swap(threads_);
+    }
+    for (auto &thread : threads) {
+        if (thread.joinable() && thread.get_id() != std::this_thread::get_id()) {
+            thread.join();
+        }
+    }
+    idleCondition_.notify_all();
+}
+
+void TelephonyStateRegistryDeliveryPool::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this] { return stopping_ || !ready_.empty(); });
+        if (ready_.empty()) {
+            break;
+        }
+        auto mailbox = ready_.front();
+        ready_.pop_front();
+        busyCount_++;
+        lock.unlock();
+        bool remaining = mailbox->Drain(DRAIN_BATCH_SIZE);
+        lock.lock();
+        busyCount_--;
+        if (remaining) {
+            ready_.push_back(mailbox);
+            condition_.notify_one();
+        } else if (ready_.empty() && busyCount_ == 0) {
+            idleCondition_.notify_all();
+        }
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_metrics.h"
+
+#include "telephony_observer_broker.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr uint32_t PERCENT = 100;
+constexpr uint32_t P50 = 50;
+constexpr uint32_t P90 = 90;
+constexpr uint32_t P99 = 99;
+constexpr uint32_t MAX_BIT = 63;
+
+struct EventName {
+    uint32_t mask;
+    const char *name;
+};
+
+const EventName EVENT_NAMES[] = {
+    { TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, "NetworkState" },
+    { TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE, "CallState" },
+    { TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO, "CellInfo" },
+    { TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, "SignalInfo" },
+    { TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE, "SimState" },
+    { TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE, "CellularDataConnectState" },
+    { TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW, "CellularDataFlow" },
+    { TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR, "CfuIndicator" },
+    { TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR, "VoiceMailMsgIndicator" },
+    { TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT, "IccAccount" },
+    { TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX, "CallStateEx" },
+    { TelephonyObserverBroker::OBSERVER_MASK_CCALL_STATE, "CCallState" },
+    { TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE, "SimActiveState" },
+};
+
+int64_t GetNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void UpdateMax(std::atomic<uint64_t> &max, uint64_t value)
+{
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+void AppendHistogram(std::string &result, const char *name, const TelephonyStateRegistryHistogram &histogram)
+{
+    TelephonyStateRegistryHistogram::Snapshot snapshot = histogram.GetSnapshot();
+    result.append(" ").append(name).append(" = { count: ").append(std::to_string(snapshot.count));
+    if (snapshot.count > 0) {
+        result.append(" avg: ").append(std::to_string(snapshot.sum / snapshot.count));
+        result.append(" p50: ").append(std::to_string(snapshot.p50));
+        result.append(" p90: ").append(std::to_string(snapshot.p90));
+        result.append(" p99: ").append(std::to_string(snapshot.p99));
+        result.append(" max: ").append(std::to_string(snapshot.max));
+    }
+    result.append(" }");
+}
+} // namespace
+
+uint32_t TelephonyStateRegistryHistogram::GetBucketIndex(uint64_t value)
+{
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<uint32_t>(value);
+    }
+    uint32_t msb = MAX_BIT - static_cast<uint32_t>(__builtin_clzll(value));
+    uint32_t group = msb - SUB_BUCKET_BITS + 1;
+    uint32_t sub = static_cast<uint32_t>(value >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+    uint32_t index = group * SUB_BUCKET_COUNT + sub;
+    return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+}
+
+uint64_t TelephonyStateRegistryHistogram::GetBucketLowerBound(uint32_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    uint32_t group = index / SUB_BUCKET_COUNT;
+    uint64_t sub = index % SUB_BUCKET_COUNT;
+    return (SUB_BUCKET_COUNT + sub) << (group - 1);
+}
+
+void TelephonyStateRegistryHistogram::Record(uint64_t value)
+{
+    buckets_[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    UpdateMax(max_, value);
+}
+
+TelephonyStateRegistryHistogram::Snapshot TelephonyStateRegistryHistogram::GetSnapshot() const
+{
+    Snapshot snapshot;
+    for (const auto &bucket : buckets_) {
+        snapshot.count += bucket.load(std::memory_order_relaxed);
+    }
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+    snapshot.max = max_.load(std::memory_order_relaxed);
+    snapshot.p50 = GetPercentile(snapshot.count, P50);
+    snapshot.p90 = GetPercentile(snapshot.count, P90);
+    snapshot.p99 = GetPercentile(snapshot.count, P99);
+    return snapshot;
+}
+
+uint64_t TelephonyStateRegistryHistogram::GetPercentile(uint64_t count, uint32_t percent) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    // Rank of the value, rounded up, reported as the lower bound of its bucket.
+    uint64_t rank = (count * percent + PERCENT - 1) / PERCENT;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return GetBucketLowerBound(i);
+        }
+    }
+    return GetBucketLowerBound(BUCKET_COUNT - 1);
+}
+
+TelephonyStateRegistryMetrics::FanOut::FanOut(std::shared_ptr<Cell> cell)
+    : cell_(std::move(cell)), begin_(std::chrono::steady_clock::now())
+{}
+
+TelephonyStateRegistryMetrics::FanOut::~FanOut()
+{
+    auto timeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin_);
+    cell_->fanOutTimeUs.Record(static_cast<uint64_t>(timeUs.count()));
+}
+
+void TelephonyStateRegistryMetrics::FanOut::RecordNotification(uint64_t sendTimeUs, bool ipcFailed)
+{
+    cell_->notified.fetch_add(1, std::memory_order_relaxed);
+    cell_->sendTimeUs.Record(sendTimeUs);
+    if (ipcFailed) {
+        cell_->ipcFailures.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+TelephonyStateRegistryMetrics::TelephonyStateRegistryMetrics()
+{
+    resetTimeMs_ = GetNowMs();
+}
+
+bool TelephonyStateRegistryMetrics::GetCellIndex(uint32_t event, int32_t slotId, uint32_t &index)
+{
+    if (event == 0 || (event & (event - 1)) != 0 || slotId < MIN_SLOT_ID || slotId > MAX_SLOT_ID) {
+        return false;
+    }
+    uint32_t bit = static_cast<uint32_t>(__builtin_ctz(event));
+    index = bit * SLOT_COUNT + static_cast<uint32_t>(slotId - MIN_SLOT_ID);
+    return true;
+}
+
+const char *TelephonyStateRegistryMetrics::GetEventName(uint32_t bit)
+{
+    for (const auto &eventName : EVENT_NAMES) {
+        if (eventName.mask == (1u << bit)) {
+            return eventName.name;
+        }
+    }
+    return "Unknown";
+}
+
+std::shared_ptr<TelephonyStateRegistryMetrics::FanOut> TelephonyStateRegistryMetrics::BeginFanOut(
+    uint32_t event, int32_t slotId, size_t matched)
+{
+    uint32_t index = 0;
+    if (!GetCellIndex(event, slotId, index)) {
+        return nullptr;
+    }
+    std::shared_ptr<Cell> cell = std::atomic_load(&cells_[index]);
+    if (cell == nullptr) {
+        auto created = std::make_shared<Cell>();
+        // Another thread may have created it meanwhile, keep the first one.
+        if (std::atomic_compare_exchange_strong(&cells_[index], &cell, created)) {
+            cell = created;
+        }
+    }
+    cell->updates.fetch_add(1, std::memory_order_relaxed);
+    cell->matched.fetch_add(matched, std::memory_order_relaxed);
+    return std::make_shared<FanOut>(cell);
+}
+
+void TelephonyStateRegistryMetrics::Reset()
+{
+    for (auto &cell : cells_) {
+        std::atomic_store(&cell, std::shared_ptr<Cell>());
+    }
+    resetTimeMs_ = GetNowMs();
+}
+
+void TelephonyStateRegistryMetrics::Dump(std::string &result) const
+{
+    result.append("TelephonyStateRegistry Metrics, times in us, since ");
+    result.append(std::to_string(GetNowMs() - resetTimeMs_.load())).append(" ms\n");
+    for (uint32_t index = 0; index < cells_.size(); index++) {
+        std::shared_ptr<Cell> cell = std::atomic_load(&cells_[index]);
+        if (cell == nullptr) {
+            continue;
+        }
+        int32_t slotId = static_cast<int32_t>(index % SLOT_COUNT) + MIN_SLOT_ID;
+        result.append("  ").append(GetEventName(index / SLOT_COUNT));
+        result.append(" slotId: ").append(std::to_string(slotId));
+        result.append(" updates: ").append(std::to_string(cell->updates.load()));
+        result.append(" matched: ").append(std::to_string(cell->matched.load()));
+        result.append(" notified: ").append(std::to_string(cell->notified.load()));
+        result.append(" ipcFailures: ").append(std::to_string(cell->ipcFailures.load()));
+        AppendHistogram(result, "fanOut", cell->fanOutTimeUs);
+        AppendHistogram(result, "send", cell->sendTimeUs);
+        result.append("\n");
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_payload.h"
+
+#include <chrono>
+#include <mutex>
+
+#include "telephony_log_wrapper.h"
+#include "telephony_observer_proxy.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr size_t MAX_POOLED_PARCEL_COUNT = 8;
+constexpr uint64_t NS_PER_US = 1000;
+std::mutex g_parcelPoolMutex;
+std::vector<std::unique_ptr<MessageParcel>> g_parcelPool;
+std::atomic<uint64_t> g_payloadEvents { 0 };
+std::atomic<uint64_t> g_payloadSends { 0 };
+std::atomic<uint64_t> g_savedMarshalTimeNs { 0 };
+} // namespace
+
+TelephonyStateRegistryPayload::TelephonyStateRegistryPayload(uint32_t code, uint32_t flags)
+    : code_(code), flags_(flags)
+{}
+
+TelephonyStateRegistryPayload::~TelephonyStateRegistryPayload()
+{
+    uint32_t sendCount = sendCount_.load();
+    if (sendCount == 0) {
+        return;
+    }
+    g_payloadEvents++;
+    g_payloadSends += sendCount;
+    g_savedMarshalTimeNs += encodeTimeNs_ * (sendCount - 1);
+}
+
+std::shared_ptr<TelephonyStateRegistryPayload> TelephonyStateRegistryPayload::CreateSignalInfo(
+    int32_t slotId, const std::vector<sptr<SignalInformation>> &vec)
+{
+    auto payload = std::make_shared<TelephonyStateRegistryPayload>(
+        static_cast<uint32_t>(TelephonyObserverBroker::ObserverBrokerCode::ON_SIGNAL_INFO_UPDATED),
+        MessageOption::TF_ASYNC | MessageOption::TF_ASYNC_WAKEUP_LATER);
+    bool encoded = payload->Encode([slotId, &vec](MessageParcel &dataParcel) {
+        return TelephonyObserverProxy::WriteSignalInfo(dataParcel, slotId, vec);
+    });
+    return encoded ? payload : nullptr;
+}
+
+std::shared_ptr<TelephonyStateRegistryPayload> TelephonyStateRegistryPayload::CreateCellInfo(
+    int32_t slotId, const std::vector<sptr<CellInformation>> &vec)
+{
+    auto payload = std::make_shared<TelephonyStateRegistryPayload>(
+        static_cast<uint32_t>(TelephonyObserverBroker::ObserverBrokerCode::ON_CELL_INFO_UPDATED),
+        MessageOption::TF_ASYNC);
+    bool encoded = payload->Encode([slotId, &vec](MessageParcel &dataParcel) {
+        return TelephonyObserverProxy::WriteCellInfo(dataParcel, slotId, vec);
+    });
+    return encoded ? payload : nullptr;
+}
+
+std::shared_ptr<TelephonyStateRegistryPayload> TelephonyStateRegistryPayload::CreateNetworkState(
+    int32_t slotId, const sptr<NetworkState> &networkState)
+{
+    auto payload = std::make_shared<TelephonyStateRegistryPayload>(
+        static_cast<uint32_t>(TelephonyObserverBroker::ObserverBrokerCode::ON_NETWORK_STATE_UPDATED),
+        MessageOption::TF_ASYNC | MessageOption::TF_ASYNC_WAKEUP_LATER);
+    bool encoded = payload->Encode([slotId, &networkState](MessageParcel &dataParcel) {
+        return TelephonyObserverProxy::WriteNetworkState(dataParcel, slotId, networkState);
+    });
+    return encoded ? payload : nullptr;
+}
+
+template<typename Writer>
+bool TelephonyStateRegistryPayload::Encode(Writer writer)
+{
+    auto begin = std::chrono::steady_clock::now();
+    std::unique_ptr<MessageParcel> dataParcel = AcquireParcel();
+    bool result = writer(*dataParcel);
+    if (result) {
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(dataParcel->GetData());
+        body_.assign(data, data + dataParcel->GetDataSize());
+    }
+    ReleaseParcel(std::move(dataParcel));
+    encodeTimeNs_ = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+    return result;
+}
+
+TelephonyStateRegistryPayload::Stats TelephonyStateRegistryPayload::GetStats()
+{
+    Stats stats;
+    stats.events = g_payloadEvents.load();
+    stats.sends = g_payloadSends.load();
+    stats.savedMarshalTimeUs = g_savedMarshalTimeNs.load() / NS_PER_US;
+    return stats;
+}
+
+bool TelephonyStateRegistryPayload::SendTo(const sptr<TelephonyObserverBroker> &observer)
+{
+    if (observer == nullptr || body_.empty()) {
+        return false;
+    }
+    sptr<IRemoteObject> remote = observer->AsObject();
+    if (remote == nullptr || !remote->IsProxyObject()) {
+        return false;
+    }
+    std::unique_ptr<MessageParcel> dataParcel = AcquireParcel();
+    if (!TelephonyObserverProxy::WriteRequestHeader(*dataParcel) ||
+        !dataParcel->WriteBuffer(body_.data(), body_.size())) {
+        TELEPHONY_LOGE("TelephonyStateRegistryPayload write code %{public}u failed", code_);
+        ReleaseParcel(std::move(dataParcel));
+        return false;
+    }
+    MessageParcel replyParcel;
+    MessageOption option(flags_);
+    int32_t result =
+        remote->SendRequest(TelephonyObserverProxy::GetRequestCode(code_), *dataParcel, replyParcel, option);
+    ReleaseParcel(std::move(dataParcel));
+    sendCount_++;
+    TELEPHONY_LOGD("TelephonyStateRegistryPayload code %{public}u ##error: %{public}d", code_, result);
+    return true;
+}
+
+uint32_t TelephonyStateRegistryPayload::GetCode() const
+{
+    return code_;
+}
+
+const std::vector<uint8_t> &TelephonyStateRegistryPayload::GetBody() const
+{
+    return body_;
+}
+
+std::unique_ptr<MessageParcel> TelephonyStateRegistryPayload::AcquireParcel()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_parcelPoolMutex);
+        if (!g_parcelPool.empty()) {
+            std::unique_ptr<MessageParcel> parcel = std::move(g_parcelPool.back());
+            g_parcelPool.pop_back();
+            return parcel;
+        }
+    }
+    return std::make_unique<MessageParcel>();
+}
+
+void TelephonyStateRegistryPayload::ReleaseParcel(std::unique_ptr<MessageParcel> parcel)
+{
+    // Keep the buffer of the parcel, the next payload overwrites it.
+    parcel->RewindRead(0);
+    parcel->RewindWrite(0);
+    std::lock_guard<std::mutex> lock(g_parcelPoolMutex);
+    if (g_parcelPool.size() < MAX_POOLED_PARCEL_COUNT) {
+        g_parcelPool.push_back(std::move(parcel));
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
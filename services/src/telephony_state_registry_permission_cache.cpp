@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_permission_cache.h"
+
+#include <vector>
+
+#include "accesstoken_kit.h"
+#include "telephony_log_wrapper.h"
+#include "telephony_permission.h"
+
+namespace OHOS {
+namespace Telephony {
+using namespace OHOS::Security::AccessToken;
+namespace {
+// Permissions checked for each call state observer when a call state changes.
+const std::vector<std::string> CACHED_PERMISSIONS = {
+    Permission::READ_CALL_LOG,
+    Permission::MANAGE_CALL_FOR_DEVICES,
+};
+constexpr int32_t MAX_TRACK_ATTEMPTS = 3;
+} // namespace
+
+TelephonyStateRegistryPermissionCache::~TelephonyStateRegistryPermissionCache()
+{
+    SetTrackedTokens({});
+}
+
+void TelephonyStateRegistryPermissionCache::SetTrackedTokens(const std::set<int32_t> &tokenIds)
+{
+    std::vector<std::shared_ptr<PermissionChangeCallback>> released;
+    std::vector<int32_t> added;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            if (tokenIds.find(it->first) != tokenIds.end()) {
+                ++it;
+                continue;
+            }
+            if (it->second.callback != nullptr) {
+                released.push_back(it->second.callback);
+            }
+            it = entries_.erase(it);
+        }
+        for (int32_t tokenId : tokenIds) {
+            if (entries_.find(tokenId) == entries_.end()) {
+                added.push_back(tokenId);
+            }
+        }
+    }
+    for (const auto &callback : released) {
+        AccessTokenKit::UnRegisterPermStateChangeCallback(callback);
+    }
+    for (int32_t tokenId : added) {
+        Track(tokenId);
+    }
+}
+
+void TelephonyStateRegistryPermissionCache::Track(int32_t tokenId)
+{
+    PermStateChangeScope scope;
+    scope.tokenIDs = { static_cast<AccessTokenID>(tokenId) };
+    scope.permList = CACHED_PERMISSIONS;
+    auto callback = std::make_shared<PermissionChangeCallback>(scope, *this);
+    // Registered before the first verification, a change in between is not missed.
+    int32_t ret = AccessTokenKit::RegisterPermStateChangeCallback(callback);
+    if (ret != 0) {
+        TELEPHONY_LOGW("Register permission callback of token failed, ret %{public}d", ret);
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_[tokenId] = Entry();
+        return;
+    }
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry &entry = entries_[tokenId];
+        entry.callback = callback;
+        generation = entry.generation;
+    }
+    for (int32_t attempt = 0; attempt < MAX_TRACK_ATTEMPTS; attempt++) {
+        std::map<std::string, bool> decisions;
+        for (const auto &permission : CACHED_PERMISSIONS) {
+            decisions[permission] = VerifyAccessToken(tokenId, permission);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(tokenId);
+        if (it == entries_.end() || it->second.callback != callback) {
+            return;
+        }
+        if (it->second.generation == generation) {
+            it->second.decisions.swap(decisions);
+            return;
+        }
+        generation = it->second.generation;
+    }
+}
+
+bool TelephonyStateRegistryPermissionCache::Verify(int32_t tokenId, const std::string &permission)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(tokenId);
+        if (it != entries_.end() && it->second.callback != nullptr) {
+            auto decision = it->second.decisions.find(permission);
+            if (decision != it->second.decisions.end()) {
+                hits_++;
+                return decision->second;
+            }
+        }
+    }
+    misses_++;
+    return VerifyAccessToken(tokenId, permission);
+}
+
+void TelephonyStateRegistryPermissionCache::OnPermissionChanged(int32_t tokenId, const std::string &permission)
+{
+    bool granted = VerifyAccessToken(tokenId, permission);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(tokenId);
+    if (it == entries_.end() || it->second.callback == nullptr) {
+        return;
+    }
+    it->second.generation++;
+    changes_++;
+    auto decision = it->second.decisions.find(permission);
+    if (decision != it->second.decisions.end()) {
+        decision->second = granted;
+    }
+}
+
+TelephonyStateRegistryPermissionCache::Stats TelephonyStateRegistryPermissionCache::GetStats() const
+{
+    Stats stats;
+    stats.hits = hits_.load();
+    stats.misses = misses_.load();
+    stats.changes = changes_.load();
+    return stats;
+}
+
+bool TelephonyStateRegistryPermissionCache::VerifyAccessToken(int32_t tokenId, const std::string &permission)
+{
+    return AccessTokenKit::VerifyAccessToken(static_cast<AccessTokenID>(tokenId), permission) != PERMISSION_DENIED;
+}
+} // namespace Telephony
+} // namespace OHOS
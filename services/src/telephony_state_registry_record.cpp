@@ -23,7 +23,7 @@
 namespace OHOS {
 namespace Telephony {
 using namespace OHOS::Security::AccessToken;
-bool TelephonyStateRegistryRecord::IsCanReadCallHistory()
+bool TelephonyStateRegistryRecord::IsCanReadCallHistory() const
 {
     if (AccessTokenKit::VerifyAccessToken(tokenId_, Permission::READ_CALL_LOG) == PERMISSION_DENIED) {
         return false;
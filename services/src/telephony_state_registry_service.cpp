@@ -15,7 +15,10 @@
 
 #include "telephony_state_registry_service.h"
 
+#include <algorithm>
+#include <set>
 #include <sstream>
+#include <sys/mman.h>
 #include <thread>
 
 #include "common_event_manager.h"
@@ -25,6 +28,7 @@
 #include "string_ex.h"
 #include "system_ability.h"
 #include "system_ability_definition.h"
+#include "telephony_observer_proxy.h"
 #include "telephony_permission.h"
 #include "telephony_state_manager.h"
 #include "telephony_state_registry_dump_helper.h"
@@ -36,7 +40,55 @@ namespace Telephony {
 using namespace OHOS::EventFwk;
 bool g_registerResult =
     SystemAbility::MakeAndRegisterAbility(DelayedSingleton<TelephonyStateRegistryService>::GetInstance().get());
-constexpr int32_t SIM_SLOT_ID_FOR_DEFAULT_CONN_EVENT = 999;
+constexpr int32_t SIM_SLOT_ID_FOR_DEFAULT_CONN_EVENT = TelephonyStateRegistrySubscriberIndex::DEFAULT_CONN_SLOT_ID;
+constexpr uint32_t CALL_STATE_MASKS = TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE |
+    TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX | TelephonyObserverBroker::OBSERVER_MASK_CCALL_STATE;
+// State-like events, an observer which has not received the previous value only needs the latest one.
+constexpr uint32_t COALESCED_EVENT_MASKS = TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS |
+    TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO | TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE |
+    TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+constexpr uint32_t DELIVERY_THREAD_COUNT = 2;
+// Deliveries in a row finding the observer dead before its records are evicted.
+constexpr uint32_t DEAD_OBJECT_EVICT_THRESHOLD = 3;
+// 100 ms ticks, one round of the wheel covers 6.4 s.
+constexpr uint32_t THROTTLE_TIMER_TICK_MS = 100;
+constexpr uint32_t THROTTLE_TIMER_SLOT_COUNT = 64;
+
+namespace {
+// Batch request handled by the current IPC thread, see RunBatchUpdate.
+struct BatchUpdateContext {
+    std::map<std::string, bool> permissions;
+    std::vector<std::pair<int32_t, TelephonyStateRegistryDispatcher::Job>> jobs;
+};
+thread_local BatchUpdateContext *g_batchUpdateContext = nullptr;
+// Version of the state the last update of the calling thread committed or matched, 0 when unknown.
+thread_local uint64_t g_handledVersion = 0;
+
+// Observer mask gating each scalar field of a snapshot, in the order of SlotStateField.
+constexpr uint32_t SNAPSHOT_FIELD_MASKS[] = {
+    TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE,
+    TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE,
+    TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE,
+    TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE,
+    TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE,
+    TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE,
+    TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW,
+    TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR,
+    TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR,
+    TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE,
+};
+static_assert(sizeof(SNAPSHOT_FIELD_MASKS) / sizeof(SNAPSHOT_FIELD_MASKS[0]) ==
+    static_cast<size_t>(SlotStateField::FIELD_COUNT), "SNAPSHOT_FIELD_MASKS must cover every slot field");
+static_assert(static_cast<uint32_t>(TelephonyStateSnapshot::Field::SIM_ACTIVE_STATE) ==
+    static_cast<uint32_t>(SlotStateField::SIM_ACTIVE_STATE), "TelephonyStateSnapshot::Field mirrors SlotStateField");
+
+// A per record hook only runs when the library does not export its batch variant.
+template<typename Hook, typename BatchHook>
+bool HasPerRecordExtHook(Hook hook, BatchHook batchHook)
+{
+    return hook != nullptr && batchHook == nullptr;
+}
+} // namespace
 
 TelephonyStateRegistryService::TelephonyStateRegistryService()
     : SystemAbility(TELEPHONY_STATE_REGISTRY_SYS_ABILITY_ID, true)
@@ -50,26 +102,55 @@ TelephonyStateRegistryService::TelephonyStateRegistryService()
     }
 #endif
     TELEPHONY_LOGI("TelephonyStateRegistryService SystemAbility create, slotSize_: %{public}d", slotSize_);
-    std::unique_lock<std::shared_mutex> lock(lock_);
+    slotStates_ = std::make_unique<TelephonyStateRegistrySlotTable>(slotSize_);
+    permissionCache_ = std::make_unique<TelephonyStateRegistryPermissionCache>();
+    eventPublisher_ = std::make_unique<TelephonyStateRegistryEventPublisher>();
+    metrics_ = std::make_unique<TelephonyStateRegistryMetrics>();
+    int32_t unknownCallState = static_cast<int32_t>(CallStatus::CALL_STATUS_UNKNOWN);
     for (int32_t i = 0; i < slotSize_; i++) {
-        callState_[i] = static_cast<int32_t>(CallStatus::CALL_STATUS_UNKNOWN);
+        slotStates_->Write(i, { { SlotStateField::CALL_STATE, unknownCallState } });
     }
 
     // slotSize_ == 0 means wifionly product.
     if (slotSize_ == 0) {
-        callState_[0] = static_cast<int32_t>(CallStatus::CALL_STATUS_UNKNOWN);
-    }
-    callState_[-1] = static_cast<int32_t>(CallStatus::CALL_STATUS_UNKNOWN);
+        slotStates_->Write(0, { { SlotStateField::CALL_STATE, unknownCallState } });
+    }
+    slotStates_->Write(-1, { { SlotStateField::CALL_STATE, unknownCallState } });
+    changeFilter_ = std::make_unique<TelephonyStateRegistryChangeFilter>(slotSize_);
+    // One worker for slot -1 and one for each slot, a slow observer of one slot does not delay the others.
+    dispatcher_ = std::make_unique<TelephonyStateRegistryDispatcher>(static_cast<uint32_t>(slotSize_ + 1));
+    deliveryPool_ = std::make_unique<TelephonyStateRegistryDeliveryPool>(DELIVERY_THREAD_COUNT);
+    timerWheel_ = std::make_unique<TelephonyStateRegistryTimerWheel>(THROTTLE_TIMER_TICK_MS, THROTTLE_TIMER_SLOT_COUNT);
+    deathRecipient_ = std::make_unique<ObserverDeathRecipient>(*this).release();
+    eventRingDeathRecipient_ = std::make_unique<EventRingDeathRecipient>(*this).release();
 }
 
 TelephonyStateRegistryService::~TelephonyStateRegistryService()
 {
+    dispatcher_->Stop();
+    timerWheel_->Stop();
+    deliveryPool_->Stop();
+    eventPublisher_->Stop();
     std::unique_lock<std::shared_mutex> lock(lock_);
+    for (const auto &record : stateRecords_) {
+        if (record.telephonyObserver_ != nullptr && record.telephonyObserver_->AsObject() != nullptr) {
+            record.telephonyObserver_->AsObject()->RemoveDeathRecipient(deathRecipient_);
+        }
+    }
     stateRecords_.clear();
-    callState_.clear();
-    callIncomingNumber_.clear();
-    signalInfos_.clear();
-    searchNetworkState_.clear();
+    InvalidateSubscribers();
+    lock.unlock();
+    {
+        std::lock_guard<std::mutex> ringLock(eventRingMutex_);
+        for (const auto &[key, entry] : eventRings_) {
+            for (const auto &[object, client] : entry.clients) {
+                client->RemoveDeathRecipient(eventRingDeathRecipient_);
+            }
+        }
+        eventRings_.clear();
+    }
+    // The throttles of the records are closed once no snapshot holds them.
+    PublishSubscribers();
 }
 
 void TelephonyStateRegistryService::OnStart()
@@ -120,7 +201,6 @@ void TelephonyStateRegistryService::Finalize()
 
 void TelephonyStateRegistryService::OnDump() {}
 
-__attribute__((no_sanitize("cfi")))
 int32_t TelephonyStateRegistryService::UpdateCellularDataConnectState(
     int32_t slotId, int32_t dataState, int32_t networkType)
 {
@@ -128,34 +208,65 @@ int32_t TelephonyStateRegistryService::UpdateCellularDataConnectState(
         TELEPHONY_LOGE("UpdateCellularDataConnectState##VerifySlotId failed ##slotId = %{public}d", slotId);
         return TELEPHONY_STATE_REGISTRY_SLODID_ERROR;
     }
-    if (!TelephonyPermission::CheckPermission(Permission::SET_TELEPHONY_STATE)) {
+    if (!CheckUpdatePermission(Permission::SET_TELEPHONY_STATE)) {
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    cellularDataConnectionState_[slotId] = dataState;
-    cellularDataConnectionNetworkType_[slotId] = networkType;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        // 999 means observe all slot
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE) &&
-            (record.slotId_ == slotId || record.slotId_ == SIM_SLOT_ID_FOR_DEFAULT_CONN_EVENT) &&
-            record.telephonyObserver_ != nullptr) {
-            if (TELEPHONY_EXT_WRAPPER.onCellularDataConnectStateUpdated_ != nullptr) {
-                int32_t networkTypeExt = networkType;
-                TELEPHONY_EXT_WRAPPER.onCellularDataConnectStateUpdated_(slotId, record, networkTypeExt);
-                record.telephonyObserver_->OnCellularDataConnectStateUpdated(slotId, dataState, networkTypeExt);
-            } else {
-                record.telephonyObserver_->OnCellularDataConnectStateUpdated(slotId, dataState, networkType);
-            }
-            result = TELEPHONY_SUCCESS;
+    bool unchanged = SuppressUnchangedUpdate(TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE, slotId,
+        [this, slotId, dataState, networkType]() {
+            SlotStateValues values;
+            return slotStates_->Read(slotId, values) && values.IsValid(SlotStateField::DATA_CONNECTION_STATE) &&
+                values.Get(SlotStateField::DATA_CONNECTION_STATE) == dataState &&
+                values.IsValid(SlotStateField::DATA_CONNECTION_NETWORK_TYPE) &&
+                values.Get(SlotStateField::DATA_CONNECTION_NETWORK_TYPE) == networkType;
+        });
+    uint64_t sequence = 0;
+    if (!unchanged) {
+        sequence = slotStates_->Write(slotId, { { SlotStateField::DATA_CONNECTION_STATE, dataState },
+            { SlotStateField::DATA_CONNECTION_NETWORK_TYPE, networkType } });
+        EndCommit(TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE, slotId, sequence);
+    }
+    // 999 means observe all slot
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(
+        subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE,
+            { slotId, SIM_SLOT_ID_FOR_DEFAULT_CONN_EVENT }),
+        *subscribers, positions);
+    if (unchanged) {
+        return result;
+    }
+    DispatchUpdate(slotId, [this, subscribers, positions, slotId, sequence, dataState, networkType]() {
+        auto deliverGroup = [this, &subscribers, slotId, sequence, dataState](
+            const std::vector<uint32_t> &group, int32_t type, bool, const FanOutPtr &fanOut) {
+            Deliver(subscribers, group, TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE, slotId, sequence,
+                [this, slotId, dataState, type](const TelephonyStateRegistryRecord &record) {
+                    NotifyCellularDataConnectState(record, slotId, dataState, type);
+                }, nullptr, fanOut);
+        };
+        ForEachExtVariant(TELEPHONY_EXT_WRAPPER.onCellularDataConnectStateUpdatedBatch_,
+            TelephonyExtWrapper::Hook::CELLULAR_DATA_CONNECT_STATE_UPDATE, *subscribers, positions,
+            TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE, slotId, networkType, deliverGroup);
+        SendCellularDataConnectStateChanged(slotId, dataState, networkType);
+    });
+    return result;
+}
+
+__attribute__((no_sanitize("cfi")))
+void TelephonyStateRegistryService::NotifyCellularDataConnectState(
+    const TelephonyStateRegistryRecord &record, int32_t slotId, int32_t dataState, int32_t networkType)
+{
+    if (TELEPHONY_EXT_WRAPPER.onCellularDataConnectStateUpdated_ != nullptr &&
+        TELEPHONY_EXT_WRAPPER.onCellularDataConnectStateUpdatedBatch_ == nullptr) {
+        int32_t networkTypeExt = networkType;
+        {
+            TelephonyExtWrapper::HookTimer timer(TelephonyExtWrapper::Hook::CELLULAR_DATA_CONNECT_STATE_UPDATE);
+            TELEPHONY_EXT_WRAPPER.onCellularDataConnectStateUpdated_(slotId, record, networkTypeExt);
         }
+        record.telephonyObserver_->OnCellularDataConnectStateUpdated(slotId, dataState, networkTypeExt);
+    } else {
+        record.telephonyObserver_->OnCellularDataConnectStateUpdated(slotId, dataState, networkType);
     }
-    SendCellularDataConnectStateChanged(slotId, dataState, networkType);
-    return result;
 }
 
 int32_t TelephonyStateRegistryService::UpdateCellularDataFlow(int32_t slotId, int32_t flowData)
@@ -164,24 +275,32 @@ int32_t TelephonyStateRegistryService::UpdateCellularDataFlow(int32_t slotId, in
         TELEPHONY_LOGE("UpdateCellularDataFlow##VerifySlotId failed ##slotId = %{public}d", slotId);
         return TELEPHONY_STATE_REGISTRY_SLODID_ERROR;
     }
-    if (!TelephonyPermission::CheckPermission(Permission::SET_TELEPHONY_STATE)) {
+    if (!CheckUpdatePermission(Permission::SET_TELEPHONY_STATE)) {
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    cellularDataFlow_[slotId] = flowData;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        // 999 means observe all slot
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW) &&
-            (record.slotId_ == slotId || record.slotId_ == SIM_SLOT_ID_FOR_DEFAULT_CONN_EVENT) &&
-            record.telephonyObserver_ != nullptr) {
-            record.telephonyObserver_->OnCellularDataFlowUpdated(slotId, flowData);
-            result = TELEPHONY_SUCCESS;
-        }
+    bool unchanged = SuppressUnchangedUpdate(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW, slotId,
+        [this, slotId, flowData]() {
+            int32_t current = 0;
+            return slotStates_->Read(slotId, SlotStateField::DATA_FLOW, current) && current == flowData;
+        });
+    uint64_t sequence = 0;
+    if (!unchanged) {
+        sequence = slotStates_->Write(slotId, { { SlotStateField::DATA_FLOW, flowData } });
+        EndCommit(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW, slotId, sequence);
+    }
+    // 999 means observe all slot
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW,
+        { slotId, SIM_SLOT_ID_FOR_DEFAULT_CONN_EVENT }), *subscribers, positions);
+    if (!unchanged && !positions.empty()) {
+        DispatchUpdate(slotId, [this, subscribers, positions, slotId, sequence, flowData]() {
+            Deliver(subscribers, positions, TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW, slotId, sequence,
+                [slotId, flowData](const TelephonyStateRegistryRecord &record) {
+                    record.telephonyObserver_->OnCellularDataFlowUpdated(slotId, flowData);
+                });
+        });
     }
     return result;
 }
@@ -192,40 +311,8 @@ int32_t TelephonyStateRegistryService::UpdateCallState(int32_t callState, const
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
     // -1 means observe all slot
-    callState_[-1] = callState;
-    callIncomingNumber_[-1] = number;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE) &&
-            (record.slotId_ == -1) && record.telephonyObserver_ != nullptr) {
-            std::u16string phoneNumber;
-            if (record.IsCanReadCallHistory()) {
-                phoneNumber = number;
-            } else {
-                phoneNumber = Str8ToStr16("");
-            }
-            record.telephonyObserver_->OnCallStateUpdated(record.slotId_, callState, phoneNumber);
-            result = TELEPHONY_SUCCESS;
-        } else if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX) &&
-            (record.slotId_ == -1) && record.telephonyObserver_ != nullptr) {
-            record.telephonyObserver_->OnCallStateUpdatedEx(record.slotId_, callState);
-            result = TELEPHONY_SUCCESS;
-        } else if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CCALL_STATE) &&
-            (record.slotId_ == -1) && record.telephonyObserver_ != nullptr) {
-            if (record.CanManageCallForDevices()) {
-                record.telephonyObserver_->OnCCallStateUpdated(record.slotId_, callState, number);
-                result = TELEPHONY_SUCCESS;
-            }
-        }
-    }
-    SendCallStateChanged(-1, callState);
-    SendCallStateChangedAsUserMultiplePermission(-1, callState, number);
-    return result;
+    return CommitCallState(-1, callState, number);
 }
 
 int32_t TelephonyStateRegistryService::UpdateCallStateForSlotId(
@@ -239,36 +326,56 @@ int32_t TelephonyStateRegistryService::UpdateCallStateForSlotId(
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    callState_[slotId] = callState;
-    callIncomingNumber_[slotId] = number;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE) &&
-            (record.slotId_ == slotId) && record.telephonyObserver_ != nullptr) {
-            std::u16string phoneNumber = GetCallIncomingNumberForSlotId(record, slotId);
-            record.telephonyObserver_->OnCallStateUpdated(slotId, callState, phoneNumber);
-            result = TELEPHONY_SUCCESS;
-        } else if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX) &&
-            (record.slotId_ == slotId) && record.telephonyObserver_ != nullptr) {
-            record.telephonyObserver_->OnCallStateUpdatedEx(slotId, callState);
-            result = TELEPHONY_SUCCESS;
-        } else if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CCALL_STATE) &&
-            (record.slotId_ == slotId) && record.telephonyObserver_ != nullptr) {
-            if (record.CanManageCallForDevices()) {
-                record.telephonyObserver_->OnCCallStateUpdated(record.slotId_, callState, number);
-                result = TELEPHONY_SUCCESS;
-            }
+    return CommitCallState(slotId, callState, number);
+}
+
+int32_t TelephonyStateRegistryService::CommitCallState(int32_t slotId, int32_t callState, const std::u16string &number)
+{
+    slotStates_->SetCallIncomingNumber(slotId, number);
+    uint64_t sequence = slotStates_->Write(slotId, { { SlotStateField::CALL_STATE, callState } });
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    uint32_t position = 0;
+    auto cursor = subscribers->index.Find(CALL_STATE_MASKS, { slotId });
+    while (cursor.Next(position)) {
+        const TelephonyStateRegistryRecord &record = subscribers->records[position];
+        // Collaborative call state observers are only notified while they may still manage calls.
+        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE) ||
+            record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX) ||
+            (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CCALL_STATE) &&
+            permissionCache_->Verify(record.tokenId_, Permission::MANAGE_CALL_FOR_DEVICES))) {
+            positions.push_back(position);
         }
     }
-    SendCallStateChanged(slotId, callState);
-    SendCallStateChangedAsUserMultiplePermission(slotId, callState, number);
+    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
+    if (!positions.empty()) {
+        result = TELEPHONY_SUCCESS;
+    }
+    dispatcher_->Dispatch(slotId, [this, subscribers, positions, slotId, sequence, callState, number]() {
+        Deliver(subscribers, positions, TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE, slotId, sequence,
+            [this, slotId, callState, number](const TelephonyStateRegistryRecord &record) {
+                NotifyCallState(record, slotId, callState, number);
+            });
+        SendCallStateChanged(slotId, callState);
+        SendCallStateChangedAsUserMultiplePermission(slotId, callState, number);
+    });
     return result;
 }
 
+void TelephonyStateRegistryService::NotifyCallState(
+    const TelephonyStateRegistryRecord &record, int32_t slotId, int32_t callState, const std::u16string &number)
+{
+    if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE)) {
+        bool canReadCallLog = permissionCache_->Verify(record.tokenId_, Permission::READ_CALL_LOG);
+        std::u16string phoneNumber = canReadCallLog ? number : Str8ToStr16("");
+        record.telephonyObserver_->OnCallStateUpdated(slotId, callState, phoneNumber);
+    } else if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX)) {
+        record.telephonyObserver_->OnCallStateUpdatedEx(slotId, callState);
+    } else {
+        record.telephonyObserver_->OnCCallStateUpdated(slotId, callState, number);
+    }
+}
+
 int32_t TelephonyStateRegistryService::UpdateSimState(int32_t slotId, CardType type, SimState state, LockReason reason)
 {
     if (!VerifySlotId(slotId)) {
@@ -279,141 +386,252 @@ int32_t TelephonyStateRegistryService::UpdateSimState(int32_t slotId, CardType t
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    simState_[slotId] = state;
-    simReason_[slotId] = reason;
-    cardType_[slotId] = type;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE) &&
-            (record.slotId_ == slotId) && record.telephonyObserver_ != nullptr) {
-            record.telephonyObserver_->OnSimStateUpdated(slotId, type, state, reason);
-            result = TELEPHONY_SUCCESS;
-        }
-    }
-    SendSimStateChanged(slotId, type, state, reason);
+    uint64_t sequence = slotStates_->Write(slotId, { { SlotStateField::SIM_STATE, static_cast<int32_t>(state) },
+        { SlotStateField::LOCK_REASON, static_cast<int32_t>(reason) },
+        { SlotStateField::CARD_TYPE, static_cast<int32_t>(type) } });
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(
+        subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE, { slotId }), *subscribers, positions);
+    dispatcher_->Dispatch(slotId, [this, subscribers, positions, slotId, sequence, type, state, reason]() {
+        Deliver(subscribers, positions, TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE, slotId, sequence,
+            [slotId, type, state, reason](const TelephonyStateRegistryRecord &record) {
+                record.telephonyObserver_->OnSimStateUpdated(slotId, type, state, reason);
+            });
+        SendSimStateChanged(slotId, type, state, reason);
+    });
     return result;
 }
 
-__attribute__((no_sanitize("cfi")))
 int32_t TelephonyStateRegistryService::UpdateSignalInfo(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec)
 {
     if (!VerifySlotId(slotId)) {
         TELEPHONY_LOGE("UpdateSignalInfo##VerifySlotId failed ##slotId = %{public}d", slotId);
         return TELEPHONY_STATE_REGISTRY_SLODID_ERROR;
     }
-    if (!TelephonyPermission::CheckPermission(Permission::SET_TELEPHONY_STATE)) {
+    if (!CheckUpdatePermission(Permission::SET_TELEPHONY_STATE)) {
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    signalInfos_[slotId] = vec;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS) &&
-            (record.slotId_ == slotId) && record.telephonyObserver_ != nullptr) {
-            if (TELEPHONY_EXT_WRAPPER.onSignalInfoUpdated_ != nullptr) {
-                std::vector<sptr<SignalInformation>> vecExt = vec;
-                TELEPHONY_EXT_WRAPPER.onSignalInfoUpdated_(slotId, record, vecExt, vec);
-                record.telephonyObserver_->OnSignalInfoUpdated(slotId, vecExt);
-            } else {
-                record.telephonyObserver_->OnSignalInfoUpdated(slotId, vec);
-            }
-            result = TELEPHONY_SUCCESS;
+    bool unchanged = SuppressUnchangedUpdate(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, slotId,
+        [this, slotId, &vec]() { return slotStates_->IsSameSignalInfos(slotId, vec); });
+    uint64_t sequence = 0;
+    if (!unchanged) {
+        sequence = slotStates_->SetSignalInfos(slotId, vec);
+        EndCommit(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, slotId, sequence);
+    }
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS,
+        { slotId }), *subscribers, positions);
+    if (unchanged) {
+        return result;
+    }
+    // Shared by the deliveries of every observer.
+    auto signalInfos = std::make_shared<const std::vector<sptr<SignalInformation>>>(vec);
+    auto ring = FindEventRing(slotId, TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS);
+    DispatchUpdate(slotId, [this, subscribers, positions, slotId, sequence, signalInfos, ring]() {
+        TelephonyStateRegistryThrottle::Sample sample = TelephonyStateRegistryThrottle::MakeSample(*signalInfos);
+        bool perRecordHook = HasPerRecordExtHook(TELEPHONY_EXT_WRAPPER.onSignalInfoUpdated_,
+            TELEPHONY_EXT_WRAPPER.onSignalInfoUpdatedBatch_);
+        // Encoded once for the ring and the observers left with the unchanged value.
+        std::shared_ptr<TelephonyStateRegistryPayload> encoded;
+        if (ring != nullptr || !perRecordHook) {
+            encoded = TelephonyStateRegistryPayload::CreateSignalInfo(slotId, *signalInfos);
         }
-    }
-    SendSignalInfoChanged(slotId, vec);
+        if (ring != nullptr && encoded != nullptr) {
+            ring->Write(encoded->GetCode(), sequence, encoded->GetBody());
+        }
+        auto deliverGroup = [this, &subscribers, slotId, sequence, &signalInfos, &sample, perRecordHook, &encoded](
+            const std::vector<uint32_t> &group, const std::vector<sptr<SignalInformation>> &vec, bool variant,
+            const FanOutPtr &fanOut) {
+            auto values = variant ? std::make_shared<const std::vector<sptr<SignalInformation>>>(vec) : signalInfos;
+            std::shared_ptr<TelephonyStateRegistryPayload> payload;
+            if (!perRecordHook) {
+                payload = variant ? TelephonyStateRegistryPayload::CreateSignalInfo(slotId, *values) : encoded;
+            }
+            Deliver(subscribers, group, TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, slotId, sequence,
+                [this, slotId, values, payload](const TelephonyStateRegistryRecord &record) {
+                    NotifySignalInfo(record, slotId, *values, payload);
+                }, &sample, fanOut);
+        };
+        ForEachExtVariant(TELEPHONY_EXT_WRAPPER.onSignalInfoUpdatedBatch_,
+            TelephonyExtWrapper::Hook::SIGNAL_INFO_UPDATE, *subscribers, positions,
+            TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, slotId, *signalInfos, deliverGroup);
+        SendSignalInfoChanged(slotId, *signalInfos);
+    });
     return result;
 }
 
 __attribute__((no_sanitize("cfi")))
+void TelephonyStateRegistryService::NotifySignalInfo(const TelephonyStateRegistryRecord &record, int32_t slotId,
+    const std::vector<sptr<SignalInformation>> &vec, const std::shared_ptr<TelephonyStateRegistryPayload> &payload)
+{
+    if (payload != nullptr && payload->SendTo(record.telephonyObserver_)) {
+        return;
+    }
+    if (HasPerRecordExtHook(TELEPHONY_EXT_WRAPPER.onSignalInfoUpdated_,
+        TELEPHONY_EXT_WRAPPER.onSignalInfoUpdatedBatch_)) {
+        std::vector<sptr<SignalInformation>> vecExt = vec;
+        {
+            TelephonyExtWrapper::HookTimer timer(TelephonyExtWrapper::Hook::SIGNAL_INFO_UPDATE);
+            TELEPHONY_EXT_WRAPPER.onSignalInfoUpdated_(slotId, record, vecExt, vec);
+        }
+        record.telephonyObserver_->OnSignalInfoUpdated(slotId, vecExt);
+    } else {
+        record.telephonyObserver_->OnSignalInfoUpdated(slotId, vec);
+    }
+}
+
 int32_t TelephonyStateRegistryService::UpdateCellInfo(int32_t slotId, const std::vector<sptr<CellInformation>> &vec)
 {
     if (!VerifySlotId(slotId)) {
         TELEPHONY_LOGE("UpdateCellInfo##VerifySlotId failed ##slotId = %{public}d", slotId);
         return TELEPHONY_STATE_REGISTRY_SLODID_ERROR;
     }
-    if (!TelephonyPermission::CheckPermission(Permission::SET_TELEPHONY_STATE) ||
-        !TelephonyPermission::CheckPermission(Permission::CELL_LOCATION)) {
+    if (!CheckUpdatePermission(Permission::SET_TELEPHONY_STATE) ||
+        !CheckUpdatePermission(Permission::CELL_LOCATION)) {
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    cellInfos_[slotId] = vec;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO) && record.slotId_ == slotId) {
-            if (record.telephonyObserver_ == nullptr) {
-                TELEPHONY_LOGE("record.telephonyObserver_ is nullptr");
-                return TELEPHONY_ERR_LOCAL_PTR_NULL;
+    uint64_t sequence = slotStates_->SetCellInfos(slotId, vec);
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO,
+        { slotId }), *subscribers, positions);
+    auto ring = FindEventRing(slotId, TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO);
+    if (!positions.empty() || ring != nullptr) {
+        auto cellInfos = std::make_shared<const std::vector<sptr<CellInformation>>>(vec);
+        DispatchUpdate(slotId, [this, subscribers, positions, slotId, sequence, cellInfos, ring]() {
+            bool perRecordHook = HasPerRecordExtHook(TELEPHONY_EXT_WRAPPER.onCellInfoUpdated_,
+                TELEPHONY_EXT_WRAPPER.onCellInfoUpdatedBatch_);
+            // Encoded once for the ring and the observers left with the unchanged value.
+            std::shared_ptr<TelephonyStateRegistryPayload> encoded;
+            if (ring != nullptr || !perRecordHook) {
+                encoded = TelephonyStateRegistryPayload::CreateCellInfo(slotId, *cellInfos);
             }
-            if (TELEPHONY_EXT_WRAPPER.onCellInfoUpdated_ != nullptr) {
-                std::vector<sptr<CellInformation>> vecExt = vec;
-                TELEPHONY_EXT_WRAPPER.onCellInfoUpdated_(slotId, record, vecExt, vec);
-                record.telephonyObserver_->OnCellInfoUpdated(slotId, vecExt);
-            } else {
-                record.telephonyObserver_->OnCellInfoUpdated(slotId, vec);
+            if (ring != nullptr && encoded != nullptr) {
+                ring->Write(encoded->GetCode(), sequence, encoded->GetBody());
             }
-            result = TELEPHONY_SUCCESS;
-        }
+            if (positions.empty()) {
+                return;
+            }
+            TelephonyStateRegistryThrottle::Sample sample = TelephonyStateRegistryThrottle::MakeSample(*cellInfos);
+            auto deliverGroup = [this, &subscribers, slotId, sequence, &cellInfos, &sample, perRecordHook, &encoded](
+                const std::vector<uint32_t> &group, const std::vector<sptr<CellInformation>> &vec, bool variant,
+                const FanOutPtr &fanOut) {
+                auto values = variant ? std::make_shared<const std::vector<sptr<CellInformation>>>(vec) : cellInfos;
+                std::shared_ptr<TelephonyStateRegistryPayload> payload;
+                if (!perRecordHook) {
+                    payload = variant ? TelephonyStateRegistryPayload::CreateCellInfo(slotId, *values) : encoded;
+                }
+                Deliver(subscribers, group, TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO, slotId, sequence,
+                    [this, slotId, values, payload](const TelephonyStateRegistryRecord &record) {
+                        NotifyCellInfo(record, slotId, *values, payload);
+                    }, &sample, fanOut);
+            };
+            ForEachExtVariant(TELEPHONY_EXT_WRAPPER.onCellInfoUpdatedBatch_,
+                TelephonyExtWrapper::Hook::CELL_INFO_UPDATE, *subscribers, positions,
+                TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO, slotId, *cellInfos, deliverGroup);
+        });
     }
     return result;
 }
 
 __attribute__((no_sanitize("cfi")))
+void TelephonyStateRegistryService::NotifyCellInfo(const TelephonyStateRegistryRecord &record, int32_t slotId,
+    const std::vector<sptr<CellInformation>> &vec, const std::shared_ptr<TelephonyStateRegistryPayload> &payload)
+{
+    if (payload != nullptr && payload->SendTo(record.telephonyObserver_)) {
+        return;
+    }
+    if (HasPerRecordExtHook(TELEPHONY_EXT_WRAPPER.onCellInfoUpdated_,
+        TELEPHONY_EXT_WRAPPER.onCellInfoUpdatedBatch_)) {
+        std::vector<sptr<CellInformation>> vecExt = vec;
+        {
+            TelephonyExtWrapper::HookTimer timer(TelephonyExtWrapper::Hook::CELL_INFO_UPDATE);
+            TELEPHONY_EXT_WRAPPER.onCellInfoUpdated_(slotId, record, vecExt, vec);
+        }
+        record.telephonyObserver_->OnCellInfoUpdated(slotId, vecExt);
+    } else {
+        record.telephonyObserver_->OnCellInfoUpdated(slotId, vec);
+    }
+}
+
 int32_t TelephonyStateRegistryService::UpdateNetworkState(int32_t slotId, const sptr<NetworkState> &networkState)
 {
     if (!VerifySlotId(slotId)) {
         TELEPHONY_LOGE("UpdateNetworkState##VerifySlotId failed ##slotId = %{public}d", slotId);
         return TELEPHONY_STATE_REGISTRY_SLODID_ERROR;
     }
-    if (!TelephonyPermission::CheckPermission(Permission::SET_TELEPHONY_STATE)) {
+    if (!CheckUpdatePermission(Permission::SET_TELEPHONY_STATE)) {
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    searchNetworkState_[slotId] = networkState;
-    if (networkState != nullptr) {
-        sptr<NetworkState> searchNetworkState = sptr<NetworkState>::MakeSptr();
-        if (searchNetworkState != nullptr) {
-            MessageParcel networkData;
-            networkState->Marshalling(networkData);
-            searchNetworkState->ReadFromParcel(networkData);
-            searchNetworkState_[slotId] = searchNetworkState;
+    if (SuppressUnchangedUpdate(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, slotId,
+        [this, slotId, &networkState]() { return slotStates_->IsSameNetworkState(slotId, networkState); })) {
+        auto subscribers = GetSubscribers();
+        std::vector<uint32_t> positions;
+        return MatchSubscribers(subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE,
+            { slotId }), *subscribers, positions);
+    }
+    // The only copy of the update, it is cached then shared by the deliveries and the common event unchanged.
+    sptr<NetworkState> searchNetworkState = CloneNetworkState(networkState);
+    uint64_t sequence = slotStates_->SetNetworkState(slotId, searchNetworkState);
+    EndCommit(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, slotId, sequence);
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE,
+        { slotId }), *subscribers, positions);
+    // The producer owns networkState and may change it once this call returns, the job uses the committed copy.
+    DispatchUpdate(slotId, [this, subscribers, positions, slotId, sequence, searchNetworkState]() {
+        auto deliverGroup = [this, &subscribers, slotId, sequence](const std::vector<uint32_t> &group,
+            const sptr<NetworkState> &state, bool, const FanOutPtr &fanOut) {
+            auto payload = TelephonyStateRegistryPayload::CreateNetworkState(slotId, state);
+            Deliver(subscribers, group, TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, slotId, sequence,
+                [this, slotId, state, payload](const TelephonyStateRegistryRecord &record) {
+                    NotifyNetworkState(record, slotId, state, payload);
+                }, nullptr, fanOut);
+        };
+        ForEachExtVariant(TELEPHONY_EXT_WRAPPER.onNetworkStateUpdatedBatch_,
+            TelephonyExtWrapper::Hook::NETWORK_STATE_UPDATE, *subscribers, positions,
+            TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, slotId, searchNetworkState, deliverGroup);
+        SendNetworkStateChanged(slotId, searchNetworkState);
+    });
+    TELEPHONY_LOGI("TelephonyStateRegistryService::UpdateNetworkState end");
+    return result;
+}
+
+__attribute__((no_sanitize("cfi")))
+void TelephonyStateRegistryService::NotifyNetworkState(const TelephonyStateRegistryRecord &r, int32_t slotId,
+    const sptr<NetworkState> &networkState, const std::shared_ptr<TelephonyStateRegistryPayload> &payload)
+{
+    if (HasPerRecordExtHook(TELEPHONY_EXT_WRAPPER.onNetworkStateUpdated_,
+        TELEPHONY_EXT_WRAPPER.onNetworkStateUpdatedBatch_) && networkState != nullptr) {
+        // The hook edits its own copy, the observer only gets a variant of the state when it changed something.
+        sptr<NetworkState> networkStateExt = CloneNetworkState(networkState);
+        {
+            TelephonyExtWrapper::HookTimer timer(TelephonyExtWrapper::Hook::NETWORK_STATE_UPDATE);
+            TELEPHONY_EXT_WRAPPER.onNetworkStateUpdated_(slotId, r, networkStateExt, networkState);
         }
-    }
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord r = stateRecords_[i];
-        if (r.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE) && (r.slotId_ == slotId) &&
-            r.telephonyObserver_ != nullptr) {
-            if (TELEPHONY_EXT_WRAPPER.onNetworkStateUpdated_ != nullptr) {
-                sptr<NetworkState> networkStateExt = new NetworkState();
-                MessageParcel data;
-                networkState->Marshalling(data);
-                networkStateExt->ReadFromParcel(data);
-                TELEPHONY_EXT_WRAPPER.onNetworkStateUpdated_(slotId, r, networkStateExt, networkState);
-                r.telephonyObserver_->OnNetworkStateUpdated(slotId, networkStateExt);
-            } else {
-                r.telephonyObserver_->OnNetworkStateUpdated(slotId, networkState);
-            }
-            result = TELEPHONY_SUCCESS;
+        if (networkStateExt == nullptr || !(*networkStateExt == *networkState)) {
+            r.telephonyObserver_->OnNetworkStateUpdated(slotId, networkStateExt);
+            return;
         }
     }
-    SendNetworkStateChanged(slotId, networkState);
-    TELEPHONY_LOGI("TelephonyStateRegistryService::UpdateNetworkState end");
-    return result;
+    if (payload != nullptr && payload->SendTo(r.telephonyObserver_)) {
+        return;
+    }
+    r.telephonyObserver_->OnNetworkStateUpdated(slotId, networkState);
+}
+
+sptr<NetworkState> TelephonyStateRegistryService::CloneNetworkState(const sptr<NetworkState> &networkState)
+{
+    if (networkState == nullptr) {
+        return nullptr;
+    }
+    sptr<NetworkState> clone = sptr<NetworkState>::MakeSptr(*networkState);
+    return clone != nullptr ? clone : networkState;
 }
 
 int32_t TelephonyStateRegistryService::UpdateCfuIndicator(int32_t slotId, bool cfuResult)
@@ -426,18 +644,18 @@ int32_t TelephonyStateRegistryService::UpdateCfuIndicator(int32_t slotId, bool c
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    cfuResult_[slotId] = cfuResult;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR) &&
-            (record.slotId_ == slotId) && record.telephonyObserver_ != nullptr) {
-            record.telephonyObserver_->OnCfuIndicatorUpdated(slotId, cfuResult);
-            result = TELEPHONY_SUCCESS;
-        }
+    uint64_t sequence = slotStates_->Write(slotId, { { SlotStateField::CFU_INDICATOR, cfuResult } });
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR,
+        { slotId }), *subscribers, positions);
+    if (!positions.empty()) {
+        dispatcher_->Dispatch(slotId, [this, subscribers, positions, slotId, sequence, cfuResult]() {
+            Deliver(subscribers, positions, TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR, slotId, sequence,
+                [slotId, cfuResult](const TelephonyStateRegistryRecord &record) {
+                    record.telephonyObserver_->OnCfuIndicatorUpdated(slotId, cfuResult);
+                });
+        });
     }
     TELEPHONY_LOGI("TelephonyStateRegistryService::UpdateCfuIndicator end");
     return result;
@@ -449,15 +667,17 @@ int32_t TelephonyStateRegistryService::UpdateIccAccount()
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT) &&
-            (record.telephonyObserver_ != nullptr)) {
-            record.telephonyObserver_->OnIccAccountUpdated();
-            result = TELEPHONY_SUCCESS;
-        }
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT,
+        { TelephonyStateRegistrySubscriberIndex::ANY_SLOT_ID }), *subscribers, positions);
+    if (!positions.empty()) {
+        dispatcher_->Dispatch(-1, [this, subscribers, positions]() {
+            Deliver(subscribers, positions, TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT, -1, 0,
+                [](const TelephonyStateRegistryRecord &record) {
+                    record.telephonyObserver_->OnIccAccountUpdated();
+                });
+        });
     }
     TELEPHONY_LOGI("TelephonyStateRegistryService::UpdateIccAccount end");
     return result;
@@ -473,18 +693,20 @@ int32_t TelephonyStateRegistryService::UpdateVoiceMailMsgIndicator(int32_t slotI
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    voiceMailMsgResult_[slotId] = voiceMailMsgResult;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR) &&
-            (record.slotId_ == slotId) && record.telephonyObserver_ != nullptr) {
-            record.telephonyObserver_->OnVoiceMailMsgIndicatorUpdated(slotId, voiceMailMsgResult);
-            result = TELEPHONY_SUCCESS;
-        }
+    uint64_t sequence =
+        slotStates_->Write(slotId, { { SlotStateField::VOICE_MAIL_MSG_INDICATOR, voiceMailMsgResult } });
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(subscribers->index.Find(
+        TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR, { slotId }), *subscribers, positions);
+    if (!positions.empty()) {
+        dispatcher_->Dispatch(slotId, [this, subscribers, positions, slotId, sequence, voiceMailMsgResult]() {
+            Deliver(subscribers, positions, TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR, slotId,
+                sequence,
+                [slotId, voiceMailMsgResult](const TelephonyStateRegistryRecord &record) {
+                    record.telephonyObserver_->OnVoiceMailMsgIndicatorUpdated(slotId, voiceMailMsgResult);
+                });
+        });
     }
     TELEPHONY_LOGI("TelephonyStateRegistryService::UpdateVoiceMailMsgIndicator end");
     return result;
@@ -500,22 +722,388 @@ int32_t TelephonyStateRegistryService::UpdateSimActiveState(int32_t slotId, bool
         TELEPHONY_LOGE("Check permission failed.");
         return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
     }
-    std::unique_lock<std::shared_mutex> uniLock(lock_);
-    simActiveResult_[slotId] = activeStateResult;
-    uniLock.unlock();
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t result = TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
-    for (size_t i = 0; i < stateRecords_.size(); i++) {
-        TelephonyStateRegistryRecord record = stateRecords_[i];
-        if (record.IsExistStateListener(TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE) &&
-            (record.slotId_ == slotId) && record.telephonyObserver_ != nullptr) {
-            record.telephonyObserver_->OnSimActiveStateUpdated(slotId, activeStateResult);
-            result = TELEPHONY_SUCCESS;
-        }
+    uint64_t sequence = slotStates_->Write(slotId, { { SlotStateField::SIM_ACTIVE_STATE, activeStateResult } });
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    int32_t result = MatchSubscribers(subscribers->index.Find(TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE,
+        { slotId }), *subscribers, positions);
+    if (!positions.empty()) {
+        dispatcher_->Dispatch(slotId, [this, subscribers, positions, slotId, sequence, activeStateResult]() {
+            Deliver(subscribers, positions, TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE, slotId, sequence,
+                [slotId, activeStateResult](const TelephonyStateRegistryRecord &record) {
+                    record.telephonyObserver_->OnSimActiveStateUpdated(slotId, activeStateResult);
+                });
+        });
     }
     return result;
 }
 
+int32_t TelephonyStateRegistryService::MatchSubscribers(TelephonyStateRegistrySubscriberIndex::Cursor cursor,
+    const TelephonyStateRegistrySubscribers &subscribers, std::vector<uint32_t> &positions)
+{
+    uint32_t position = 0;
+    while (cursor.Next(position)) {
+        if (subscribers.records[position].telephonyObserver_ != nullptr) {
+            positions.push_back(position);
+        }
+    }
+    if (positions.empty()) {
+        return TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST;
+    }
+    return TELEPHONY_SUCCESS;
+}
+
+template<typename Value, typename BatchHook, typename Visitor>
+void TelephonyStateRegistryService::ForEachExtVariant(BatchHook hook, TelephonyExtWrapper::Hook hookId,
+    const TelephonyStateRegistrySubscribers &subscribers, const std::vector<uint32_t> &positions, uint32_t event,
+    int32_t slotId, const Value &value, Visitor visitor)
+{
+    // The groups are parts of a single fan-out.
+    auto fanOut = metrics_->BeginFanOut(event, slotId, positions.size());
+    std::vector<Value> variants;
+    std::vector<int32_t> variantIndexes;
+    if (hook != nullptr && !positions.empty()) {
+        std::vector<TelephonyStateRegistryRecord> records;
+        records.reserve(positions.size());
+        for (uint32_t position : positions) {
+            records.push_back(subscribers.records[position]);
+        }
+        TelephonyExtWrapper::HookTimer timer(hookId);
+        hook(slotId, records, value, variants, variantIndexes);
+    }
+    // The last group keeps the unchanged value.
+    std::vector<std::vector<uint32_t>> groups(variants.size() + 1);
+    for (size_t i = 0; i < positions.size(); i++) {
+        int32_t index = i < variantIndexes.size() ? variantIndexes[i] : -1;
+        bool isVariant = index >= 0 && static_cast<size_t>(index) < variants.size();
+        groups[isVariant ? static_cast<size_t>(index) : variants.size()].push_back(positions[i]);
+    }
+    for (size_t i = 0; i < variants.size(); i++) {
+        if (!groups[i].empty()) {
+            visitor(groups[i], variants[i], true, fanOut);
+        }
+    }
+    if (!groups.back().empty()) {
+        visitor(groups.back(), value, false, fanOut);
+    }
+}
+
+void TelephonyStateRegistryService::Deliver(const std::shared_ptr<const TelephonyStateRegistrySubscribers> &subscribers,
+    const std::vector<uint32_t> &positions, uint32_t event, int32_t slotId, uint64_t sequence, const Delivery &delivery,
+    const TelephonyStateRegistryThrottle::Sample *sample, FanOutPtr fanOut)
+{
+    if (fanOut == nullptr) {
+        fanOut = metrics_->BeginFanOut(event, slotId, positions.size());
+    }
+    bool coalesce = (event & COALESCED_EVENT_MASKS) != 0;
+    uint64_t key = TelephonyStateRegistryMailbox::MakeKey(event, slotId);
+    auto sharedDelivery = std::make_shared<const Delivery>(delivery);
+    bool throttled = sample != nullptr && TelephonyStateRegistryThrottle::IsThrottledEvent(event);
+    for (uint32_t position : positions) {
+        const auto &throttle = throttled && position < subscribers->throttles.size() ?
+            subscribers->throttles[position] : nullptr;
+        if (throttle == nullptr) {
+            PostDelivery(subscribers, position, key, coalesce, sequence, sharedDelivery, fanOut);
+            continue;
+        }
+        uint32_t flushDelayMs = 0;
+        auto decision = throttle->Offer(event, *sample,
+            [this, subscribers, position, key, coalesce, sequence, sharedDelivery, fanOut]() {
+                PostDelivery(subscribers, position, key, coalesce, sequence, sharedDelivery, fanOut);
+            }, flushDelayMs);
+        if (decision == TelephonyStateRegistryThrottle::Decision::DELIVER) {
+            PostDelivery(subscribers, position, key, coalesce, sequence, sharedDelivery, fanOut);
+        } else if (flushDelayMs > 0) {
+            ScheduleThrottleFlush(throttle, event, flushDelayMs);
+        }
+    }
+}
+
+void TelephonyStateRegistryService::PostDelivery(
+    const std::shared_ptr<const TelephonyStateRegistrySubscribers> &subscribers, uint32_t position, uint64_t key,
+    bool coalesce, uint64_t sequence, const std::shared_ptr<const Delivery> &delivery, const FanOutPtr &fanOut)
+{
+    const auto &mailbox = subscribers->mailboxes[position];
+    if (mailbox == nullptr) {
+        return;
+    }
+    // The mailbox runs its own deliveries, it outlives them.
+    TelephonyStateRegistryMailbox *target = mailbox.get();
+    bool idle = mailbox->Post(key, coalesce, [this, subscribers, position, sequence, delivery, target, fanOut]() {
+        auto begin = std::chrono::steady_clock::now();
+        {
+            const auto &record = subscribers->records[position];
+            TelephonyObserverProxy::SequenceScope scope(sequence, record.readsSequence_);
+            (*delivery)(record);
+        }
+        auto sendTime = std::chrono::steady_clock::now() - begin;
+        bool dead = CheckObserverAlive(subscribers->records[position], *target);
+        if (fanOut != nullptr) {
+            fanOut->RecordNotification(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(sendTime).count()), dead);
+        }
+    });
+    if (idle) {
+        deliveryPool_->Schedule(mailbox);
+    }
+}
+
+void TelephonyStateRegistryService::ScheduleThrottleFlush(
+    const std::shared_ptr<TelephonyStateRegistryThrottle> &throttle, uint32_t event, uint32_t delayMs)
+{
+    std::weak_ptr<TelephonyStateRegistryThrottle> weakThrottle = throttle;
+    timerWheel_->Schedule(delayMs, [this, weakThrottle, event]() {
+        auto throttle = weakThrottle.lock();
+        if (throttle == nullptr) {
+            return;
+        }
+        uint32_t delayMs = throttle->Flush(event);
+        if (delayMs > 0) {
+            ScheduleThrottleFlush(throttle, event, delayMs);
+        }
+    });
+}
+
+bool TelephonyStateRegistryService::CheckObserverAlive(
+    const TelephonyStateRegistryRecord &record, TelephonyStateRegistryMailbox &mailbox)
+{
+    // The observer interface does not return the SendRequest result, ask the proxy whether its remote died instead.
+    sptr<IRemoteObject> remote = record.telephonyObserver_ != nullptr ? record.telephonyObserver_->AsObject() : nullptr;
+    bool dead = remote != nullptr && remote->IsProxyObject() && remote->IsObjectDead();
+    if (mailbox.RecordDeliveryResult(dead) < DEAD_OBJECT_EVICT_THRESHOLD) {
+        return dead;
+    }
+    TELEPHONY_LOGW("Observer of pid %{public}d keeps failing with dead object, evict it", record.pid_);
+    mailbox.Clear();
+    if (RemoveObserverRecords(remote) > 0) {
+        evictedObserverCount_++;
+    }
+    return dead;
+}
+
+void TelephonyStateRegistryService::OnObserverDied(const wptr<IRemoteObject> &remote)
+{
+    sptr<IRemoteObject> object = remote.promote();
+    if (object == nullptr) {
+        TELEPHONY_LOGE("OnObserverDied remote is nullptr");
+        return;
+    }
+    size_t count = RemoveObserverRecords(object);
+    diedObserverCount_++;
+    TELEPHONY_LOGI("OnObserverDied remove %{public}zu records", count);
+}
+
+size_t TelephonyStateRegistryService::RemoveObserverRecords(const sptr<IRemoteObject> &remote)
+{
+    if (remote == nullptr) {
+        return 0;
+    }
+    std::unique_lock<std::shared_mutex> lock(lock_);
+    size_t size = stateRecords_.size();
+    stateRecords_.erase(std::remove_if(stateRecords_.begin(), stateRecords_.end(),
+        [&remote](const TelephonyStateRegistryRecord &record) {
+            return record.telephonyObserver_ != nullptr && record.telephonyObserver_->AsObject() == remote;
+        }), stateRecords_.end());
+    size_t count = size - stateRecords_.size();
+    if (count == 0) {
+        return 0;
+    }
+    InvalidateSubscribers();
+    remote->RemoveDeathRecipient(deathRecipient_);
+    purgedRecordCount_ += count;
+    return count;
+}
+
+bool TelephonyStateRegistryService::HasObserverRecord(const sptr<IRemoteObject> &remote)
+{
+    // Called with lock_ held.
+    for (const auto &record : stateRecords_) {
+        if (record.telephonyObserver_ != nullptr && record.telephonyObserver_->AsObject() == remote) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TelephonyStateRegistryService::ObserverPurgeStats TelephonyStateRegistryService::GetObserverPurgeStats()
+{
+    ObserverPurgeStats stats;
+    stats.died = diedObserverCount_.load();
+    stats.evicted = evictedObserverCount_.load();
+    stats.purgedRecords = purgedRecordCount_.load();
+    return stats;
+}
+
+bool TelephonyStateRegistryService::SuppressUnchangedUpdate(
+    uint32_t event, int32_t slotId, const std::function<bool()> &isSame)
+{
+    if (changeFilter_->IsEnabled(event)) {
+        // Read before the comparison, a commit racing with it has begun by then and the fingerprint is refused.
+        SlotStateValues values;
+        slotStates_->Read(slotId, values);
+        uint64_t version = GetStateVersion(slotId, values, event);
+        if (isSame()) {
+            changeFilter_->CountSuppressed(event, false);
+            g_handledVersion = version;
+            TELEPHONY_LOGD("[slot%{public}d] update %{public}u unchanged, suppressed", slotId, event);
+            return true;
+        }
+    }
+    // The parcel fingerprint kept for the stub is the one of the previous state.
+    changeFilter_->BeginCommit(event, slotId);
+    return false;
+}
+
+void TelephonyStateRegistryService::EndCommit(uint32_t event, int32_t slotId, uint64_t version)
+{
+    changeFilter_->EndCommit(event, slotId, version);
+    g_handledVersion = version;
+}
+
+bool TelephonyStateRegistryService::IsRepeatedUpdate(uint32_t event, int32_t slotId, uint64_t fingerprint,
+    int32_t &result)
+{
+    g_handledVersion = 0;
+    if (!changeFilter_->IsSameFingerprint(event, slotId, fingerprint)) {
+        return false;
+    }
+    // A caller which could not publish the update must not learn that it matches the published state.
+    if (!CheckUpdatePermission(Permission::SET_TELEPHONY_STATE)) {
+        return false;
+    }
+    changeFilter_->CountSuppressed(event, true);
+    // Replied as the suppression of the decoded update does, whether the event has subscribers.
+    auto subscribers = GetSubscribers();
+    std::vector<uint32_t> positions;
+    result = MatchSubscribers(subscribers->index.Find(event, { slotId }), *subscribers, positions);
+    return true;
+}
+
+void TelephonyStateRegistryService::OnUpdateHandled(uint32_t event, int32_t slotId, uint64_t fingerprint)
+{
+    changeFilter_->SetFingerprint(event, slotId, g_handledVersion, fingerprint);
+}
+
+bool TelephonyStateRegistryService::CheckUpdatePermission(const std::string &permission)
+{
+    if (g_batchUpdateContext == nullptr) {
+        return TelephonyPermission::CheckPermission(permission);
+    }
+    auto it = g_batchUpdateContext->permissions.find(permission);
+    if (it != g_batchUpdateContext->permissions.end()) {
+        return it->second;
+    }
+    bool granted = TelephonyPermission::CheckPermission(permission);
+    g_batchUpdateContext->permissions[permission] = granted;
+    return granted;
+}
+
+void TelephonyStateRegistryService::DispatchUpdate(int32_t slotId, TelephonyStateRegistryDispatcher::Job job)
+{
+    if (g_batchUpdateContext != nullptr) {
+        g_batchUpdateContext->jobs.emplace_back(slotId, std::move(job));
+        return;
+    }
+    dispatcher_->Dispatch(slotId, std::move(job));
+}
+
+int32_t TelephonyStateRegistryService::CheckBatchUpdateEntry(StateNotifyInterfaceCode code, int32_t slotId)
+{
+    if (!VerifySlotId(slotId)) {
+        TELEPHONY_LOGE("CheckBatchUpdateEntry code %{public}u slotId %{public}d invalid", static_cast<uint32_t>(code),
+            slotId);
+        return TELEPHONY_STATE_REGISTRY_SLODID_ERROR;
+    }
+    bool cellLocation = code != StateNotifyInterfaceCode::CELL_INFO ||
+        TelephonyPermission::CheckPermission(Permission::CELL_LOCATION);
+    if (!cellLocation || !TelephonyPermission::CheckPermission(Permission::SET_TELEPHONY_STATE)) {
+        TELEPHONY_LOGE("CheckBatchUpdateEntry code %{public}u permission denied", static_cast<uint32_t>(code));
+        return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
+    }
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyStateRegistryService::RunBatchUpdate(const std::function<void()> &updates)
+{
+    if (g_batchUpdateContext != nullptr) {
+        TELEPHONY_LOGE("RunBatchUpdate nested batch");
+        return TELEPHONY_ERR_FAIL;
+    }
+    if (!TelephonyPermission::CheckPermission(Permission::SET_TELEPHONY_STATE)) {
+        TELEPHONY_LOGE("Check permission failed.");
+        return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
+    }
+    BatchUpdateContext context;
+    context.permissions[Permission::SET_TELEPHONY_STATE] = true;
+    // Checked before the write section, readers never wait for a permission query.
+    context.permissions[Permission::CELL_LOCATION] = TelephonyPermission::CheckPermission(Permission::CELL_LOCATION);
+    {
+        // The other producers wait for the end of the section, snapshots, the state page and the first notification
+        // of an observer see every scalar update of the batch or none of them.
+        TelephonyStateRegistrySlotTable::WriteSection section(*slotStates_);
+        g_batchUpdateContext = &context;
+        updates();
+        g_batchUpdateContext = nullptr;
+    }
+    // One job per slot notifies the updates of the batch in order, an observer gets them queued back to back.
+    std::map<int32_t, std::vector<TelephonyStateRegistryDispatcher::Job>> slotJobs;
+    for (auto &entry : context.jobs) {
+        slotJobs[entry.first].push_back(std::move(entry.second));
+    }
+    for (auto &entry : slotJobs) {
+        auto jobs = std::make_shared<std::vector<TelephonyStateRegistryDispatcher::Job>>(std::move(entry.second));
+        dispatcher_->Dispatch(entry.first, [jobs]() {
+            for (const auto &job : *jobs) {
+                job();
+            }
+        });
+    }
+    batchUpdateCount_++;
+    batchedUpdateCount_ += context.jobs.size();
+    return TELEPHONY_SUCCESS;
+}
+
+TelephonyStateRegistryService::BatchUpdateStats TelephonyStateRegistryService::GetBatchUpdateStats()
+{
+    BatchUpdateStats stats;
+    stats.batches = batchUpdateCount_.load();
+    stats.updates = batchedUpdateCount_.load();
+    return stats;
+}
+
+TelephonyStateRegistryPermissionCache::Stats TelephonyStateRegistryService::GetPermissionCacheStats()
+{
+    return permissionCache_->GetStats();
+}
+
+TelephonyStateRegistryEventPublisher::Stats TelephonyStateRegistryService::GetEventPublisherStats()
+{
+    return eventPublisher_->GetStats();
+}
+
+TelephonyStateRegistryMetrics &TelephonyStateRegistryService::GetMetrics()
+{
+    return *metrics_;
+}
+
+TelephonyStateRegistryService::SuppressedUpdateStats TelephonyStateRegistryService::GetSuppressedUpdateStats()
+{
+    SuppressedUpdateStats stats;
+    stats.signalInfo = changeFilter_->GetSuppressedCount(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS);
+    stats.networkState = changeFilter_->GetSuppressedCount(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE);
+    stats.cellularDataConnectState =
+        changeFilter_->GetSuppressedCount(TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE);
+    stats.cellularDataFlow = changeFilter_->GetSuppressedCount(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW);
+    stats.parcel = changeFilter_->GetParcelSuppressedCount();
+    return stats;
+}
+
+void TelephonyStateRegistryService::FlushNotifications()
+{
+    dispatcher_->Flush();
+    deliveryPool_->Flush();
+}
+
 bool TelephonyStateRegistryService::CheckCallerIsSystemApp(uint32_t mask)
 {
     if ((mask & TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO) != 0) {
@@ -567,6 +1155,11 @@ int32_t TelephonyStateRegistryService::RegisterStateChange(
     }
 
     if (!isExist) {
+        sptr<IRemoteObject> remote = telephonyObserver != nullptr ? telephonyObserver->AsObject() : nullptr;
+        if (remote != nullptr && remote->IsProxyObject() && !HasObserverRecord(remote) &&
+            !remote->AddDeathRecipient(deathRecipient_)) {
+            TELEPHONY_LOGW("RegisterStateChange add death recipient failed");
+        }
         record.pid_ = pid;
         record.uid_ = uid;
         record.slotId_ = slotId;
@@ -576,10 +1169,11 @@ int32_t TelephonyStateRegistryService::RegisterStateChange(
         record.appIdentifier_ = appIdentifier;
         record.telephonyObserver_ = telephonyObserver;
         stateRecords_.push_back(record);
+        InvalidateSubscribers();
     }
     TELEPHONY_LOGI("RegisterStateChange mask %{public}d", record.mask_);
     if (isUpdate) {
-        UpdateData(record);
+        PostInitialState({ record });
     }
     TELEPHONY_LOGD("[slot%{public}d] Register successfully, callback list size is %{public}zu", slotId,
         stateRecords_.size());
@@ -599,7 +1193,13 @@ int32_t TelephonyStateRegistryService::UnregisterStateChange(int32_t slotId, uin
     std::vector<TelephonyStateRegistryRecord>::iterator it;
     for (it = stateRecords_.begin(); it != stateRecords_.end(); ++it) {
         if (it->slotId_ == slotId && it->mask_ == mask && it->tokenId_ == tokenId && it->pid_ == pid) {
+            sptr<IRemoteObject> remote =
+                it->telephonyObserver_ != nullptr ? it->telephonyObserver_->AsObject() : nullptr;
             stateRecords_.erase(it);
+            if (remote != nullptr && remote->IsProxyObject() && !HasObserverRecord(remote)) {
+                remote->RemoveDeathRecipient(deathRecipient_);
+            }
+            InvalidateSubscribers();
             result = TELEPHONY_SUCCESS;
             break;
         }
@@ -609,6 +1209,514 @@ int32_t TelephonyStateRegistryService::UnregisterStateChange(int32_t slotId, uin
     return result;
 }
 
+int32_t TelephonyStateRegistryService::CheckRegistration(uint32_t mask)
+{
+    if (!CheckCallerIsSystemApp(mask)) {
+        return TELEPHONY_ERR_ILLEGAL_USE_OF_SYSTEM_API;
+    }
+    if (!CheckPermission(mask)) {
+        return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
+    }
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyStateRegistryService::RegisterStateChanges(
+    const std::vector<TelephonyObserverRegistration> &registrations, const TelephonyStateRegistryRecord &caller,
+    std::vector<int32_t> &results)
+{
+    results.assign(registrations.size(), TELEPHONY_SUCCESS);
+    for (size_t i = 0; i < registrations.size(); i++) {
+        results[i] = registrations[i].observer == nullptr ? TELEPHONY_ERR_ARGUMENT_INVALID :
+            CheckRegistration(registrations[i].mask);
+    }
+    std::unique_lock<std::shared_mutex> lock(lock_);
+    // One scan for the duplicates of the whole request.
+    std::map<RecordKey, size_t> callerRecords;
+    for (size_t i = 0; i < stateRecords_.size(); i++) {
+        const auto &record = stateRecords_[i];
+        if (record.tokenId_ == caller.tokenId_ && record.pid_ == caller.pid_) {
+            callerRecords[RecordKey(record.slotId_, record.mask_, record.tokenId_, record.pid_)] = i;
+        }
+    }
+    std::map<std::pair<const TelephonyObserverBroker *, uint64_t>, std::vector<TelephonyStateRegistryRecord>>
+        initialStates;
+    size_t size = stateRecords_.size();
+    for (size_t i = 0; i < registrations.size(); i++) {
+        const auto &registration = registrations[i];
+        if (results[i] != TELEPHONY_SUCCESS) {
+            continue;
+        }
+        if ((registration.slotId > MAX_SLOT_COUNT || registration.slotId < -1) &&
+            registration.slotId != SIM_SLOT_ID_FOR_DEFAULT_CONN_EVENT) {
+            results[i] = TELEPHONY_STATE_REGISTRY_SLODID_ERROR;
+            continue;
+        }
+        RecordKey key(registration.slotId, registration.mask, caller.tokenId_, caller.pid_);
+        auto it = callerRecords.find(key);
+        if (it == callerRecords.end()) {
+            sptr<IRemoteObject> remote = registration.observer->AsObject();
+            if (remote != nullptr && remote->IsProxyObject() && !HasObserverRecord(remote) &&
+                !remote->AddDeathRecipient(deathRecipient_)) {
+                TELEPHONY_LOGW("RegisterStateChanges add death recipient failed");
+            }
+            TelephonyStateRegistryRecord record = caller;
+            record.slotId_ = registration.slotId;
+            record.mask_ = registration.mask;
+            record.telephonyObserver_ = registration.observer;
+            record.readsSequence_ = registration.readsSequence;
+            stateRecords_.push_back(record);
+            it = callerRecords.emplace(key, stateRecords_.size() - 1).first;
+        }
+        if (registration.notifyNow) {
+            const auto &record = stateRecords_[it->second];
+            initialStates[{ record.telephonyObserver_.GetRefPtr(), registration.sinceSequence }].push_back(record);
+        }
+    }
+    if (stateRecords_.size() != size) {
+        InvalidateSubscribers();
+    }
+    for (const auto &entry : initialStates) {
+        PostInitialState(entry.second, entry.first.second);
+    }
+    TELEPHONY_LOGI("RegisterStateChanges %{public}zu registrations, %{public}zu added", registrations.size(),
+        stateRecords_.size() - size);
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyStateRegistryService::UnregisterStateChanges(
+    const std::vector<TelephonyObserverRegistration> &registrations, int32_t tokenId, pid_t pid,
+    std::vector<int32_t> &results)
+{
+    results.assign(registrations.size(), TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST);
+    // Every index of a key, a registration repeated in the request removes the same record.
+    std::map<RecordKey, std::vector<size_t>> requested;
+    for (size_t i = 0; i < registrations.size(); i++) {
+        int32_t result = CheckRegistration(registrations[i].mask);
+        if (result != TELEPHONY_SUCCESS) {
+            results[i] = result;
+            continue;
+        }
+        requested[RecordKey(registrations[i].slotId, registrations[i].mask, tokenId, pid)].push_back(i);
+    }
+    std::unique_lock<std::shared_mutex> lock(lock_);
+    size_t count = EraseRecords([&requested, &results](const TelephonyStateRegistryRecord &record) {
+        auto it = requested.find(RecordKey(record.slotId_, record.mask_, record.tokenId_, record.pid_));
+        if (it == requested.end()) {
+            return false;
+        }
+        for (size_t index : it->second) {
+            results[index] = TELEPHONY_SUCCESS;
+        }
+        return true;
+    });
+    TELEPHONY_LOGI("UnregisterStateChanges %{public}zu registrations, %{public}zu removed", registrations.size(),
+        count);
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyStateRegistryService::UnregisterAllStateChanges(int32_t tokenId, pid_t pid)
+{
+    std::unique_lock<std::shared_mutex> lock(lock_);
+    size_t count = EraseRecords([tokenId, pid](const TelephonyStateRegistryRecord &record) {
+        return record.tokenId_ == tokenId && record.pid_ == pid;
+    });
+    TELEPHONY_LOGI("UnregisterAllStateChanges pid %{public}d, %{public}zu removed", pid, count);
+    if (count == 0) {
+        return TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST;
+    }
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyStateRegistryService::GetStateSnapshot(
+    int32_t slotId, int32_t tokenId, std::vector<TelephonyStateSnapshot> &snapshots)
+{
+    int32_t firstSlot = slotId;
+    int32_t lastSlot = slotId;
+    if (slotId == TelephonyStateSnapshot::ALL_SLOTS) {
+        firstSlot = -1;
+        lastSlot = slotSize_ - 1;
+    } else if (!slotStates_->IsValidSlot(slotId)) {
+        TELEPHONY_LOGE("GetStateSnapshot slotId %{public}d invalid", slotId);
+        return TELEPHONY_STATE_REGISTRY_SLODID_ERROR;
+    }
+    // A field the caller can not observe is left out of the snapshot.
+    uint32_t readableFields = GetReadableFields();
+    bool canReadCallLog = (readableFields & (1u << static_cast<uint32_t>(SlotStateField::CALL_STATE))) != 0 &&
+        permissionCache_->Verify(tokenId, Permission::READ_CALL_LOG);
+    // The slots are read again when a batch update was committed in the middle of them.
+    slotStates_->ReadCommitted([&]() { ReadSnapshots(slotId, firstSlot, lastSlot, readableFields, canReadCallLog,
+        snapshots); });
+    TELEPHONY_LOGD("GetStateSnapshot slotId %{public}d, %{public}zu snapshots", slotId, snapshots.size());
+    return TELEPHONY_SUCCESS;
+}
+
+void TelephonyStateRegistryService::ReadSnapshots(int32_t slotId, int32_t firstSlot, int32_t lastSlot,
+    uint32_t readableFields, bool canReadCallLog, std::vector<TelephonyStateSnapshot> &snapshots)
+{
+    snapshots.clear();
+    for (int32_t slot = firstSlot; slot <= lastSlot; slot++) {
+        SlotStateValues values;
+        slotStates_->Read(slot, values);
+        TelephonyStateSnapshot snapshot;
+        snapshot.slotId = slot;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(SlotStateField::FIELD_COUNT); i++) {
+            if ((values.validFields & readableFields & (1u << i)) != 0) {
+                snapshot.Set(static_cast<TelephonyStateSnapshot::Field>(i), values.values[i], values.versions[i]);
+            }
+        }
+        uint64_t numberVersion = slotStates_->GetVersion(slot, SlotStateObject::CALL_INCOMING_NUMBER);
+        if (canReadCallLog && numberVersion != 0) {
+            snapshot.callIncomingNumber = slotStates_->GetCallIncomingNumber(slot);
+            snapshot.Set(TelephonyStateSnapshot::Field::CALL_INCOMING_NUMBER, 0, numberVersion);
+        }
+        if (snapshot.fields != 0 || slotId != TelephonyStateSnapshot::ALL_SLOTS) {
+            snapshots.push_back(std::move(snapshot));
+        }
+    }
+}
+
+uint32_t TelephonyStateRegistryService::GetReadableFields()
+{
+    // The permissions are checked once per mask.
+    std::map<uint32_t, bool> permitted;
+    uint32_t readableFields = 0;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(SlotStateField::FIELD_COUNT); i++) {
+        uint32_t mask = SNAPSHOT_FIELD_MASKS[i];
+        auto it = permitted.find(mask);
+        if (it == permitted.end()) {
+            it = permitted.emplace(mask, CheckRegistration(mask) == TELEPHONY_SUCCESS).first;
+        }
+        if (it->second) {
+            readableFields |= (1u << i);
+        }
+    }
+    return readableFields;
+}
+
+int32_t TelephonyStateRegistryService::GetStatePage(sptr<Ashmem> &ashmem)
+{
+    // One page per set of readable fields, a caller only maps the fields it can observe.
+    uint32_t readableFields = GetReadableFields();
+    if (readableFields == 0) {
+        TELEPHONY_LOGE("GetStatePage no field permitted");
+        return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
+    }
+    std::lock_guard<std::mutex> lock(statePageMutex_);
+    auto &page = statePages_[readableFields];
+    if (page == nullptr) {
+        page = TelephonyStateRegistryStatePage::Create(slotStates_->GetSlotCount(), readableFields);
+        if (page == nullptr) {
+            statePages_.erase(readableFields);
+            return TELEPHONY_ERR_LOCAL_PTR_NULL;
+        }
+        slotStates_->AttachPage(page);
+        TELEPHONY_LOGI("GetStatePage page of %{public}d slots and fields %{public}x created",
+            slotStates_->GetSlotCount(), readableFields);
+    }
+    ashmem = page->GetAshmem();
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyStateRegistryService::GetEventRing(
+    int32_t slotId, uint32_t mask, const sptr<IRemoteObject> &client, sptr<Ashmem> &ashmem)
+{
+    if (!VerifySlotId(slotId)) {
+        TELEPHONY_LOGE("GetEventRing slotId %{public}d invalid", slotId);
+        return TELEPHONY_STATE_REGISTRY_SLODID_ERROR;
+    }
+    if (mask != TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS &&
+        mask != TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO) {
+        TELEPHONY_LOGE("GetEventRing mask %{public}u not supported", mask);
+        return TELEPHONY_ERR_ARGUMENT_INVALID;
+    }
+    if (client == nullptr) {
+        TELEPHONY_LOGE("GetEventRing client is nullptr");
+        return TELEPHONY_ERR_ARGUMENT_INVALID;
+    }
+    int32_t result = CheckRegistration(mask);
+    if (result != TELEPHONY_SUCCESS) {
+        return result;
+    }
+    std::lock_guard<std::mutex> lock(eventRingMutex_);
+    auto &entry = eventRings_[{ slotId, mask }];
+    if (entry.ring == nullptr) {
+        std::string name = "telephony_event_ring_" + std::to_string(slotId) + "_" + std::to_string(mask);
+        size_t size = TelephonyEventRing::GetSize(
+            TelephonyEventRing::DEFAULT_ENTRY_COUNT, TelephonyEventRing::DEFAULT_ENTRY_SIZE);
+        sptr<Ashmem> region = Ashmem::CreateAshmem(name.c_str(), static_cast<int32_t>(size));
+        auto created = TelephonyStateRegistryEventRing::Create(region, slotId, mask);
+        if (created == nullptr || !region->SetProtection(PROT_READ)) {
+            TELEPHONY_LOGE("GetEventRing slot %{public}d mask %{public}u create failed", slotId, mask);
+            eventRings_.erase({ slotId, mask });
+            return TELEPHONY_ERR_LOCAL_PTR_NULL;
+        }
+        entry.ring = created;
+        TELEPHONY_LOGI("GetEventRing slot %{public}d mask %{public}u created", slotId, mask);
+    }
+    // A client in the same process never dies on its own, its ring lives as long as the service.
+    if (entry.clients.emplace(client.GetRefPtr(), client).second && client->IsProxyObject() &&
+        !client->AddDeathRecipient(eventRingDeathRecipient_)) {
+        TELEPHONY_LOGW("GetEventRing add death recipient failed");
+    }
+    ashmem = entry.ring->GetAshmem();
+    return TELEPHONY_SUCCESS;
+}
+
+std::shared_ptr<TelephonyStateRegistryEventRing> TelephonyStateRegistryService::FindEventRing(
+    int32_t slotId, uint32_t mask)
+{
+    std::lock_guard<std::mutex> lock(eventRingMutex_);
+    auto it = eventRings_.find({ slotId, mask });
+    return it != eventRings_.end() ? it->second.ring : nullptr;
+}
+
+void TelephonyStateRegistryService::OnEventRingClientDied(const wptr<IRemoteObject> &remote)
+{
+    sptr<IRemoteObject> object = remote.promote();
+    if (object == nullptr) {
+        TELEPHONY_LOGE("OnEventRingClientDied remote is nullptr");
+        return;
+    }
+    object->RemoveDeathRecipient(eventRingDeathRecipient_);
+    std::lock_guard<std::mutex> lock(eventRingMutex_);
+    for (auto it = eventRings_.begin(); it != eventRings_.end();) {
+        it->second.clients.erase(object.GetRefPtr());
+        if (!it->second.clients.empty()) {
+            ++it;
+            continue;
+        }
+        // The dispatcher jobs still holding the ring finish writing into it, it is unmapped after them.
+        TELEPHONY_LOGI("OnEventRingClientDied slot %{public}d mask %{public}u dropped", it->first.first,
+            it->first.second);
+        it = eventRings_.erase(it);
+    }
+}
+
+size_t TelephonyStateRegistryService::EraseRecords(
+    const std::function<bool(const TelephonyStateRegistryRecord &record)> &matches)
+{
+    // Called with lock_ held exclusively.
+    std::map<IRemoteObject *, sptr<IRemoteObject>> remotes;
+    auto end = std::remove_if(stateRecords_.begin(), stateRecords_.end(),
+        [&matches, &remotes](const TelephonyStateRegistryRecord &record) {
+            if (!matches(record)) {
+                return false;
+            }
+            sptr<IRemoteObject> remote =
+                record.telephonyObserver_ != nullptr ? record.telephonyObserver_->AsObject() : nullptr;
+            if (remote != nullptr && remote->IsProxyObject()) {
+                remotes[remote.GetRefPtr()] = remote;
+            }
+            return true;
+        });
+    size_t count = static_cast<size_t>(std::distance(end, stateRecords_.end()));
+    if (count == 0) {
+        return 0;
+    }
+    stateRecords_.erase(end, stateRecords_.end());
+    for (const auto &entry : remotes) {
+        if (!HasObserverRecord(entry.second)) {
+            entry.second->RemoveDeathRecipient(deathRecipient_);
+        }
+    }
+    InvalidateSubscribers();
+    return count;
+}
+
+int32_t TelephonyStateRegistryService::SetDeliveryPolicy(int32_t slotId, uint32_t mask, int32_t tokenId, pid_t pid,
+    const TelephonyObserverDeliveryPolicy &policy)
+{
+    std::unique_lock<std::shared_mutex> lock(lock_);
+    auto recordIt = std::find_if(stateRecords_.begin(), stateRecords_.end(),
+        [slotId, mask, tokenId, pid](const TelephonyStateRegistryRecord &record) {
+            return record.slotId_ == slotId && record.mask_ == mask && record.tokenId_ == tokenId &&
+                record.pid_ == pid;
+        });
+    if (recordIt == stateRecords_.end()) {
+        TELEPHONY_LOGE("SetDeliveryPolicy record not exist, slotId %{public}d mask %{public}u", slotId, mask);
+        return TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST;
+    }
+    RecordKey key(slotId, mask, tokenId, pid);
+    auto it = throttles_.find(key);
+    if (it != throttles_.end()) {
+        it->second->Close();
+        throttles_.erase(it);
+    }
+    if (!policy.IsDefault()) {
+        throttles_[key] = std::make_shared<TelephonyStateRegistryThrottle>(policy);
+    }
+    InvalidateSubscribers();
+    TELEPHONY_LOGI("SetDeliveryPolicy slotId %{public}d mask %{public}u minInterval %{public}d delta %{public}d "
+        "levelOnly %{public}d", slotId, mask, policy.minIntervalMs, policy.signalDeltaDbm, policy.levelChangeOnly);
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyStateRegistryService::ModifyObserverMask(int32_t slotId, uint32_t mask, uint32_t addMask,
+    uint32_t removeMask, bool notifyNow, int32_t tokenId, pid_t pid)
+{
+    if ((addMask & removeMask) != 0) {
+        TELEPHONY_LOGE("ModifyObserverMask add %{public}u and remove %{public}u overlap", addMask, removeMask);
+        return TELEPHONY_ERR_ARGUMENT_INVALID;
+    }
+    if (!CheckCallerIsSystemApp(addMask)) {
+        return TELEPHONY_ERR_ILLEGAL_USE_OF_SYSTEM_API;
+    }
+    if (!CheckPermission(addMask)) {
+        return TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED;
+    }
+    std::unique_lock<std::shared_mutex> lock(lock_);
+    auto matches = [slotId, tokenId, pid](const TelephonyStateRegistryRecord &record, uint32_t recordMask) {
+        return record.slotId_ == slotId && record.mask_ == recordMask && record.tokenId_ == tokenId &&
+            record.pid_ == pid;
+    };
+    auto recordIt = std::find_if(stateRecords_.begin(), stateRecords_.end(),
+        [&matches, mask](const TelephonyStateRegistryRecord &record) { return matches(record, mask); });
+    if (recordIt == stateRecords_.end()) {
+        TELEPHONY_LOGE("ModifyObserverMask record not exist, slotId %{public}d mask %{public}u", slotId, mask);
+        return TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST;
+    }
+    uint32_t newMask = (mask | addMask) & ~removeMask;
+    if (newMask == mask) {
+        return TELEPHONY_SUCCESS;
+    }
+    sptr<IRemoteObject> remote =
+        recordIt->telephonyObserver_ != nullptr ? recordIt->telephonyObserver_->AsObject() : nullptr;
+    // Only a record of the same observer absorbs this one. The records are looked up by slot, mask and caller, so
+    // the mask can not be taken over from another observer of the caller.
+    auto targetIt = std::find_if(stateRecords_.begin(), stateRecords_.end(),
+        [&matches, newMask](const TelephonyStateRegistryRecord &record) { return matches(record, newMask); });
+    bool merged = targetIt != stateRecords_.end();
+    if (merged && (targetIt->telephonyObserver_ == nullptr || targetIt->telephonyObserver_->AsObject() != remote)) {
+        TELEPHONY_LOGE("ModifyObserverMask slotId %{public}d mask %{public}u held by another observer", slotId,
+            newMask);
+        return TELEPHONY_STATE_REGISTRY_DATA_EXIST;
+    }
+    TelephonyStateRegistryRecord record = *recordIt;
+    if (newMask == 0 || merged) {
+        // Nothing left to observe, or the observer already has a record with the resulting mask.
+        stateRecords_.erase(recordIt);
+    } else {
+        recordIt->mask_ = newMask;
+    }
+    // The delivery policy follows the record to its new mask, the record it is merged into keeps its own.
+    auto throttleIt = throttles_.find(RecordKey(slotId, mask, tokenId, pid));
+    if (throttleIt != throttles_.end()) {
+        if (newMask == 0 || merged) {
+            throttleIt->second->Close();
+        } else {
+            throttles_.emplace(RecordKey(slotId, newMask, tokenId, pid), throttleIt->second);
+        }
+        throttles_.erase(throttleIt);
+    }
+    if (remote != nullptr && remote->IsProxyObject() && !HasObserverRecord(remote)) {
+        remote->RemoveDeathRecipient(deathRecipient_);
+    }
+    InvalidateSubscribers();
+    uint32_t addedMask = newMask & ~mask;
+    if (notifyNow && addedMask != 0) {
+        record.mask_ = addedMask;
+        PostInitialState({ record });
+    }
+    TELEPHONY_LOGI("ModifyObserverMask slotId %{public}d mask %{public}u to %{public}u", slotId, mask, newMask);
+    return TELEPHONY_SUCCESS;
+}
+
+std::shared_ptr<const TelephonyStateRegistrySubscribers> TelephonyStateRegistryService::GetSubscribers()
+{
+    // Called without lock_ held, a snapshot older than the records is replaced before it is used.
+    auto subscribers = std::atomic_load(&subscribers_);
+    if (subscribers->generation == recordsGeneration_.load(std::memory_order_acquire)) {
+        return subscribers;
+    }
+    return PublishSubscribers();
+}
+
+void TelephonyStateRegistryService::InvalidateSubscribers()
+{
+    // Called with lock_ held exclusively. The snapshot is rebuilt by the next reader, the changes made until then
+    // are published at once instead of rebuilding the snapshot for each registration.
+    recordsGeneration_.fetch_add(1, std::memory_order_release);
+}
+
+std::shared_ptr<const TelephonyStateRegistrySubscribers> TelephonyStateRegistryService::PublishSubscribers()
+{
+    // Called without lock_ held, notify paths keep using the snapshot they loaded until they finish.
+    std::lock_guard<std::mutex> publishLock(publishMutex_);
+    std::shared_lock<std::shared_mutex> lock(lock_);
+    uint64_t generation = recordsGeneration_.load(std::memory_order_relaxed);
+    auto current = std::atomic_load(&subscribers_);
+    if (current->generation == generation) {
+        return current;
+    }
+    auto subscribers = std::make_shared<TelephonyStateRegistrySubscribers>();
+    subscribers->generation = generation;
+    subscribers->records = stateRecords_;
+    subscribers->index.Rebuild(subscribers->records);
+    // An observer keeps its mailbox, and what is still queued in it, for as long as it has a record.
+    std::map<const TelephonyObserverBroker *, std::shared_ptr<TelephonyStateRegistryMailbox>> mailboxes;
+    subscribers->mailboxes.reserve(subscribers->records.size());
+    for (const auto &record : subscribers->records) {
+        const TelephonyObserverBroker *observer = record.telephonyObserver_.GetRefPtr();
+        if (observer == nullptr) {
+            subscribers->mailboxes.push_back(nullptr);
+            continue;
+        }
+        auto &mailbox = mailboxes[observer];
+        if (mailbox == nullptr) {
+            auto it = mailboxes_.find(observer);
+            mailbox = it != mailboxes_.end() ? it->second : CreateMailbox();
+        }
+        subscribers->mailboxes.push_back(mailbox);
+    }
+    mailboxes_.swap(mailboxes);
+    // A delivery policy lives as long as the record it was set on.
+    std::map<RecordKey, std::shared_ptr<TelephonyStateRegistryThrottle>> throttles;
+    subscribers->throttles.reserve(subscribers->records.size());
+    for (const auto &record : subscribers->records) {
+        auto it = throttles_.find(RecordKey(record.slotId_, record.mask_, record.tokenId_, record.pid_));
+        if (it == throttles_.end()) {
+            subscribers->throttles.push_back(nullptr);
+            continue;
+        }
+        subscribers->throttles.push_back(it->second);
+        throttles.insert(*it);
+    }
+    for (const auto &entry : throttles_) {
+        if (throttles.find(entry.first) == throttles.end()) {
+            entry.second->Close();
+        }
+    }
+    throttles_.swap(throttles);
+    std::set<int32_t> callStateTokens;
+    for (const auto &record : subscribers->records) {
+        if ((record.mask_ & CALL_STATE_MASKS) != 0) {
+            callStateTokens.insert(record.tokenId_);
+        }
+    }
+    std::shared_ptr<const TelephonyStateRegistrySubscribers> published(subscribers);
+    std::atomic_store(&subscribers_, published);
+    lock.unlock();
+    if (callStateTokens != trackedTokens_) {
+        trackedTokens_ = callStateTokens;
+        // Tracking a token registers a callback and verifies it through access token IPCs, they run on the
+        // dispatcher. The jobs of slot -1 run in order, the last token set queued is the one tracked, and until
+        // then the cache verifies the new tokens on each query.
+        dispatcher_->Dispatch(-1, [this, tokens = std::move(callStateTokens)]() {
+            permissionCache_->SetTrackedTokens(tokens);
+        });
+    }
+    return published;
+}
+
+void TelephonyStateRegistryService::RefreshSubscribers()
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(lock_);
+        InvalidateSubscribers();
+    }
+    PublishSubscribers();
+}
+
 bool TelephonyStateRegistryService::CheckPermission(uint32_t mask)
 {
     if ((mask & TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE) != 0) {
@@ -647,91 +1755,203 @@ bool TelephonyStateRegistryService::VerifySlotId(int slotId)
 }
 
 std::u16string TelephonyStateRegistryService::GetCallIncomingNumberForSlotId(
-    TelephonyStateRegistryRecord record, int32_t slotId)
+    const TelephonyStateRegistryRecord &record, int32_t slotId)
 {
-    if (record.IsCanReadCallHistory()) {
-        return callIncomingNumber_[slotId];
+    if (permissionCache_->Verify(record.tokenId_, Permission::READ_CALL_LOG)) {
+        return slotStates_->GetCallIncomingNumber(slotId);
     } else {
         return Str8ToStr16("");
     }
 }
 
-void TelephonyStateRegistryService::UpdateData(const TelephonyStateRegistryRecord &record)
+std::shared_ptr<TelephonyStateRegistryMailbox> TelephonyStateRegistryService::CreateMailbox()
+{
+    auto mailbox = std::make_shared<TelephonyStateRegistryMailbox>();
+    // The mailbox owns the job, it outlives it.
+    TelephonyStateRegistryMailbox *target = mailbox.get();
+    mailbox->SetResync([this, target]() { ResyncObserver(*target); });
+    return mailbox;
+}
+
+void TelephonyStateRegistryService::ResyncObserver(const TelephonyStateRegistryMailbox &mailbox)
+{
+    // Runs on the delivery pool in place of the deliveries the full mailbox could not hold, the state of every record
+    // of the observer is notified with its sequence number so that the observer can tell what it missed.
+    auto subscribers = GetSubscribers();
+    size_t count = 0;
+    for (size_t i = 0; i < subscribers->records.size() && i < subscribers->mailboxes.size(); i++) {
+        if (subscribers->mailboxes[i].get() == &mailbox) {
+            UpdateData(subscribers->records[i]);
+            count++;
+        }
+    }
+    TELEPHONY_LOGI("ResyncObserver %{public}zu records", count);
+}
+
+void TelephonyStateRegistryService::PostInitialState(
+    const std::vector<TelephonyStateRegistryRecord> &records, uint64_t sinceSequence)
+{
+    // Called with lock_ held, the callbacks run on the delivery pool in order with the updates queued to the observer.
+    if (records.empty()) {
+        return;
+    }
+    // The snapshot holding the records may not be built yet, the mailbox it will share is created here.
+    auto it = mailboxes_.emplace(records.front().telephonyObserver_.GetRefPtr(), nullptr).first;
+    if (it->second == nullptr) {
+        it->second = CreateMailbox();
+    }
+    TelephonyStateRegistryMailbox *target = it->second.get();
+    const TelephonyStateRegistryRecord &front = records.front();
+    bool idle = it->second->Post(TelephonyStateRegistryMailbox::MakeKey(front.mask_, front.slotId_), false,
+        [this, records, target, sinceSequence]() {
+            // The state is read when delivered, never older than an update delivered before it.
+            for (const auto &record : records) {
+                UpdateData(record, sinceSequence);
+            }
+            CheckObserverAlive(records.front(), *target);
+        });
+    if (idle) {
+        deliveryPool_->Schedule(it->second);
+    }
+}
+
+uint64_t TelephonyStateRegistryService::GetStateVersion(int32_t slotId, const SlotStateValues &values, uint32_t event)
+{
+    switch (event) {
+        case TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE:
+        case TelephonyObserverBroker::OBSERVER_MASK_CCALL_STATE:
+            return std::max(values.GetVersion(SlotStateField::CALL_STATE),
+                slotStates_->GetVersion(slotId, SlotStateObject::CALL_INCOMING_NUMBER));
+        case TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX:
+            return values.GetVersion(SlotStateField::CALL_STATE);
+        case TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS:
+            return slotStates_->GetVersion(slotId, SlotStateObject::SIGNAL_INFO);
+        case TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE:
+            return slotStates_->GetVersion(slotId, SlotStateObject::NETWORK_STATE);
+        case TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO:
+            return slotStates_->GetVersion(slotId, SlotStateObject::CELL_INFO);
+        case TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE:
+            return std::max({ values.GetVersion(SlotStateField::SIM_STATE),
+                values.GetVersion(SlotStateField::CARD_TYPE), values.GetVersion(SlotStateField::LOCK_REASON) });
+        case TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE:
+            return std::max(values.GetVersion(SlotStateField::DATA_CONNECTION_STATE),
+                values.GetVersion(SlotStateField::DATA_CONNECTION_NETWORK_TYPE));
+        case TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW:
+            return values.GetVersion(SlotStateField::DATA_FLOW);
+        case TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR:
+            return values.GetVersion(SlotStateField::CFU_INDICATOR);
+        case TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR:
+            return values.GetVersion(SlotStateField::VOICE_MAIL_MSG_INDICATOR);
+        case TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE:
+            return values.GetVersion(SlotStateField::SIM_ACTIVE_STATE);
+        default:
+            // The event has no state, e.g. OBSERVER_MASK_ICC_ACCOUNT.
+            return 0;
+    }
+}
+
+void TelephonyStateRegistryService::NotifyInitialState(const TelephonyStateRegistryRecord &record,
+    const SlotStateValues &values, uint32_t event, uint64_t sinceSequence, const std::function<void()> &notify)
+{
+    if ((record.mask_ & event) == 0) {
+        return;
+    }
+    uint64_t version = GetStateVersion(record.slotId_, values, event);
+    if (sinceSequence != 0 && version <= sinceSequence) {
+        return;
+    }
+    TelephonyObserverProxy::SequenceScope scope(version, record.readsSequence_);
+    notify();
+}
+
+void TelephonyStateRegistryService::UpdateData(const TelephonyStateRegistryRecord &record, uint64_t sinceSequence)
 {
     if (record.telephonyObserver_ == nullptr) {
         TELEPHONY_LOGE("record.telephonyObserver_ is  nullptr");
         return;
     }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE) != 0) {
-        std::u16string phoneNumber = GetCallIncomingNumberForSlotId(record, record.slotId_);
+    // Fields never published for this slot are notified with their default value.
+    SlotStateValues values;
+    slotStates_->Read(record.slotId_, values);
+    const auto &observer = record.telephonyObserver_;
+    int32_t slotId = record.slotId_;
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE, sinceSequence, [&]() {
+        std::u16string phoneNumber = GetCallIncomingNumberForSlotId(record, slotId);
         TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_CALL_STATE");
-        record.telephonyObserver_->OnCallStateUpdated(record.slotId_, callState_[record.slotId_], phoneNumber);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS) != 0) {
+        observer->OnCallStateUpdated(slotId, values.Get(SlotStateField::CALL_STATE), phoneNumber);
+    });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, sinceSequence, [&]() {
         TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_SIGNAL_STRENGTHS");
-        record.telephonyObserver_->OnSignalInfoUpdated(record.slotId_, signalInfos_[record.slotId_]);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE) != 0) {
+        observer->OnSignalInfoUpdated(slotId, slotStates_->GetSignalInfos(slotId));
+    });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, sinceSequence, [&]() {
         TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_NETWORK_STATE");
-        record.telephonyObserver_->OnNetworkStateUpdated(record.slotId_, searchNetworkState_[record.slotId_]);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO) != 0) {
+        observer->OnNetworkStateUpdated(slotId, slotStates_->GetNetworkState(slotId));
+    });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO, sinceSequence, [&]() {
         TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_CELL_INFO");
-        record.telephonyObserver_->OnCellInfoUpdated(record.slotId_, cellInfos_[record.slotId_]);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE) != 0) {
-        record.telephonyObserver_->OnSimStateUpdated(
-            record.slotId_, cardType_[record.slotId_], simState_[record.slotId_], simReason_[record.slotId_]);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE) != 0) {
-        TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_DATA_CONNECTION_STATE");
-        record.telephonyObserver_->OnCellularDataConnectStateUpdated(record.slotId_,
-            cellularDataConnectionState_[record.slotId_], cellularDataConnectionNetworkType_[record.slotId_]);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW) != 0) {
+        observer->OnCellInfoUpdated(slotId, slotStates_->GetCellInfos(slotId));
+    });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE, sinceSequence, [&]() {
+        observer->OnSimStateUpdated(slotId, static_cast<CardType>(values.Get(SlotStateField::CARD_TYPE)),
+            static_cast<SimState>(values.Get(SlotStateField::SIM_STATE)),
+            static_cast<LockReason>(values.Get(SlotStateField::LOCK_REASON)));
+    });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE, sinceSequence,
+        [&]() {
+            TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_DATA_CONNECTION_STATE");
+            observer->OnCellularDataConnectStateUpdated(slotId, values.Get(SlotStateField::DATA_CONNECTION_STATE),
+                values.Get(SlotStateField::DATA_CONNECTION_NETWORK_TYPE));
+        });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW, sinceSequence, [&]() {
         TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_DATA_FLOW");
-        record.telephonyObserver_->OnCellularDataFlowUpdated(record.slotId_, cellularDataFlow_[record.slotId_]);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR) != 0) {
+        observer->OnCellularDataFlowUpdated(slotId, values.Get(SlotStateField::DATA_FLOW));
+    });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR, sinceSequence, [&]() {
         TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_CFU_INDICATOR");
-        record.telephonyObserver_->OnCfuIndicatorUpdated(record.slotId_, cfuResult_[record.slotId_]);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR) != 0) {
-        TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR");
-        record.telephonyObserver_->OnVoiceMailMsgIndicatorUpdated(record.slotId_, voiceMailMsgResult_[record.slotId_]);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT) != 0) {
+        observer->OnCfuIndicatorUpdated(slotId, values.Get(SlotStateField::CFU_INDICATOR) != 0);
+    });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR, sinceSequence,
+        [&]() {
+            TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR");
+            observer->OnVoiceMailMsgIndicatorUpdated(slotId, values.Get(SlotStateField::VOICE_MAIL_MSG_INDICATOR) != 0);
+        });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT, sinceSequence, [&]() {
         TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_ICC_ACCOUNT");
-        record.telephonyObserver_->OnIccAccountUpdated();
-    }
-    UpdateDataEx(record);
+        observer->OnIccAccountUpdated();
+    });
+    UpdateDataEx(record, sinceSequence);
 }
 
-void TelephonyStateRegistryService::UpdateDataEx(const TelephonyStateRegistryRecord &record)
+void TelephonyStateRegistryService::UpdateDataEx(const TelephonyStateRegistryRecord &record, uint64_t sinceSequence)
 {
     if (record.telephonyObserver_ == nullptr) {
         TELEPHONY_LOGE("record.telephonyObserver_ is  nullptr");
         return;
     }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX) != 0) {
+    SlotStateValues values;
+    slotStates_->Read(record.slotId_, values);
+    const auto &observer = record.telephonyObserver_;
+    int32_t slotId = record.slotId_;
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX, sinceSequence, [&]() {
         TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_CALL_STATE_EX");
-        record.telephonyObserver_->OnCallStateUpdatedEx(record.slotId_, callState_[record.slotId_]);
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_CCALL_STATE) != 0) {
-        if (record.CanManageCallForDevices()) {
-            TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_CCALL_STATE");
-            int32_t callState = callState_[record.slotId_];
-            if (callState == static_cast<int32_t>(CallStatus::CALL_STATUS_UNKNOWN)) {
-                callState = static_cast<int32_t>(CallStatus::CALL_STATUS_IDLE);
-            }
-            record.telephonyObserver_->OnCCallStateUpdated(record.slotId_, callState,
-                callIncomingNumber_[record.slotId_]);
+        observer->OnCallStateUpdatedEx(slotId, values.Get(SlotStateField::CALL_STATE));
+    });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_CCALL_STATE, sinceSequence, [&]() {
+        if (!permissionCache_->Verify(record.tokenId_, Permission::MANAGE_CALL_FOR_DEVICES)) {
+            return;
         }
-    }
-    if ((record.mask_ & TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE) != 0) {
+        TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_CCALL_STATE");
+        int32_t callState = values.Get(SlotStateField::CALL_STATE);
+        if (callState == static_cast<int32_t>(CallStatus::CALL_STATUS_UNKNOWN)) {
+            callState = static_cast<int32_t>(CallStatus::CALL_STATUS_IDLE);
+        }
+        observer->OnCCallStateUpdated(slotId, callState, slotStates_->GetCallIncomingNumber(slotId));
+    });
+    NotifyInitialState(record, values, TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE, sinceSequence, [&]() {
         TELEPHONY_LOGI("RegisterStateChange##Notify-OBSERVER_MASK_SIM_ACTIVE_STATE");
-        record.telephonyObserver_->OnSimActiveStateUpdated(record.slotId_, simActiveResult_[record.slotId_]);
-    }
+        observer->OnSimActiveStateUpdated(slotId, values.Get(SlotStateField::SIM_ACTIVE_STATE) != 0);
+    });
 }
 
 bool TelephonyStateRegistryService::PublishCommonEvent(
@@ -755,112 +1975,133 @@ bool TelephonyStateRegistryService::PublishCommonEvent(
 
 void TelephonyStateRegistryService::SendCallStateChanged(int32_t slotId, int32_t state)
 {
-    AAFwk::Want want;
-    want.SetParam("slotId", slotId);
-    want.SetParam("state", state);
-    want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_CALL_STATE_CHANGED);
+    eventPublisher_->Post(TelephonyStateRegistryEventPublisher::Kind::CALL_STATE, slotId, [slotId, state]() {
+        AAFwk::Want want;
+        want.SetParam("slotId", slotId);
+        want.SetParam("state", state);
+        want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_CALL_STATE_CHANGED);
 
-    EventFwk::CommonEventData data;
-    data.SetWant(want);
-    EventFwk::CommonEventPublishInfo publishInfo;
-    publishInfo.SetOrdered(false);
-    std::vector<std::string> callPermissions;
-    callPermissions.emplace_back(Permission::GET_TELEPHONY_STATE);
-    publishInfo.SetSubscriberPermissions(callPermissions);
-    bool publishResult = EventFwk::CommonEventManager::PublishCommonEvent(data, publishInfo, nullptr);
-    if (!publishResult) {
-        TELEPHONY_LOGE("SendCallStateChanged PublishBroadcastEvent result fail");
-    }
+        EventFwk::CommonEventData data;
+        data.SetWant(want);
+        EventFwk::CommonEventPublishInfo publishInfo;
+        publishInfo.SetOrdered(false);
+        std::vector<std::string> callPermissions;
+        callPermissions.emplace_back(Permission::GET_TELEPHONY_STATE);
+        publishInfo.SetSubscriberPermissions(callPermissions);
+        bool publishResult = EventFwk::CommonEventManager::PublishCommonEvent(data, publishInfo, nullptr);
+        if (!publishResult) {
+            TELEPHONY_LOGE("SendCallStateChanged PublishBroadcastEvent result fail");
+        }
+        return publishResult;
+    });
 }
 
 void TelephonyStateRegistryService::SendCallStateChangedAsUserMultiplePermission(
     int32_t slotId, int32_t state, const std::u16string &number)
 {
-    AAFwk::Want want;
-    want.SetParam("slotId", slotId);
-    want.SetParam("state", state);
-    want.SetParam("number", Str16ToStr8(number));
-    want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_CALL_STATE_CHANGED);
+    eventPublisher_->Post(TelephonyStateRegistryEventPublisher::Kind::CALL_STATE_WITH_NUMBER, slotId,
+        [slotId, state, number]() {
+            AAFwk::Want want;
+            want.SetParam("slotId", slotId);
+            want.SetParam("state", state);
+            want.SetParam("number", Str16ToStr8(number));
+            want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_CALL_STATE_CHANGED);
 
-    EventFwk::CommonEventData data;
-    data.SetWant(want);
-    EventFwk::CommonEventPublishInfo publishInfo;
-    publishInfo.SetOrdered(false);
-    std::vector<std::string> callPermissions;
-    callPermissions.emplace_back(Permission::GET_TELEPHONY_STATE);
-    callPermissions.emplace_back(Permission::READ_CALL_LOG);
-    publishInfo.SetSubscriberPermissions(callPermissions);
-    bool publishResult = EventFwk::CommonEventManager::PublishCommonEvent(data, publishInfo, nullptr);
-    if (!publishResult) {
-        TELEPHONY_LOGE("SendCallStateChangedAsUserMultiplePermission PublishBroadcastEvent result fail");
-    }
+            EventFwk::CommonEventData data;
+            data.SetWant(want);
+            EventFwk::CommonEventPublishInfo publishInfo;
+            publishInfo.SetOrdered(false);
+            std::vector<std::string> callPermissions;
+            callPermissions.emplace_back(Permission::GET_TELEPHONY_STATE);
+            callPermissions.emplace_back(Permission::READ_CALL_LOG);
+            publishInfo.SetSubscriberPermissions(callPermissions);
+            bool publishResult = EventFwk::CommonEventManager::PublishCommonEvent(data, publishInfo, nullptr);
+            if (!publishResult) {
+                TELEPHONY_LOGE("SendCallStateChangedAsUserMultiplePermission PublishBroadcastEvent result fail");
+            }
+            return publishResult;
+        });
 }
 
 void TelephonyStateRegistryService::SendCellularDataConnectStateChanged(
     int32_t slotId, int32_t dataState, int32_t networkType)
 {
-    AAFwk::Want want;
-    want.SetParam("slotId", slotId);
-    want.SetParam("dataState", dataState);
-    want.SetParam("networkType", networkType);
-    want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_CELLULAR_DATA_STATE_CHANGED);
-    int32_t eventCode = 1;
-    std::string eventData("connectStateChanged");
-    PublishCommonEvent(want, eventCode, eventData);
+    eventPublisher_->Post(TelephonyStateRegistryEventPublisher::Kind::DATA_CONNECT_STATE, slotId,
+        [this, slotId, dataState, networkType]() {
+            AAFwk::Want want;
+            want.SetParam("slotId", slotId);
+            want.SetParam("dataState", dataState);
+            want.SetParam("networkType", networkType);
+            want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_CELLULAR_DATA_STATE_CHANGED);
+            int32_t eventCode = 1;
+            std::string eventData("connectStateChanged");
+            return PublishCommonEvent(want, eventCode, eventData);
+        });
 }
 
 void TelephonyStateRegistryService::SendSimStateChanged(
     int32_t slotId, CardType type, SimState state, LockReason reason)
 {
-    AAFwk::Want want;
-    want.SetParam("slotId", slotId);
-    want.SetParam("cardType", static_cast<int32_t>(type));
-    want.SetParam("reason", static_cast<int32_t>(reason));
-    want.SetParam("state", static_cast<int32_t>(state));
-    want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_SIM_STATE_CHANGED);
-    int32_t eventCode = 1;
-    std::string eventData("simStateChanged");
-    PublishCommonEvent(want, eventCode, eventData);
+    eventPublisher_->Post(TelephonyStateRegistryEventPublisher::Kind::SIM_STATE, slotId,
+        [this, slotId, type, state, reason]() {
+            AAFwk::Want want;
+            want.SetParam("slotId", slotId);
+            want.SetParam("cardType", static_cast<int32_t>(type));
+            want.SetParam("reason", static_cast<int32_t>(reason));
+            want.SetParam("state", static_cast<int32_t>(state));
+            want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_SIM_STATE_CHANGED);
+            int32_t eventCode = 1;
+            std::string eventData("simStateChanged");
+            return PublishCommonEvent(want, eventCode, eventData);
+        });
 }
 
 __attribute__((no_sanitize("cfi")))
 void TelephonyStateRegistryService::SendSignalInfoChanged(
     int32_t slotId, const std::vector<sptr<SignalInformation>> &vec)
 {
-    AAFwk::Want want;
-    want.SetParam("slotId", slotId);
-    want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_SIGNAL_INFO_CHANGED);
-    std::vector<std::string> contentStr;
     if (TELEPHONY_EXT_WRAPPER.sendSignalInfoChanged_ != nullptr) {
+        TelephonyExtWrapper::HookTimer timer(TelephonyExtWrapper::Hook::SEND_SIGNAL_INFO_CHANGED);
         TELEPHONY_EXT_WRAPPER.sendSignalInfoChanged_(slotId, vec);
     }
-    for (size_t i = 0; i < vec.size(); i++) {
-        sptr<SignalInformation> signal = vec[i];
-        if (signal != nullptr) {
-            contentStr.push_back(signal->ToString());
+    // The signals are committed and not changed any more, they are formatted when the event is published.
+    eventPublisher_->Post(TelephonyStateRegistryEventPublisher::Kind::SIGNAL_INFO, slotId, [this, slotId, vec]() {
+        AAFwk::Want want;
+        want.SetParam("slotId", slotId);
+        want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_SIGNAL_INFO_CHANGED);
+        std::vector<std::string> contentStr;
+        for (size_t i = 0; i < vec.size(); i++) {
+            sptr<SignalInformation> signal = vec[i];
+            if (signal != nullptr) {
+                contentStr.push_back(signal->ToString());
+            }
         }
-    }
-    want.SetParam("signalInfos", contentStr);
-    int32_t eventCode = 1;
-    std::string eventData("signalInfoChanged");
-    PublishCommonEvent(want, eventCode, eventData);
+        want.SetParam("signalInfos", contentStr);
+        int32_t eventCode = 1;
+        std::string eventData("signalInfoChanged");
+        return PublishCommonEvent(want, eventCode, eventData);
+    });
 }
 
 __attribute__((no_sanitize("cfi")))
 void TelephonyStateRegistryService::SendNetworkStateChanged(int32_t slotId, const sptr<NetworkState> &networkState)
 {
-    AAFwk::Want want;
-    want.SetParam("slotId", slotId);
-    want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_NETWORK_STATE_CHANGED);
-    int32_t eventCode = 1;
     if (TELEPHONY_EXT_WRAPPER.sendNetworkStateChanged_ != nullptr) {
+        TelephonyExtWrapper::HookTimer timer(TelephonyExtWrapper::Hook::SEND_NETWORK_STATE_CHANGED);
         TELEPHONY_EXT_WRAPPER.sendNetworkStateChanged_(slotId, networkState);
     }
-    if (networkState != nullptr) {
-        want.SetParam("networkState", networkState->ToString());
-    }
-    std::string eventData("networkStateChanged");
-    PublishCommonEvent(want, eventCode, eventData);
+    eventPublisher_->Post(TelephonyStateRegistryEventPublisher::Kind::NETWORK_STATE, slotId,
+        [this, slotId, networkState]() {
+            AAFwk::Want want;
+            want.SetParam("slotId", slotId);
+            want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_NETWORK_STATE_CHANGED);
+            int32_t eventCode = 1;
+            if (networkState != nullptr) {
+                want.SetParam("networkState", networkState->ToString());
+            }
+            std::string eventData("networkStateChanged");
+            return PublishCommonEvent(want, eventCode, eventData);
+        });
 }
 
 int TelephonyStateRegistryService::Dump(std::int32_t fd, const std::vector<std::u16string> &args)
@@ -876,8 +2117,8 @@ int TelephonyStateRegistryService::Dump(std::int32_t fd, const std::vector<std::
     }
     std::string result;
     TelephonyStateRegistryDumpHelper dumpHelper;
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    if (dumpHelper.Dump(argsInStr, stateRecords_, result)) {
+    auto subscribers = GetSubscribers();
+    if (dumpHelper.Dump(argsInStr, *subscribers, result)) {
         std::int32_t ret = dprintf(fd, "%s", result.c_str());
         if (ret < 0) {
             TELEPHONY_LOGE("dprintf to dump fd failed");
@@ -917,93 +2158,52 @@ int32_t TelephonyStateRegistryService::GetServiceRunningState()
 
 int32_t TelephonyStateRegistryService::GetSimState(int32_t slotId)
 {
-    std::map<int32_t, SimState>::iterator it;
     int32_t result = TELEPHONY_ERROR;
-    for (it = simState_.begin(); it != simState_.end(); ++it) {
-        if (it->first == slotId) {
-            result = static_cast<int32_t>(it->second);
-            TELEPHONY_LOGI("CallState = %{public}d", result);
-            break;
-        }
+    if (slotStates_->Read(slotId, SlotStateField::SIM_STATE, result)) {
+        TELEPHONY_LOGI("CallState = %{public}d", result);
     }
     return result;
 }
 
 int32_t TelephonyStateRegistryService::GetCallState(int32_t slotId)
 {
-    std::map<int32_t, int32_t>::iterator it;
     int32_t result = TELEPHONY_ERROR;
-    for (it = callState_.begin(); it != callState_.end(); ++it) {
-        if (it->first == slotId) {
-            result = it->second;
-            break;
-        }
-    }
+    slotStates_->Read(slotId, SlotStateField::CALL_STATE, result);
     return result;
 }
 
 int32_t TelephonyStateRegistryService::GetCardType(int32_t slotId)
 {
-    std::map<int32_t, CardType>::iterator it;
     int32_t result = TELEPHONY_ERROR;
-    for (it = cardType_.begin(); it != cardType_.end(); ++it) {
-        if (it->first == slotId) {
-            result = static_cast<int32_t>(it->second);
-            break;
-        }
-    }
+    slotStates_->Read(slotId, SlotStateField::CARD_TYPE, result);
     return result;
 }
 
 int32_t TelephonyStateRegistryService::GetCellularDataConnectionState(int32_t slotId)
 {
-    std::map<int32_t, int32_t>::iterator it;
     int32_t result = TELEPHONY_ERROR;
-    for (it = cellularDataConnectionState_.begin(); it != cellularDataConnectionState_.end(); ++it) {
-        if (it->first == slotId) {
-            result = it->second;
-            break;
-        }
-    }
+    slotStates_->Read(slotId, SlotStateField::DATA_CONNECTION_STATE, result);
     return result;
 }
 
 int32_t TelephonyStateRegistryService::GetCellularDataFlow(int32_t slotId)
 {
-    std::map<int32_t, int32_t>::iterator it;
     int32_t result = TELEPHONY_ERROR;
-    for (it = cellularDataFlow_.begin(); it != cellularDataFlow_.end(); ++it) {
-        if (it->first == slotId) {
-            result = it->second;
-            break;
-        }
-    }
+    slotStates_->Read(slotId, SlotStateField::DATA_FLOW, result);
     return result;
 }
 
 int32_t TelephonyStateRegistryService::GetCellularDataConnectionNetworkType(int32_t slotId)
 {
-    std::map<int32_t, int32_t>::iterator it;
     int32_t result = TELEPHONY_ERROR;
-    for (it = cellularDataConnectionNetworkType_.begin(); it != cellularDataConnectionNetworkType_.end(); ++it) {
-        if (it->first == slotId) {
-            result = it->second;
-            break;
-        }
-    }
+    slotStates_->Read(slotId, SlotStateField::DATA_CONNECTION_NETWORK_TYPE, result);
     return result;
 }
 
 int32_t TelephonyStateRegistryService::GetLockReason(int32_t slotId)
 {
-    std::map<int32_t, LockReason>::iterator it;
     int32_t result = TELEPHONY_ERROR;
-    for (it = simReason_.begin(); it != simReason_.end(); ++it) {
-        if (it->first == slotId) {
-            result = static_cast<int32_t>(it->second);
-            break;
-        }
-    }
+    slotStates_->Read(slotId, SlotStateField::LOCK_REASON, result);
     return result;
 }
 
@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_slot_table.h"
+
+#include <thread>
+
+#include "telephony_log_wrapper.h"
+#include "telephony_state_registry_state_page.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr int32_t ALL_SLOT_ID = -1;
+// Table whose write section the calling thread holds, its writes and reads do not wait for the section.
+thread_local const TelephonyStateRegistrySlotTable *g_sectionTable = nullptr;
+} // namespace
+
+TelephonyStateRegistrySlotTable::WriteSection::WriteSection(TelephonyStateRegistrySlotTable &table) : table_(table)
+{
+    table_.writeMutex_.lock();
+    g_sectionTable = &table_;
+    uint32_t sequence = table_.commitSequence_.load(std::memory_order_relaxed);
+    table_.commitSequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (const auto &page : table_.pages_) {
+        page->BeginCommit();
+    }
+}
+
+TelephonyStateRegistrySlotTable::WriteSection::~WriteSection()
+{
+    for (const auto &page : table_.pages_) {
+        page->EndCommit();
+    }
+    table_.commitSequence_.fetch_add(1, std::memory_order_release);
+    g_sectionTable = nullptr;
+    table_.writeMutex_.unlock();
+}
+
+TelephonyStateRegistrySlotTable::TelephonyStateRegistrySlotTable(int32_t slotSize)
+{
+    // slotSize == 0 means wifionly product, it still publishes the call state of slot 0.
+    slotCount_ = (slotSize > 0 ? slotSize : 1) + 1;
+    slots_ = std::make_unique<SlotState[]>(slotCount_);
+}
+
+bool TelephonyStateRegistrySlotTable::IsValidSlot(int32_t slotId) const
+{
+    return slotId >= ALL_SLOT_ID && slotId - ALL_SLOT_ID < slotCount_;
+}
+
+int32_t TelephonyStateRegistrySlotTable::GetSlotCount() const
+{
+    return slotCount_;
+}
+
+TelephonyStateRegistrySlotTable::SlotState *TelephonyStateRegistrySlotTable::GetSlot(int32_t slotId)
+{
+    return IsValidSlot(slotId) ? &slots_[slotId - ALL_SLOT_ID] : nullptr;
+}
+
+const TelephonyStateRegistrySlotTable::SlotState *TelephonyStateRegistrySlotTable::GetSlot(int32_t slotId) const
+{
+    return IsValidSlot(slotId) ? &slots_[slotId - ALL_SLOT_ID] : nullptr;
+}
+
+uint64_t TelephonyStateRegistrySlotTable::Write(
+    int32_t slotId, std::initializer_list<std::pair<SlotStateField, int32_t>> fields)
+{
+    SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        TELEPHONY_LOGE("Write invalid slotId %{public}d", slotId);
+        return 0;
+    }
+    auto lock = LockWrite();
+    uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    uint32_t validFields = slot->validFields.load(std::memory_order_relaxed);
+    // The fields written together share their version.
+    uint64_t version = version_.fetch_add(1, std::memory_order_relaxed) + 1;
+    for (const auto &field : fields) {
+        uint32_t index = static_cast<uint32_t>(field.first);
+        if (index >= FIELD_COUNT) {
+            continue;
+        }
+        slot->values[index].store(field.second, std::memory_order_relaxed);
+        slot->versions[index].store(version, std::memory_order_relaxed);
+        validFields |= (1u << index);
+    }
+    slot->validFields.store(validFields, std::memory_order_relaxed);
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+    PublishToPages(slotId, *slot);
+    return version;
+}
+
+void TelephonyStateRegistrySlotTable::Invalidate(int32_t slotId, SlotStateField field)
+{
+    SlotState *slot = GetSlot(slotId);
+    uint32_t index = static_cast<uint32_t>(field);
+    if (slot == nullptr || index >= FIELD_COUNT) {
+        return;
+    }
+    auto lock = LockWrite();
+    uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->validFields.fetch_and(~(1u << index), std::memory_order_relaxed);
+    slot->values[index].store(0, std::memory_order_relaxed);
+    slot->versions[index].store(version_.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+    PublishToPages(slotId, *slot);
+}
+
+bool TelephonyStateRegistrySlotTable::Read(int32_t slotId, SlotStateField field, int32_t &value) const
+{
+    SlotStateValues values;
+    if (!Read(slotId, values) || !values.IsValid(field)) {
+        return false;
+    }
+    value = values.Get(field);
+    return true;
+}
+
+bool TelephonyStateRegistrySlotTable::Read(int32_t slotId, SlotStateValues &values) const
+{
+    const SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return false;
+    }
+    while (true) {
+        uint32_t commit = BeginRead();
+        uint32_t begin = slot->sequence.load(std::memory_order_acquire);
+        if ((begin & 1u) != 0) {
+            continue;
+        }
+        values.validFields = slot->validFields.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < FIELD_COUNT; i++) {
+            values.values[i] = slot->values[i].load(std::memory_order_relaxed);
+            values.versions[i] = slot->versions[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) == begin && EndRead(commit)) {
+            return true;
+        }
+    }
+}
+
+void TelephonyStateRegistrySlotTable::ReadCommitted(const std::function<void()> &read) const
+{
+    uint32_t commit = 0;
+    do {
+        commit = BeginRead();
+        read();
+    } while (!EndRead(commit));
+}
+
+std::unique_lock<std::mutex> TelephonyStateRegistrySlotTable::LockWrite()
+{
+    // The writes of a section are serialized by the section itself.
+    if (g_sectionTable == this) {
+        return std::unique_lock<std::mutex>();
+    }
+    return std::unique_lock<std::mutex>(writeMutex_);
+}
+
+uint32_t TelephonyStateRegistrySlotTable::BeginRead() const
+{
+    if (g_sectionTable == this) {
+        return 0;
+    }
+    while (true) {
+        uint32_t commit = commitSequence_.load(std::memory_order_acquire);
+        if ((commit & 1u) == 0) {
+            return commit;
+        }
+        std::this_thread::yield();
+    }
+}
+
+bool TelephonyStateRegistrySlotTable::EndRead(uint32_t begin) const
+{
+    if (g_sectionTable == this) {
+        return true;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return commitSequence_.load(std::memory_order_relaxed) == begin;
+}
+
+void TelephonyStateRegistrySlotTable::AttachPage(const std::shared_ptr<TelephonyStateRegistryStatePage> &page)
+{
+    if (page == nullptr) {
+        return;
+    }
+    auto lock = LockWrite();
+    for (int32_t i = 0; i < slotCount_; i++) {
+        page->Publish(i + ALL_SLOT_ID, LoadValues(slots_[i]));
+    }
+    pages_.push_back(page);
+}
+
+void TelephonyStateRegistrySlotTable::PublishToPages(int32_t slotId, const SlotState &slot)
+{
+    // Called with writeMutex_ held, the slot is not being written.
+    if (pages_.empty()) {
+        return;
+    }
+    SlotStateValues values = LoadValues(slot);
+    for (const auto &page : pages_) {
+        page->Publish(slotId, values);
+    }
+}
+
+SlotStateValues TelephonyStateRegistrySlotTable::LoadValues(const SlotState &slot)
+{
+    SlotStateValues values;
+    values.validFields = slot.validFields.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < FIELD_COUNT; i++) {
+        values.values[i] = slot.values[i].load(std::memory_order_relaxed);
+        values.versions[i] = slot.versions[i].load(std::memory_order_relaxed);
+    }
+    return values;
+}
+
+uint64_t TelephonyStateRegistrySlotTable::StampObject(SlotState &slot, SlotStateObject object)
+{
+    // Stamped after the value is swapped, a reader seeing the new version also sees the new value.
+    uint64_t version = version_.fetch_add(1, std::memory_order_relaxed) + 1;
+    slot.objectVersions[static_cast<uint32_t>(object)].store(version, std::memory_order_release);
+    return version;
+}
+
+uint64_t TelephonyStateRegistrySlotTable::GetVersion() const
+{
+    return version_.load(std::memory_order_acquire);
+}
+
+uint64_t TelephonyStateRegistrySlotTable::GetVersion(int32_t slotId, SlotStateObject object) const
+{
+    const SlotState *slot = GetSlot(slotId);
+    uint32_t index = static_cast<uint32_t>(object);
+    if (slot == nullptr || index >= OBJECT_COUNT) {
+        return 0;
+    }
+    return slot->objectVersions[index].load(std::memory_order_acquire);
+}
+
+uint64_t TelephonyStateRegistrySlotTable::SetCallIncomingNumber(int32_t slotId, const std::u16string &number)
+{
+    SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return 0;
+    }
+    auto lock = LockWrite();
+    std::atomic_store(&slot->callIncomingNumber, std::make_shared<const std::u16string>(number));
+    return StampObject(*slot, SlotStateObject::CALL_INCOMING_NUMBER);
+}
+
+std::u16string TelephonyStateRegistrySlotTable::GetCallIncomingNumber(int32_t slotId) const
+{
+    const SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return u"";
+    }
+    auto number = std::atomic_load(&slot->callIncomingNumber);
+    return number == nullptr ? u"" : *number;
+}
+
+uint64_t TelephonyStateRegistrySlotTable::SetSignalInfos(
+    int32_t slotId, const std::vector<sptr<SignalInformation>> &vec)
+{
+    SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return 0;
+    }
+    auto lock = LockWrite();
+    std::atomic_store(&slot->signalInfos, std::make_shared<const std::vector<sptr<SignalInformation>>>(vec));
+    return StampObject(*slot, SlotStateObject::SIGNAL_INFO);
+}
+
+std::vector<sptr<SignalInformation>> TelephonyStateRegistrySlotTable::GetSignalInfos(int32_t slotId) const
+{
+    const SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return {};
+    }
+    auto signalInfos = std::atomic_load(&slot->signalInfos);
+    return signalInfos == nullptr ? std::vector<sptr<SignalInformation>>() : *signalInfos;
+}
+
+uint64_t TelephonyStateRegistrySlotTable::SetCellInfos(int32_t slotId, const std::vector<sptr<CellInformation>> &vec)
+{
+    SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return 0;
+    }
+    auto lock = LockWrite();
+    std::atomic_store(&slot->cellInfos, std::make_shared<const std::vector<sptr<CellInformation>>>(vec));
+    return StampObject(*slot, SlotStateObject::CELL_INFO);
+}
+
+std::vector<sptr<CellInformation>> TelephonyStateRegistrySlotTable::GetCellInfos(int32_t slotId) const
+{
+    const SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return {};
+    }
+    auto cellInfos = std::atomic_load(&slot->cellInfos);
+    return cellInfos == nullptr ? std::vector<sptr<CellInformation>>() : *cellInfos;
+}
+
+uint64_t TelephonyStateRegistrySlotTable::SetNetworkState(int32_t slotId, const sptr<NetworkState> &networkState)
+{
+    SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return 0;
+    }
+    auto lock = LockWrite();
+    std::atomic_store(&slot->networkState, std::make_shared<const sptr<NetworkState>>(networkState));
+    return StampObject(*slot, SlotStateObject::NETWORK_STATE);
+}
+
+sptr<NetworkState> TelephonyStateRegistrySlotTable::GetNetworkState(int32_t slotId) const
+{
+    const SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return nullptr;
+    }
+    auto networkState = std::atomic_load(&slot->networkState);
+    return networkState == nullptr ? nullptr : *networkState;
+}
+
+bool TelephonyStateRegistrySlotTable::IsSameSignalInfos(
+    int32_t slotId, const std::vector<sptr<SignalInformation>> &vec) const
+{
+    const SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return false;
+    }
+    auto signalInfos = std::atomic_load(&slot->signalInfos);
+    if (signalInfos == nullptr || signalInfos->size() != vec.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < vec.size(); i++) {
+        const sptr<SignalInformation> &current = (*signalInfos)[i];
+        if (current == nullptr || vec[i] == nullptr || current->GetNetworkType() != vec[i]->GetNetworkType() ||
+            !current->ValueEquals(*vec[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TelephonyStateRegistrySlotTable::IsSameNetworkState(int32_t slotId, const sptr<NetworkState> &networkState) const
+{
+    const SlotState *slot = GetSlot(slotId);
+    if (slot == nullptr) {
+        return false;
+    }
+    auto current = std::atomic_load(&slot->networkState);
+    if (current == nullptr || *current == nullptr || networkState == nullptr) {
+        return false;
+    }
+    return **current == *networkState;
+}
+} // namespace Telephony
+} // namespace OHOS
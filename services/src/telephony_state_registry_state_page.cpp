@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_state_page.h"
+
+#include <new>
+#include <sys/mman.h>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+constexpr int32_t ALL_SLOT_ID = -1;
+constexpr const char *STATE_PAGE_NAME = "telephony_state_page";
+static_assert(TelephonyStatePage::FIELD_COUNT == static_cast<uint32_t>(SlotStateField::FIELD_COUNT),
+    "the page has an entry for every slot field");
+} // namespace
+
+std::shared_ptr<TelephonyStateRegistryStatePage> TelephonyStateRegistryStatePage::Create(
+    int32_t slotCount, uint32_t fieldMask)
+{
+    if (slotCount <= 0) {
+        return nullptr;
+    }
+    size_t size = TelephonyStatePage::GetSize(static_cast<uint32_t>(slotCount));
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(STATE_PAGE_NAME, static_cast<int32_t>(size));
+    if (ashmem == nullptr) {
+        TELEPHONY_LOGE("StatePage create ashmem failed");
+        return nullptr;
+    }
+    // Mapped before the protection is reduced, this mapping stays the only writable one.
+    void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, ashmem->GetAshmemFd(), 0);
+    if (address == MAP_FAILED) {
+        TELEPHONY_LOGE("StatePage map ashmem failed");
+        ashmem->CloseAshmem();
+        return nullptr;
+    }
+    if (!ashmem->SetProtection(PROT_READ)) {
+        TELEPHONY_LOGE("StatePage set protection failed");
+        munmap(address, size);
+        ashmem->CloseAshmem();
+        return nullptr;
+    }
+    auto header = new (address) TelephonyStatePage::Header();
+    header->layoutVersion = TelephonyStatePage::LAYOUT_VERSION;
+    header->slotCount = static_cast<uint32_t>(slotCount);
+    header->fieldCount = TelephonyStatePage::FIELD_COUNT;
+    auto slots = reinterpret_cast<uint8_t *>(address) + sizeof(TelephonyStatePage::Header);
+    for (int32_t i = 0; i < slotCount; i++) {
+        new (slots + sizeof(TelephonyStatePage::Slot) * i) TelephonyStatePage::Slot();
+    }
+    // The magic goes last, a reader never accepts a page which is not initialized.
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = TelephonyStatePage::MAGIC;
+    return std::make_shared<TelephonyStateRegistryStatePage>(ashmem, address, slotCount, fieldMask);
+}
+
+TelephonyStateRegistryStatePage::TelephonyStateRegistryStatePage(
+    const sptr<Ashmem> &ashmem, void *address, int32_t slotCount, uint32_t fieldMask)
+    : ashmem_(ashmem), address_(address), slotCount_(slotCount), fieldMask_(fieldMask)
+{}
+
+TelephonyStateRegistryStatePage::~TelephonyStateRegistryStatePage()
+{
+    if (address_ != nullptr) {
+        munmap(address_, TelephonyStatePage::GetSize(static_cast<uint32_t>(slotCount_)));
+    }
+    if (ashmem_ != nullptr) {
+        ashmem_->CloseAshmem();
+    }
+}
+
+void TelephonyStateRegistryStatePage::Publish(int32_t slotId, const SlotStateValues &values)
+{
+    int32_t index = slotId - ALL_SLOT_ID;
+    if (index < 0 || index >= slotCount_) {
+        return;
+    }
+    auto slot = reinterpret_cast<TelephonyStatePage::Slot *>(
+        reinterpret_cast<uint8_t *>(address_) + sizeof(TelephonyStatePage::Header)) + index;
+    uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->validFields.store(values.validFields & fieldMask_, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < TelephonyStatePage::FIELD_COUNT; i++) {
+        bool held = (fieldMask_ & (1u << i)) != 0;
+        slot->values[i].store(held ? values.values[i] : 0, std::memory_order_relaxed);
+        slot->versions[i].store(held ? values.versions[i] : 0, std::memory_order_relaxed);
+    }
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void TelephonyStateRegistryStatePage::BeginCommit()
+{
+    auto header = reinterpret_cast<TelephonyStatePage::Header *>(address_);
+    uint32_t sequence = header->commitSequence.load(std::memory_order_relaxed);
+    header->commitSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void TelephonyStateRegistryStatePage::EndCommit()
+{
+    auto header = reinterpret_cast<TelephonyStatePage::Header *>(address_);
+    header->commitSequence.fetch_add(1, std::memory_order_release);
+}
+
+sptr<Ashmem> TelephonyStateRegistryStatePage::GetAshmem() const
+{
+    return ashmem_;
+}
+
+uint32_t TelephonyStateRegistryStatePage::GetFieldMask() const
+{
+    return fieldMask_;
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -15,6 +15,8 @@
 
 #include "telephony_state_registry_stub.h"
 
+#include <set>
+
 #include "accesstoken_kit.h"
 #include "ipc_skeleton.h"
 #include "string_ex.h"
@@ -22,6 +24,8 @@
 #include "sim_state_type.h"
 #include "state_registry_errors.h"
 #include "telephony_permission.h"
+#include "telephony_observer_update_batch.h"
+#include "telephony_state_registry_change_filter.h"
 
 #ifdef HICOLLIE_ENABLE
 #include "xcollie/xcollie.h"
@@ -31,6 +35,17 @@
 
 namespace OHOS {
 namespace Telephony {
+namespace {
+// Updates a batch request may carry, the producer of the other ones is not the same.
+const std::set<StateNotifyInterfaceCode> BATCH_UPDATE_CODES = {
+    StateNotifyInterfaceCode::SIGNAL_INFO,
+    StateNotifyInterfaceCode::CELL_INFO,
+    StateNotifyInterfaceCode::NET_WORK_STATE,
+    StateNotifyInterfaceCode::CELLULAR_DATA_STATE,
+    StateNotifyInterfaceCode::CELLULAR_DATA_FLOW,
+};
+} // namespace
+
 TelephonyStateRegistryStub::TelephonyStateRegistryStub()
 {
     memberFuncMap_[StateNotifyInterfaceCode::CELL_INFO] =
@@ -61,11 +76,30 @@ TelephonyStateRegistryStub::TelephonyStateRegistryStub()
         [this](MessageParcel &data, MessageParcel &reply) { return OnIccAccountUpdated(data, reply); };
     memberFuncMap_[StateNotifyInterfaceCode::SIM_ACTIVR_STATE] =
         [this](MessageParcel &data, MessageParcel &reply) { return OnSimActiveStateUpdated(data, reply); };
+    memberFuncMapEx_[StateNotifyInterfaceCodeEx::ADD_OBSERVER_WITH_POLICY] =
+        [this](MessageParcel &data, MessageParcel &reply) { return OnRegisterStateChangeWithPolicy(data, reply); };
+    memberFuncMapEx_[StateNotifyInterfaceCodeEx::BATCH_UPDATE] =
+        [this](MessageParcel &data, MessageParcel &reply) { return OnBatchUpdate(data, reply); };
+    memberFuncMapEx_[StateNotifyInterfaceCodeEx::MODIFY_OBSERVER_MASK] =
+        [this](MessageParcel &data, MessageParcel &reply) { return OnModifyObserverMask(data, reply); };
+    memberFuncMapEx_[StateNotifyInterfaceCodeEx::ADD_OBSERVERS] =
+        [this](MessageParcel &data, MessageParcel &reply) { return OnRegisterStateChanges(data, reply); };
+    memberFuncMapEx_[StateNotifyInterfaceCodeEx::REMOVE_OBSERVERS] =
+        [this](MessageParcel &data, MessageParcel &reply) { return OnUnregisterStateChanges(data, reply); };
+    memberFuncMapEx_[StateNotifyInterfaceCodeEx::REMOVE_ALL_OBSERVERS] =
+        [this](MessageParcel &data, MessageParcel &reply) { return OnUnregisterAllStateChanges(data, reply); };
+    memberFuncMapEx_[StateNotifyInterfaceCodeEx::GET_STATE_SNAPSHOT] =
+        [this](MessageParcel &data, MessageParcel &reply) { return OnGetStateSnapshot(data, reply); };
+    memberFuncMapEx_[StateNotifyInterfaceCodeEx::GET_STATE_PAGE] =
+        [this](MessageParcel &data, MessageParcel &reply) { return OnGetStatePage(data, reply); };
+    memberFuncMapEx_[StateNotifyInterfaceCodeEx::GET_EVENT_RING] =
+        [this](MessageParcel &data, MessageParcel &reply) { return OnGetEventRing(data, reply); };
 }
 
 TelephonyStateRegistryStub::~TelephonyStateRegistryStub()
 {
     memberFuncMap_.clear();
+    memberFuncMapEx_.clear();
 }
 
 int32_t TelephonyStateRegistryStub::OnRemoteRequest(
@@ -78,16 +112,22 @@ int32_t TelephonyStateRegistryStub::OnRemoteRequest(
         TELEPHONY_LOGE("TelephonyStateRegistryStub::OnRemoteRequest end##descriptor checked fail");
         return TELEPHONY_ERR_DESCRIPTOR_MISMATCH;
     }
+    TelephonyStateFunc memberFunc = nullptr;
     auto itFunc = memberFuncMap_.find(static_cast<StateNotifyInterfaceCode>(code));
     if (itFunc != memberFuncMap_.end()) {
-        auto memberFunc = itFunc->second;
-        if (memberFunc != nullptr) {
-            int32_t idTimer = SetTimer(code);
-            int32_t result = memberFunc(data, reply);
-            CancelTimer(idTimer);
-            return result;
+        memberFunc = itFunc->second;
+    } else {
+        auto itFuncEx = memberFuncMapEx_.find(static_cast<StateNotifyInterfaceCodeEx>(code));
+        if (itFuncEx != memberFuncMapEx_.end()) {
+            memberFunc = itFuncEx->second;
         }
     }
+    if (memberFunc != nullptr) {
+        int32_t idTimer = SetTimer(code);
+        int32_t result = memberFunc(data, reply);
+        CancelTimer(idTimer);
+        return result;
+    }
     int ret = IPCObjectStub::OnRemoteRequest(code, data, reply, option);
     TELEPHONY_LOGI("TelephonyStateRegistryStub::OnRemoteRequest end##ret=%{public}d", ret);
     return ret;
@@ -129,6 +169,37 @@ void TelephonyStateRegistryStub::CancelTimer(int32_t id)
 #endif
 }
 
+bool TelephonyStateRegistryStub::IsRepeatedUpdate(uint32_t event, int32_t slotId, uint64_t fingerprint,
+    int32_t &result)
+{
+    return false;
+}
+
+void TelephonyStateRegistryStub::OnUpdateHandled(uint32_t event, int32_t slotId, uint64_t fingerprint) {}
+
+int32_t TelephonyStateRegistryStub::CheckBatchUpdateEntry(StateNotifyInterfaceCode code, int32_t slotId)
+{
+    return TELEPHONY_SUCCESS;
+}
+
+int32_t TelephonyStateRegistryStub::RunBatchUpdate(const std::function<void()> &updates)
+{
+    updates();
+    return TELEPHONY_SUCCESS;
+}
+
+uint64_t TelephonyStateRegistryStub::GetUpdateFingerprint(MessageParcel &data)
+{
+    // The arguments following the interface token, slot id included.
+    size_t position = data.GetReadPosition();
+    size_t size = data.GetDataSize();
+    if (data.GetData() == 0 || position >= size) {
+        return 0;
+    }
+    const uint8_t *arguments = reinterpret_cast<const uint8_t *>(data.GetData()) + position;
+    return TelephonyStateRegistryChangeFilter::Fingerprint(arguments, size - position);
+}
+
 int32_t TelephonyStateRegistryStub::OnUpdateCallState(MessageParcel &data, MessageParcel &reply)
 {
     int32_t callState = data.ReadInt32();
@@ -190,7 +261,12 @@ int32_t TelephonyStateRegistryStub::OnUpdateCellularDataFlow(MessageParcel &data
 int32_t TelephonyStateRegistryStub::OnUpdateSignalInfo(MessageParcel &data, MessageParcel &reply)
 {
     int32_t ret = TELEPHONY_SUCCESS;
+    uint64_t fingerprint = GetUpdateFingerprint(data);
     int32_t slotId = data.ReadInt32();
+    if (IsRepeatedUpdate(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, slotId, fingerprint, ret)) {
+        reply.WriteInt32(ret);
+        return NO_ERROR;
+    }
     int32_t size = data.ReadInt32();
     TELEPHONY_LOGI("TelephonyStateRegistryStub::OnUpdateSignalInfo size=%{public}d", size);
     size = ((size > SignalInformation::MAX_SIGNAL_NUM) ? 0 : size);
@@ -205,6 +281,10 @@ int32_t TelephonyStateRegistryStub::OnUpdateSignalInfo(MessageParcel &data, Mess
     if (ret != TELEPHONY_SUCCESS) {
         TELEPHONY_LOGE("TelephonyStateRegistryStub::OnUpdateSignalInfo end fail##ret=%{public}d", ret);
     }
+    if (ret == TELEPHONY_SUCCESS || ret == TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST) {
+        OnUpdateHandled(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, slotId, fingerprint);
+    }
+    reply.WriteInt32(ret);
     return NO_ERROR;
 }
 
@@ -328,13 +408,19 @@ int32_t TelephonyStateRegistryStub::OnUpdateCellInfo(MessageParcel &data, Messag
     }
     ret = UpdateCellInfo(slotId, cells);
     TELEPHONY_LOGI("TelephonyStateRegistryStub::OnUpdateCellInfo end##ret=%{public}d", ret);
+    reply.WriteInt32(ret);
     return NO_ERROR;
 }
 
 int32_t TelephonyStateRegistryStub::OnUpdateNetworkState(MessageParcel &data, MessageParcel &reply)
 {
     int32_t ret = TELEPHONY_SUCCESS;
+    uint64_t fingerprint = GetUpdateFingerprint(data);
     int32_t slotId = data.ReadInt32();
+    if (IsRepeatedUpdate(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, slotId, fingerprint, ret)) {
+        reply.WriteInt32(ret);
+        return NO_ERROR;
+    }
     sptr<NetworkState> result = NetworkState::Unmarshalling(data);
     if (result == nullptr) {
         TELEPHONY_LOGE("TelephonyStateRegistryStub::OnUpdateNetworkState GetNetworkStatus  is null");
@@ -343,6 +429,9 @@ int32_t TelephonyStateRegistryStub::OnUpdateNetworkState(MessageParcel &data, Me
     }
     ret = UpdateNetworkState(slotId, result);
     TELEPHONY_LOGI("TelephonyStateRegistryStub::OnUpdateNetworkState end##ret=%{public}d", ret);
+    if (ret == TELEPHONY_SUCCESS || ret == TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST) {
+        OnUpdateHandled(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, slotId, fingerprint);
+    }
     reply.WriteInt32(ret);
     return NO_ERROR;
 }
@@ -368,6 +457,167 @@ int32_t TelephonyStateRegistryStub::OnRegisterStateChange(MessageParcel &data, M
     return NO_ERROR;
 }
 
+int32_t TelephonyStateRegistryStub::OnRegisterStateChangeWithPolicy(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t slotId = data.ReadInt32();
+    int32_t mask = data.ReadInt32();
+    bool notifyNow = data.ReadBool();
+    sptr<TelephonyObserverBroker> callback = nullptr;
+    int32_t ret = ReadData(data, reply, callback);
+    if (ret != TELEPHONY_SUCCESS) {
+        TELEPHONY_LOGE("TelephonyStateRegistryStub::OnRegisterStateChangeWithPolicy ReadData failed");
+        return NO_ERROR;
+    }
+    TelephonyObserverDeliveryPolicy policy;
+    if (!policy.ReadFromParcel(data) || !policy.IsValid()) {
+        TELEPHONY_LOGE("TelephonyStateRegistryStub::OnRegisterStateChangeWithPolicy invalid policy");
+        reply.WriteInt32(TELEPHONY_ERR_ARGUMENT_INVALID);
+        return NO_ERROR;
+    }
+    ret = RegisterStateChange(callback, slotId, mask, notifyNow);
+    if (ret == TELEPHONY_SUCCESS) {
+        ret = SetDeliveryPolicy(slotId, mask, static_cast<int32_t>(IPCSkeleton::GetCallingTokenID()),
+            IPCSkeleton::GetCallingPid(), policy);
+    }
+    if (ret != TELEPHONY_SUCCESS) {
+        TELEPHONY_LOGE("TelephonyStateRegistryStub::OnRegisterStateChangeWithPolicy end fail##ret=%{public}d", ret);
+    }
+    reply.WriteInt32(ret);
+    return NO_ERROR;
+}
+
+int32_t TelephonyStateRegistryStub::OnModifyObserverMask(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t slotId = data.ReadInt32();
+    uint32_t mask = data.ReadUint32();
+    uint32_t addMask = data.ReadUint32();
+    uint32_t removeMask = data.ReadUint32();
+    bool notifyNow = data.ReadBool();
+    int32_t ret = ModifyObserverMask(slotId, mask, addMask, removeMask, notifyNow,
+        static_cast<int32_t>(IPCSkeleton::GetCallingTokenID()), IPCSkeleton::GetCallingPid());
+    if (ret != TELEPHONY_SUCCESS) {
+        TELEPHONY_LOGE("TelephonyStateRegistryStub::OnModifyObserverMask end fail##ret=%{public}d", ret);
+    }
+    reply.WriteInt32(ret);
+    return NO_ERROR;
+}
+
+bool TelephonyStateRegistryStub::ReadRegistrations(
+    MessageParcel &data, bool withObserver, std::vector<TelephonyObserverRegistration> &registrations)
+{
+    int32_t count = data.ReadInt32();
+    if (count <= 0 || count > TelephonyObserverRegistration::MAX_ENTRY_COUNT) {
+        TELEPHONY_LOGE("TelephonyStateRegistryStub::ReadRegistrations count %{public}d invalid", count);
+        return false;
+    }
+    registrations.resize(count);
+    for (auto &registration : registrations) {
+        if (!data.ReadInt32(registration.slotId) || !data.ReadUint32(registration.mask) ||
+            !data.ReadBool(registration.notifyNow) || !data.ReadUint64(registration.sinceSequence) ||
+            !data.ReadBool(registration.readsSequence)) {
+            return false;
+        }
+        if (!withObserver) {
+            continue;
+        }
+        sptr<IRemoteObject> remote = data.ReadRemoteObject();
+        registration.observer = remote != nullptr ? iface_cast<TelephonyObserverBroker>(remote) : nullptr;
+        if (registration.observer == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int32_t TelephonyStateRegistryStub::OnRegisterStateChanges(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<TelephonyObserverRegistration> registrations;
+    if (!ReadRegistrations(data, true, registrations)) {
+        reply.WriteInt32(TELEPHONY_ERR_ARGUMENT_INVALID);
+        return NO_ERROR;
+    }
+    std::vector<int32_t> results;
+    int32_t ret = RegisterStateChanges(registrations, GetCaller(), results);
+    reply.WriteInt32(ret);
+    reply.WriteInt32Vector(results);
+    return NO_ERROR;
+}
+
+int32_t TelephonyStateRegistryStub::OnUnregisterStateChanges(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<TelephonyObserverRegistration> registrations;
+    if (!ReadRegistrations(data, false, registrations)) {
+        reply.WriteInt32(TELEPHONY_ERR_ARGUMENT_INVALID);
+        return NO_ERROR;
+    }
+    std::vector<int32_t> results;
+    int32_t ret = UnregisterStateChanges(registrations, static_cast<int32_t>(IPCSkeleton::GetCallingTokenID()),
+        IPCSkeleton::GetCallingPid(), results);
+    reply.WriteInt32(ret);
+    reply.WriteInt32Vector(results);
+    return NO_ERROR;
+}
+
+int32_t TelephonyStateRegistryStub::OnUnregisterAllStateChanges(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t ret = UnregisterAllStateChanges(static_cast<int32_t>(IPCSkeleton::GetCallingTokenID()),
+        IPCSkeleton::GetCallingPid());
+    reply.WriteInt32(ret);
+    return NO_ERROR;
+}
+
+int32_t TelephonyStateRegistryStub::OnGetStateSnapshot(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t slotId = data.ReadInt32();
+    std::vector<TelephonyStateSnapshot> snapshots;
+    int32_t ret = GetStateSnapshot(slotId, static_cast<int32_t>(IPCSkeleton::GetCallingTokenID()), snapshots);
+    reply.WriteInt32(ret);
+    if (ret != TELEPHONY_SUCCESS) {
+        return NO_ERROR;
+    }
+    reply.WriteInt32(static_cast<int32_t>(snapshots.size()));
+    for (const auto &snapshot : snapshots) {
+        if (!snapshot.Marshalling(reply)) {
+            TELEPHONY_LOGE("OnGetStateSnapshot write slot %{public}d failed", snapshot.slotId);
+            return TELEPHONY_ERR_WRITE_DATA_FAIL;
+        }
+    }
+    return NO_ERROR;
+}
+
+int32_t TelephonyStateRegistryStub::OnGetStatePage(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<Ashmem> ashmem = nullptr;
+    int32_t ret = GetStatePage(ashmem);
+    reply.WriteInt32(ret);
+    if (ret != TELEPHONY_SUCCESS) {
+        return NO_ERROR;
+    }
+    if (!reply.WriteAshmem(ashmem)) {
+        TELEPHONY_LOGE("OnGetStatePage write ashmem failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    return NO_ERROR;
+}
+
+int32_t TelephonyStateRegistryStub::OnGetEventRing(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t slotId = data.ReadInt32();
+    uint32_t mask = data.ReadUint32();
+    sptr<IRemoteObject> client = data.ReadRemoteObject();
+    sptr<Ashmem> ashmem = nullptr;
+    int32_t ret = GetEventRing(slotId, mask, client, ashmem);
+    reply.WriteInt32(ret);
+    if (ret != TELEPHONY_SUCCESS) {
+        return NO_ERROR;
+    }
+    if (!reply.WriteAshmem(ashmem)) {
+        TELEPHONY_LOGE("OnGetEventRing write ashmem failed");
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    return NO_ERROR;
+}
+
 int32_t TelephonyStateRegistryStub::OnUnregisterStateChange(MessageParcel &data, MessageParcel &reply)
 {
     int32_t slotId = data.ReadInt32();
@@ -442,16 +692,22 @@ int32_t TelephonyStateRegistryStub::OnSimActiveStateUpdated(MessageParcel &data,
 int32_t TelephonyStateRegistryStub::RegisterStateChange(const sptr<TelephonyObserverBroker> &telephonyObserver,
     int32_t slotId, uint32_t mask, bool isUpdate)
 {
-    int32_t uid = IPCSkeleton::GetCallingUid();
-    std::string bundleName = "";
-    TelephonyPermission::GetBundleNameByUid(uid, bundleName);
-    int32_t tokenId = static_cast<int32_t>(IPCSkeleton::GetCallingTokenID());
+    TelephonyStateRegistryRecord caller = GetCaller();
+    return RegisterStateChange(telephonyObserver, slotId, mask, caller.bundleName_, isUpdate, caller.pid_,
+        caller.uid_, caller.tokenId_, caller.appIdentifier_);
+}
+
+TelephonyStateRegistryRecord TelephonyStateRegistryStub::GetCaller()
+{
+    TelephonyStateRegistryRecord caller;
+    caller.uid_ = IPCSkeleton::GetCallingUid();
+    TelephonyPermission::GetBundleNameByUid(caller.uid_, caller.bundleName_);
+    caller.tokenId_ = static_cast<int32_t>(IPCSkeleton::GetCallingTokenID());
     Security::AccessToken::HapTokenInfo hapTokenInfo;
-    Security::AccessToken::AccessTokenKit::GetHapTokenInfo(tokenId, hapTokenInfo);
-    std::string appIdentifier = "";
-    TelephonyPermission::GetAppIdentifier(bundleName, appIdentifier, hapTokenInfo.userID);
-    return RegisterStateChange(telephonyObserver, slotId, mask, bundleName, isUpdate,
-        IPCSkeleton::GetCallingPid(), uid, tokenId, appIdentifier);
+    Security::AccessToken::AccessTokenKit::GetHapTokenInfo(caller.tokenId_, hapTokenInfo);
+    TelephonyPermission::GetAppIdentifier(caller.bundleName_, caller.appIdentifier_, hapTokenInfo.userID);
+    caller.pid_ = IPCSkeleton::GetCallingPid();
+    return caller;
 }
 
 int32_t TelephonyStateRegistryStub::UnregisterStateChange(int32_t slotId, uint32_t mask)
@@ -459,5 +715,106 @@ int32_t TelephonyStateRegistryStub::UnregisterStateChange(int32_t slotId, uint32
     int32_t tokenId = static_cast<int32_t>(IPCSkeleton::GetCallingTokenID());
     return UnregisterStateChange(slotId, mask, tokenId, IPCSkeleton::GetCallingPid());
 }
+
+int32_t TelephonyStateRegistryStub::OnBatchUpdate(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t count = data.ReadInt32();
+    if (count <= 0 || count > TelephonyObserverUpdateBatch::MAX_ENTRY_COUNT) {
+        TELEPHONY_LOGE("TelephonyStateRegistryStub::OnBatchUpdate count %{public}d invalid", count);
+        reply.WriteInt32(TELEPHONY_ERR_ARGUMENT_INVALID);
+        return NO_ERROR;
+    }
+    // Every entry is read and checked first, a batch with a rejected entry runs none of them.
+    std::vector<BatchUpdateEntry> entries(static_cast<size_t>(count));
+    std::vector<int32_t> results(static_cast<size_t>(count), TELEPHONY_SUCCESS);
+    int32_t ret = TELEPHONY_SUCCESS;
+    bool readable = true;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (!readable) {
+            results[i] = TELEPHONY_ERR_READ_DATA_FAIL;
+            continue;
+        }
+        readable = ReadBatchUpdateEntry(data, entries[i], results[i]);
+        if (ret == TELEPHONY_SUCCESS) {
+            ret = results[i];
+        }
+    }
+    if (ret == TELEPHONY_SUCCESS) {
+        ret = RunBatchUpdate([this, &entries, &results]() {
+            for (size_t i = 0; i < entries.size(); i++) {
+                results[i] = RunBatchUpdateEntry(entries[i]);
+            }
+        });
+    }
+    if (ret != TELEPHONY_SUCCESS) {
+        // Not applied, the entries which passed the checks report the failure of the batch.
+        for (int32_t &result : results) {
+            result = result == TELEPHONY_SUCCESS ? ret : result;
+        }
+    } else {
+        for (int32_t result : results) {
+            if (result != TELEPHONY_SUCCESS && result != TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST) {
+                ret = result;
+                break;
+            }
+        }
+    }
+    TELEPHONY_LOGI("TelephonyStateRegistryStub::OnBatchUpdate count %{public}d end##ret=%{public}d", count, ret);
+    reply.WriteInt32(ret);
+    reply.WriteInt32(static_cast<int32_t>(results.size()));
+    for (int32_t result : results) {
+        reply.WriteInt32(result);
+    }
+    return NO_ERROR;
+}
+
+bool TelephonyStateRegistryStub::ReadBatchUpdateEntry(MessageParcel &data, BatchUpdateEntry &entry, int32_t &result)
+{
+    entry.code = static_cast<StateNotifyInterfaceCode>(data.ReadUint32());
+    int32_t size = data.ReadInt32();
+    if (size <= 0 || static_cast<size_t>(size) > data.GetReadableBytes()) {
+        TELEPHONY_LOGE("TelephonyStateRegistryStub batch entry size %{public}d invalid", size);
+        result = TELEPHONY_ERR_READ_DATA_FAIL;
+        return false;
+    }
+    entry.size = static_cast<size_t>(size);
+    entry.arguments = data.ReadBuffer(entry.size);
+    if (entry.arguments == nullptr) {
+        result = TELEPHONY_ERR_READ_DATA_FAIL;
+        return false;
+    }
+    if (memberFuncMap_.find(entry.code) == memberFuncMap_.end() ||
+        BATCH_UPDATE_CODES.find(entry.code) == BATCH_UPDATE_CODES.end()) {
+        TELEPHONY_LOGE("TelephonyStateRegistryStub batch entry code %{public}u invalid",
+            static_cast<uint32_t>(entry.code));
+        result = TELEPHONY_ERR_ARGUMENT_INVALID;
+        return true;
+    }
+    // The arguments of every batched update start with the slot id.
+    MessageParcel arguments;
+    int32_t slotId = 0;
+    if (!arguments.WriteBuffer(entry.arguments, entry.size) || !arguments.ReadInt32(slotId)) {
+        result = TELEPHONY_ERR_READ_DATA_FAIL;
+        return true;
+    }
+    result = CheckBatchUpdateEntry(entry.code, slotId);
+    return true;
+}
+
+int32_t TelephonyStateRegistryStub::RunBatchUpdateEntry(const BatchUpdateEntry &entry)
+{
+    // The entry is handled as the single request carrying the same arguments, parcel fingerprints included.
+    MessageParcel entryData;
+    MessageParcel entryReply;
+    if (!entryData.WriteBuffer(entry.arguments, entry.size)) {
+        return TELEPHONY_ERR_WRITE_DATA_FAIL;
+    }
+    // Every update handler writes the result of its update, an entry without one did not run.
+    int32_t result = memberFuncMap_[entry.code](entryData, entryReply);
+    if (result == NO_ERROR && !entryReply.ReadInt32(result)) {
+        result = TELEPHONY_ERR_READ_DATA_FAIL;
+    }
+    return result;
+}
 } // namespace Telephony
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_subscriber_index.h"
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+void TelephonyStateRegistrySubscriberIndex::Rebuild(const std::vector<TelephonyStateRegistryRecord> &records)
+{
+    Clear();
+    for (size_t i = 0; i < records.size(); i++) {
+        Add(records[i], static_cast<uint32_t>(i));
+    }
+}
+
+void TelephonyStateRegistrySubscriberIndex::Add(const TelephonyStateRegistryRecord &record, uint32_t position)
+{
+    int32_t bucket = GetBucket(record.slotId_);
+    if (bucket < 0) {
+        return;
+    }
+    for (uint32_t bit = 0; bit < MASK_BIT_COUNT; bit++) {
+        if ((record.mask_ & (1u << bit)) == 0) {
+            continue;
+        }
+        buckets_[bit][bucket].push_back(position);
+        buckets_[bit][ANY_SLOT_BUCKET].push_back(position);
+    }
+}
+
+void TelephonyStateRegistrySubscriberIndex::Clear()
+{
+    for (auto &slotBuckets : buckets_) {
+        for (auto &bucket : slotBuckets) {
+            bucket.clear();
+        }
+    }
+}
+
+TelephonyStateRegistrySubscriberIndex::Cursor TelephonyStateRegistrySubscriberIndex::Find(
+    uint32_t mask, std::initializer_list<int32_t> slotIds) const
+{
+    Cursor cursor;
+    for (uint32_t bit = 0; bit < MASK_BIT_COUNT; bit++) {
+        if ((mask & (1u << bit)) == 0) {
+            continue;
+        }
+        for (int32_t slotId : slotIds) {
+            int32_t bucket = GetBucket(slotId);
+            if (bucket < 0 || buckets_[bit][bucket].empty()) {
+                continue;
+            }
+            if (cursor.listCount_ >= Cursor::MAX_MERGE_LISTS) {
+                TELEPHONY_LOGE("Find too many buckets, mask %{public}u", mask);
+                return cursor;
+            }
+            cursor.lists_[cursor.listCount_++] = &buckets_[bit][bucket];
+        }
+    }
+    return cursor;
+}
+
+bool TelephonyStateRegistrySubscriberIndex::Cursor::Next(uint32_t &position)
+{
+    while (true) {
+        size_t minList = listCount_;
+        for (size_t i = 0; i < listCount_; i++) {
+            if (offsets_[i] < lists_[i]->size() &&
+                (minList == listCount_ || (*lists_[i])[offsets_[i]] < (*lists_[minList])[offsets_[minList]])) {
+                minList = i;
+            }
+        }
+        if (minList == listCount_) {
+            return false;
+        }
+        uint32_t current = (*lists_[minList])[offsets_[minList]++];
+        // The buckets are sorted, a record listening to several of them shows up consecutively.
+        if (hasLast_ && current == last_) {
+            continue;
+        }
+        hasLast_ = true;
+        last_ = current;
+        position = current;
+        return true;
+    }
+}
+
+int32_t TelephonyStateRegistrySubscriberIndex::GetBucket(int32_t slotId)
+{
+    if (slotId == ANY_SLOT_ID) {
+        return ANY_SLOT_BUCKET;
+    }
+    if (slotId == DEFAULT_CONN_SLOT_ID) {
+        return DEFAULT_CONN_BUCKET;
+    }
+    // -1 means observe the call state of all slots, it takes the first bucket.
+    if (slotId < -1 || slotId > MAX_SLOT_COUNT) {
+        return -1;
+    }
+    return slotId + 1;
+}
+} // namespace Telephony
+} // namespace OHOS
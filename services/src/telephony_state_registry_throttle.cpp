@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_throttle.h"
+
+#include <chrono>
+#include <cstdlib>
+
+#include "cell_information.h"
+#include "signal_information.h"
+#include "telephony_observer_broker.h"
+
+namespace OHOS {
+namespace Telephony {
+TelephonyStateRegistryThrottle::TelephonyStateRegistryThrottle(const TelephonyObserverDeliveryPolicy &policy)
+    : policy_(policy)
+{}
+
+bool TelephonyStateRegistryThrottle::IsThrottledEvent(uint32_t event)
+{
+    return event == TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS ||
+        event == TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO;
+}
+
+TelephonyStateRegistryThrottle::Sample TelephonyStateRegistryThrottle::MakeSample(
+    const std::vector<sptr<SignalInformation>> &vec)
+{
+    // The first signal is the one of the serving network.
+    Sample sample;
+    for (const auto &signal : vec) {
+        if (signal != nullptr) {
+            sample.level = signal->GetSignalLevel();
+            sample.dbm = signal->GetSignalIntensity();
+            break;
+        }
+    }
+    return sample;
+}
+
+TelephonyStateRegistryThrottle::Sample TelephonyStateRegistryThrottle::MakeSample(
+    const std::vector<sptr<CellInformation>> &vec)
+{
+    // The first cell is the serving cell.
+    Sample sample;
+    for (const auto &cell : vec) {
+        if (cell != nullptr) {
+            sample.level = cell->GetSignalLevel();
+            sample.dbm = cell->GetSignalIntensity();
+            break;
+        }
+    }
+    return sample;
+}
+
+const TelephonyObserverDeliveryPolicy &TelephonyStateRegistryThrottle::GetPolicy() const
+{
+    return policy_;
+}
+
+TelephonyStateRegistryThrottle::Decision TelephonyStateRegistryThrottle::Offer(
+    uint32_t event, const Sample &sample, Job job, uint32_t &flushDelayMs)
+{
+    flushDelayMs = 0;
+    // Released out of the lock, a replaced delivery may hold the last reference of another snapshot.
+    Job replaced;
+    std::lock_guard<std::mutex> lock(mutex_);
+    EventState *state = GetState(event);
+    if (state == nullptr) {
+        return Decision::DELIVER;
+    }
+    if (closed_) {
+        return Decision::DROP;
+    }
+    if (!IsSignificant(*state, sample)) {
+        // The latest value is close to the one delivered, a deferred older value is not worth delivering anymore.
+        replaced = std::move(state->pending);
+        state->pending = nullptr;
+        stats_.dropped++;
+        return Decision::DROP;
+    }
+    int64_t now = GetNowMs();
+    int64_t elapsed = now - state->lastTimeMs;
+    if (state->delivered && policy_.minIntervalMs > 0 && elapsed < policy_.minIntervalMs) {
+        replaced = std::move(state->pending);
+        state->pending = std::move(job);
+        state->pendingSample = sample;
+        stats_.deferred++;
+        if (!state->timerArmed) {
+            state->timerArmed = true;
+            flushDelayMs = static_cast<uint32_t>(policy_.minIntervalMs - elapsed);
+        }
+        return Decision::DEFER;
+    }
+    replaced = std::move(state->pending);
+    state->pending = nullptr;
+    state->delivered = true;
+    state->last = sample;
+    state->lastTimeMs = now;
+    return Decision::DELIVER;
+}
+
+uint32_t TelephonyStateRegistryThrottle::Flush(uint32_t event)
+{
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        EventState *state = GetState(event);
+        if (state == nullptr) {
+            return 0;
+        }
+        state->timerArmed = false;
+        if (closed_ || state->pending == nullptr) {
+            return 0;
+        }
+        // A notification delivered in between restarted the interval.
+        int64_t now = GetNowMs();
+        int64_t elapsed = now - state->lastTimeMs;
+        if (elapsed < policy_.minIntervalMs) {
+            state->timerArmed = true;
+            return static_cast<uint32_t>(policy_.minIntervalMs - elapsed);
+        }
+        job = std::move(state->pending);
+        state->pending = nullptr;
+        state->last = state->pendingSample;
+        state->lastTimeMs = now;
+        stats_.flushed++;
+    }
+    job();
+    return 0;
+}
+
+void TelephonyStateRegistryThrottle::Close()
+{
+    Job signalJob;
+    Job cellJob;
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    signalJob.swap(signalState_.pending);
+    cellJob.swap(cellState_.pending);
+}
+
+TelephonyStateRegistryThrottle::Stats TelephonyStateRegistryThrottle::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+TelephonyStateRegistryThrottle::EventState *TelephonyStateRegistryThrottle::GetState(uint32_t event)
+{
+    if (event == TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS) {
+        return &signalState_;
+    }
+    if (event == TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO) {
+        return &cellState_;
+    }
+    return nullptr;
+}
+
+bool TelephonyStateRegistryThrottle::IsSignificant(const EventState &state, const Sample &sample) const
+{
+    if (!state.delivered || sample.level != state.last.level) {
+        return true;
+    }
+    if (policy_.levelChangeOnly) {
+        return false;
+    }
+    return std::abs(sample.dbm - state.last.dbm) >= policy_.signalDeltaDbm;
+}
+
+int64_t TelephonyStateRegistryThrottle::GetNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace Telephony
+} // namespace OHOS
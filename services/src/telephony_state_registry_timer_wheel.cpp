@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "telephony_state_registry_timer_wheel.h"
+
+#include <chrono>
+#include <pthread.h>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+TelephonyStateRegistryTimerWheel::TelephonyStateRegistryTimerWheel(uint32_t tickMs, uint32_t slotCount)
+    : tickMs_(tickMs > 0 ? tickMs : 1), slots_(slotCount > 0 ? slotCount : 1)
+{}
+
+TelephonyStateRegistryTimerWheel::~TelephonyStateRegistryTimerWheel()
+{
+    Stop();
+}
+
+bool TelephonyStateRegistryTimerWheel::Schedule(uint32_t delayMs, Task task)
+{
+    if (task == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+        return false;
+    }
+    if (!thread_.joinable()) {
+        thread_ = std::thread([this]() { Run(); });
+        pthread_setname_np(thread_.native_handle(), "state_timer");
+    }
+    // The task runs when the cursor reaches its slot for the (rounds + 1)th time.
+    uint32_t ticks = (delayMs + tickMs_ - 1) / tickMs_;
+    ticks = ticks > 0 ? ticks : 1;
+    size_t slotCount = slots_.size();
+    size_t index = (cursor_ + ticks) % slotCount;
+    slots_[index].push_back({ static_cast<uint32_t>((ticks - 1) / slotCount), std::move(task) });
+    pendingCount_++;
+    condition_.notify_one();
+    return true;
+}
+
+void TelephonyStateRegistryTimerWheel::Stop()
+{
+    std::thread thread;
+    // Released out of the lock, the tasks may hold the last reference of objects scheduling on the wheel.
+    std::vector<std::vector<Entry>> slots(slots_.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        condition_.notify_all();
+        thread.swap(thread_);
+        for (size_t i = 0; i < slots_.size(); i++) {
+            slots[i].swap(slots_[i]);
+        }
+        pendingCount_ = 0;
+    }
+    if (!thread.joinable()) {
+        return;
+    }
+    if (thread.get_id() == std::this_thread::get_id()) {
+        thread.detach();
+        return;
+    }
+    thread.join();
+}
+
+size_t TelephonyStateRegistryTimerWheel::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pendingCount_;
+}
+
+void TelephonyStateRegistryTimerWheel::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto nextTick = std::chrono::steady_clock::now();
+    while (!stopping_) {
+        if (pendingCount_ == 0) {
+            condition_.wait(lock, [this] { return stopping_ || pendingCount_ > 0; });
+            nextTick = std::chrono::steady_clock::now();
+            continue;
+        }
+        nextTick += std::chrono::milliseconds(tickMs_);
+        if (condition_.wait_until(lock, nextTick, [this] { return stopping_; })) {
+            break;
+        }
+        cursor_ = (cursor_ + 1) % slots_.size();
+        std::vector<Task> due;
+        auto &slot = slots_[cursor_];
+        for (auto it = slot.begin(); it != slot.end();) {
+            if (it->rounds > 0) {
+                it->rounds--;
+                ++it;
+                continue;
+            }
+            due.push_back(std::move(it->task));
+            it = slot.erase(it);
+        }
+        pendingCount_ -= due.size();
+        lock.unlock();
+        for (auto &task : due) {
+            task();
+        }
+        due.clear();
+        lock.lock();
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -1,57 +1,130 @@
-/*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#ifndef TELEPHONY_EXT_WRAPPER_H
-#define TELEPHONY_EXT_WRAPPER_H
-
-#include "nocopyable.h"
-#include "singleton.h"
-#include "telephony_state_registry_record.h"
-
-namespace OHOS {
-namespace Telephony {
-class TelephonyExtWrapper final {
-DECLARE_DELAYED_REF_SINGLETON(TelephonyExtWrapper);
-
-public:
-    DISALLOW_COPY_AND_MOVE(TelephonyExtWrapper);
-    void InitTelephonyExtWrapper();
-
-    typedef void (*ON_NETWORK_STATE_UPDATE)(int32_t slotId, TelephonyStateRegistryRecord record,
-        sptr<NetworkState> &targetNetworkState, const sptr<NetworkState> &networkState);
-    typedef void (*ON_SIGNAL_INFO_UPDATE)(int32_t slotId, TelephonyStateRegistryRecord record,
-         std::vector<sptr<SignalInformation>> &targetVec, const std::vector<sptr<SignalInformation>> &vec);
-    typedef void (*ON_CELL_INFO_UPDATE)(int32_t slotId, TelephonyStateRegistryRecord record,
-        std::vector<sptr<CellInformation>> &targetVec, const std::vector<sptr<CellInformation>> &vec);
-    typedef void (*ON_CELLULAR_DATA_CONNECT_STATE_UPDATE)(int32_t slotId, TelephonyStateRegistryRecord record,
-        int32_t &networkType);
-    typedef void (*SEND_NETWORK_STATE_CHANGED)(int32_t slotId, const sptr<NetworkState> &networkState);
-    typedef void (*SEND_SIGNAL_INFO_CHANGED)(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec);
-
-    ON_NETWORK_STATE_UPDATE onNetworkStateUpdated_ = nullptr;
-    ON_SIGNAL_INFO_UPDATE onSignalInfoUpdated_ = nullptr;
-    ON_CELL_INFO_UPDATE onCellInfoUpdated_ = nullptr;
-    ON_CELLULAR_DATA_CONNECT_STATE_UPDATE onCellularDataConnectStateUpdated_ = nullptr;
-    SEND_NETWORK_STATE_CHANGED sendNetworkStateChanged_ = nullptr;
-    SEND_SIGNAL_INFO_CHANGED sendSignalInfoChanged_ = nullptr;
-
-private:
-    void* telephonyExtWrapperHandle_ = nullptr;
-};
-
-#define TELEPHONY_EXT_WRAPPER ::OHOS::DelayedRefSingleton<TelephonyExtWrapper>::GetInstance()
-} // namespace Telephony
-} // namespace OHOS
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TELEPHONY_EXT_WRAPPER_H
+#define TELEPHONY_EXT_WRAPPER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include "nocopyable.h"
+#include "singleton.h"
+#include "telephony_state_registry_record.h"
+
+namespace OHOS {
+namespace Telephony {
+class TelephonyExtWrapper final {
+DECLARE_DELAYED_REF_SINGLETON(TelephonyExtWrapper);
+
+public:
+    DISALLOW_COPY_AND_MOVE(TelephonyExtWrapper);
+    void InitTelephonyExtWrapper();
+
+    typedef void (*ON_NETWORK_STATE_UPDATE)(int32_t slotId, TelephonyStateRegistryRecord record,
+        sptr<NetworkState> &targetNetworkState, const sptr<NetworkState> &networkState);
+    typedef void (*ON_SIGNAL_INFO_UPDATE)(int32_t slotId, TelephonyStateRegistryRecord record,
+         std::vector<sptr<SignalInformation>> &targetVec, const std::vector<sptr<SignalInformation>> &vec);
+    typedef void (*ON_CELL_INFO_UPDATE)(int32_t slotId, TelephonyStateRegistryRecord record,
+        std::vector<sptr<CellInformation>> &targetVec, const std::vector<sptr<CellInformation>> &vec);
+    typedef void (*ON_CELLULAR_DATA_CONNECT_STATE_UPDATE)(int32_t slotId, TelephonyStateRegistryRecord record,
+        int32_t &networkType);
+    typedef void (*SEND_NETWORK_STATE_CHANGED)(int32_t slotId, const sptr<NetworkState> &networkState);
+    typedef void (*SEND_SIGNAL_INFO_CHANGED)(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec);
+
+    /**
+     * Optional batch variants of the update hooks, used instead of the per record ones when exported. They receive
+     * the event once with every matching record and fill a few distinct variants of it, variantIndexes[i] is the
+     * index in variants of the value records[i] receives, a missing or negative index keeps the event unchanged.
+     */
+    typedef void (*ON_NETWORK_STATE_UPDATE_BATCH)(int32_t slotId,
+        const std::vector<TelephonyStateRegistryRecord> &records, const sptr<NetworkState> &networkState,
+        std::vector<sptr<NetworkState>> &variants, std::vector<int32_t> &variantIndexes);
+    typedef void (*ON_SIGNAL_INFO_UPDATE_BATCH)(int32_t slotId,
+        const std::vector<TelephonyStateRegistryRecord> &records, const std::vector<sptr<SignalInformation>> &vec,
+        std::vector<std::vector<sptr<SignalInformation>>> &variants, std::vector<int32_t> &variantIndexes);
+    typedef void (*ON_CELL_INFO_UPDATE_BATCH)(int32_t slotId,
+        const std::vector<TelephonyStateRegistryRecord> &records, const std::vector<sptr<CellInformation>> &vec,
+        std::vector<std::vector<sptr<CellInformation>>> &variants, std::vector<int32_t> &variantIndexes);
+    typedef void (*ON_CELLULAR_DATA_CONNECT_STATE_UPDATE_BATCH)(int32_t slotId,
+        const std::vector<TelephonyStateRegistryRecord> &records, const int32_t &networkType,
+        std::vector<int32_t> &variants, std::vector<int32_t> &variantIndexes);
+
+    ON_NETWORK_STATE_UPDATE onNetworkStateUpdated_ = nullptr;
+    ON_SIGNAL_INFO_UPDATE onSignalInfoUpdated_ = nullptr;
+    ON_CELL_INFO_UPDATE onCellInfoUpdated_ = nullptr;
+    ON_CELLULAR_DATA_CONNECT_STATE_UPDATE onCellularDataConnectStateUpdated_ = nullptr;
+    SEND_NETWORK_STATE_CHANGED sendNetworkStateChanged_ = nullptr;
+    SEND_SIGNAL_INFO_CHANGED sendSignalInfoChanged_ = nullptr;
+    ON_NETWORK_STATE_UPDATE_BATCH onNetworkStateUpdatedBatch_ = nullptr;
+    ON_SIGNAL_INFO_UPDATE_BATCH onSignalInfoUpdatedBatch_ = nullptr;
+    ON_CELL_INFO_UPDATE_BATCH onCellInfoUpdatedBatch_ = nullptr;
+    ON_CELLULAR_DATA_CONNECT_STATE_UPDATE_BATCH onCellularDataConnectStateUpdatedBatch_ = nullptr;
+
+    enum class Hook : uint32_t {
+        NETWORK_STATE_UPDATE = 0,
+        SIGNAL_INFO_UPDATE,
+        CELL_INFO_UPDATE,
+        CELLULAR_DATA_CONNECT_STATE_UPDATE,
+        SEND_NETWORK_STATE_CHANGED,
+        SEND_SIGNAL_INFO_CHANGED,
+        HOOK_COUNT,
+    };
+
+    struct HookStats {
+        uint64_t calls = 0;
+        uint64_t overBudgetCalls = 0;
+        uint64_t totalTimeUs = 0;
+        uint64_t maxTimeUs = 0;
+    };
+
+    /**
+     * Times the hook call of its scope, a call longer than the budget is counted and logged.
+     */
+    class HookTimer {
+    public:
+        explicit HookTimer(Hook hook);
+        ~HookTimer();
+
+    private:
+        Hook hook_;
+        std::chrono::steady_clock::time_point begin_;
+    };
+
+    static const char *GetHookName(Hook hook);
+    HookStats GetHookStats(Hook hook) const;
+    uint32_t GetHookBudgetUs() const;
+    void SetHookBudgetUs(uint32_t budgetUs);
+
+private:
+    void RecordHookTime(Hook hook, uint64_t timeUs);
+
+private:
+    struct HookCounters {
+        std::atomic<uint64_t> calls { 0 };
+        std::atomic<uint64_t> overBudgetCalls { 0 };
+        std::atomic<uint64_t> totalTimeUs { 0 };
+        std::atomic<uint64_t> maxTimeUs { 0 };
+    };
+
+    void* telephonyExtWrapperHandle_ = nullptr;
+    std::atomic<uint32_t> hookBudgetUs_ { 0 };
+    std::array<HookCounters, static_cast<size_t>(Hook::HOOK_COUNT)> hookCounters_;
+};
+
+#define TELEPHONY_EXT_WRAPPER ::OHOS::DelayedRefSingleton<TelephonyExtWrapper>::GetInstance()
+} // namespace Telephony
+} // namespace OHOS
 #endif // TELEPHONY_EXT_WRAPPER_H
\ No newline at end of file
@@ -1,65 +1,150 @@
-/*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#include <dlfcn.h>
-#include "telephony_ext_wrapper.h"
-#include "telephony_log_wrapper.h"
-
-namespace OHOS {
-namespace Telephony {
-namespace {
-const std::string TELEPHONY_EXT_WRAPPER_PATH = "libtel_ext_symbol.z.so";
-} // namespace
-
-TelephonyExtWrapper::TelephonyExtWrapper() {}
-TelephonyExtWrapper::~TelephonyExtWrapper()
-{
-    TELEPHONY_LOGD("TelephonyExtWrapper::~TelephonyExtWrapper() start");
-    if (telephonyExtWrapperHandle_ != nullptr) {
-        dlclose(telephonyExtWrapperHandle_);
-        telephonyExtWrapperHandle_ = nullptr;
-    }
-}
-
-void TelephonyExtWrapper::InitTelephonyExtWrapper()
-{
-    TELEPHONY_LOGD("TelephonyExtWrapper::InitTelephonyExtWrapper() start");
-    telephonyExtWrapperHandle_ = dlopen(TELEPHONY_EXT_WRAPPER_PATH.c_str(), RTLD_NOW);
-    if (telephonyExtWrapperHandle_ == nullptr) {
-        TELEPHONY_LOGE("libtel_ext_symbol.z.so was not loaded, error: %{public}s", dlerror());
-        return;
-    }
-
-    onNetworkStateUpdated_ = (ON_NETWORK_STATE_UPDATE)dlsym(telephonyExtWrapperHandle_, "OnNetworkStateUpdatedExt");
-    onSignalInfoUpdated_ = (ON_SIGNAL_INFO_UPDATE)dlsym(telephonyExtWrapperHandle_, "OnSignalInfoUpdatedExt");
-    onCellInfoUpdated_ = (ON_CELL_INFO_UPDATE)dlsym(telephonyExtWrapperHandle_, "OnCellInfoUpdatedExt");
-    onCellularDataConnectStateUpdated_ = (ON_CELLULAR_DATA_CONNECT_STATE_UPDATE)
-        dlsym(telephonyExtWrapperHandle_, "OnCellularDataConnectStateUpdatedExt");
-
-    sendNetworkStateChanged_ = (SEND_NETWORK_STATE_CHANGED)dlsym(telephonyExtWrapperHandle_,
-        "SendNetworkStateChangedExt");
-    sendSignalInfoChanged_ = (SEND_SIGNAL_INFO_CHANGED)dlsym(telephonyExtWrapperHandle_, "SendSignalInfoChangedExt");
-    // Check whether all function pointers are empty.
-    if (onNetworkStateUpdated_ == nullptr || onSignalInfoUpdated_ == nullptr || onCellInfoUpdated_ == nullptr
-        || onCellularDataConnectStateUpdated_ == nullptr || sendNetworkStateChanged_ == nullptr
-        || sendSignalInfoChanged_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol failed, error: %{public}s", dlerror());
-        return;
-    }
-
-    TELEPHONY_LOGI("telephony ext wrapper init success");
-}
-} // namespace Telephony
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <dlfcn.h>
+#include "parameters.h"
+#include "telephony_ext_wrapper.h"
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+const std::string TELEPHONY_EXT_WRAPPER_PATH = "libtel_ext_symbol.z.so";
+const std::string HOOK_BUDGET_PARAMETER = "persist.telephony.state_registry.ext_hook_budget_us";
+constexpr int32_t DEFAULT_HOOK_BUDGET_US = 2000;
+// Over budget calls logged, the first one then one in a hundred.
+constexpr uint64_t OVER_BUDGET_LOG_INTERVAL = 100;
+const char *const HOOK_NAMES[] = {
+    "OnNetworkStateUpdated",
+    "OnSignalInfoUpdated",
+    "OnCellInfoUpdated",
+    "OnCellularDataConnectStateUpdated",
+    "SendNetworkStateChanged",
+    "SendSignalInfoChanged",
+};
+} // namespace
+
+TelephonyExtWrapper::TelephonyExtWrapper()
+{
+    hookBudgetUs_ = static_cast<uint32_t>(DEFAULT_HOOK_BUDGET_US);
+}
+TelephonyExtWrapper::~TelephonyExtWrapper()
+{
+    TELEPHONY_LOGD("TelephonyExtWrapper::~TelephonyExtWrapper() start");
+    if (telephonyExtWrapperHandle_ != nullptr) {
+        dlclose(telephonyExtWrapperHandle_);
+        telephonyExtWrapperHandle_ = nullptr;
+    }
+}
+
+void TelephonyExtWrapper::InitTelephonyExtWrapper()
+{
+    TELEPHONY_LOGD("TelephonyExtWrapper::InitTelephonyExtWrapper() start");
+    telephonyExtWrapperHandle_ = dlopen(TELEPHONY_EXT_WRAPPER_PATH.c_str(), RTLD_NOW);
+    if (telephonyExtWrapperHandle_ == nullptr) {
+        TELEPHONY_LOGE("libtel_ext_symbol.z.so was not loaded, error: %{public}s", dlerror());
+        return;
+    }
+
+    onNetworkStateUpdated_ = (ON_NETWORK_STATE_UPDATE)dlsym(telephonyExtWrapperHandle_, "OnNetworkStateUpdatedExt");
+    onSignalInfoUpdated_ = (ON_SIGNAL_INFO_UPDATE)dlsym(telephonyExtWrapperHandle_, "OnSignalInfoUpdatedExt");
+    onCellInfoUpdated_ = (ON_CELL_INFO_UPDATE)dlsym(telephonyExtWrapperHandle_, "OnCellInfoUpdatedExt");
+    onCellularDataConnectStateUpdated_ = (ON_CELLULAR_DATA_CONNECT_STATE_UPDATE)
+        dlsym(telephonyExtWrapperHandle_, "OnCellularDataConnectStateUpdatedExt");
+
+    sendNetworkStateChanged_ = (SEND_NETWORK_STATE_CHANGED)dlsym(telephonyExtWrapperHandle_,
+        "SendNetworkStateChangedExt");
+    sendSignalInfoChanged_ = (SEND_SIGNAL_INFO_CHANGED)dlsym(telephonyExtWrapperHandle_, "SendSignalInfoChangedExt");
+    // Optional, the per record hooks are used when the library does not export them.
+    onNetworkStateUpdatedBatch_ = (ON_NETWORK_STATE_UPDATE_BATCH)dlsym(telephonyExtWrapperHandle_,
+        "OnNetworkStateUpdatedBatchExt");
+    onSignalInfoUpdatedBatch_ = (ON_SIGNAL_INFO_UPDATE_BATCH)dlsym(telephonyExtWrapperHandle_,
+        "OnSignalInfoUpdatedBatchExt");
+    onCellInfoUpdatedBatch_ = (ON_CELL_INFO_UPDATE_BATCH)dlsym(telephonyExtWrapperHandle_, "OnCellInfoUpdatedBatchExt");
+    onCellularDataConnectStateUpdatedBatch_ = (ON_CELLULAR_DATA_CONNECT_STATE_UPDATE_BATCH)
+        dlsym(telephonyExtWrapperHandle_, "OnCellularDataConnectStateUpdatedBatchExt");
+    int32_t budgetUs = OHOS::system::GetIntParameter(HOOK_BUDGET_PARAMETER, DEFAULT_HOOK_BUDGET_US);
+    SetHookBudgetUs(budgetUs > 0 ? static_cast<uint32_t>(budgetUs) : 0);
+    // Check whether all function pointers are empty.
+    if (onNetworkStateUpdated_ == nullptr || onSignalInfoUpdated_ == nullptr || onCellInfoUpdated_ == nullptr
+        || onCellularDataConnectStateUpdated_ == nullptr || sendNetworkStateChanged_ == nullptr
+        || sendSignalInfoChanged_ == nullptr) {
+        TELEPHONY_LOGE("telephony ext wrapper symbol failed, error: %{public}s", dlerror());
+        return;
+    }
+
+    TELEPHONY_LOGI("telephony ext wrapper init success");
+}
+
+const char *TelephonyExtWrapper::GetHookName(Hook hook)
+{
+    return hook < Hook::HOOK_COUNT ? HOOK_NAMES[static_cast<uint32_t>(hook)] : "";
+}
+
+TelephonyExtWrapper::HookStats TelephonyExtWrapper::GetHookStats(Hook hook) const
+{
+    HookStats stats;
+    if (hook >= Hook::HOOK_COUNT) {
+        return stats;
+    }
+    const HookCounters &counters = hookCounters_[static_cast<uint32_t>(hook)];
+    stats.calls = counters.calls.load();
+    stats.overBudgetCalls = counters.overBudgetCalls.load();
+    stats.totalTimeUs = counters.totalTimeUs.load();
+    stats.maxTimeUs = counters.maxTimeUs.load();
+    return stats;
+}
+
+uint32_t TelephonyExtWrapper::GetHookBudgetUs() const
+{
+    return hookBudgetUs_.load();
+}
+
+void TelephonyExtWrapper::SetHookBudgetUs(uint32_t budgetUs)
+{
+    hookBudgetUs_ = budgetUs;
+}
+
+void TelephonyExtWrapper::RecordHookTime(Hook hook, uint64_t timeUs)
+{
+    if (hook >= Hook::HOOK_COUNT) {
+        return;
+    }
+    HookCounters &counters = hookCounters_[static_cast<uint32_t>(hook)];
+    counters.calls++;
+    counters.totalTimeUs += timeUs;
+    uint64_t maxTimeUs = counters.maxTimeUs.load();
+    while (timeUs > maxTimeUs && !counters.maxTimeUs.compare_exchange_weak(maxTimeUs, timeUs)) {}
+    uint32_t budgetUs = hookBudgetUs_.load();
+    if (budgetUs == 0 || timeUs <= budgetUs) {
+        return;
+    }
+    uint64_t overBudgetCalls = ++counters.overBudgetCalls;
+    if (overBudgetCalls % OVER_BUDGET_LOG_INTERVAL == 1) {
+        TELEPHONY_LOGW("Ext hook %{public}s took %{public}llu us, budget %{public}u us, %{public}llu calls over budget",
+            GetHookName(hook), static_cast<unsigned long long>(timeUs), budgetUs,
+            static_cast<unsigned long long>(overBudgetCalls));
+    }
+}
+
+TelephonyExtWrapper::HookTimer::HookTimer(Hook hook) : hook_(hook), begin_(std::chrono::steady_clock::now()) {}
+
+TelephonyExtWrapper::HookTimer::~HookTimer()
+{
+    auto timeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin_);
+    TELEPHONY_EXT_WRAPPER.RecordHookTime(hook_, static_cast<uint64_t>(timeUs.count()));
+}
+} // namespace Telephony
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,449 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define private public
+#define protected public
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mock_telephony_permission.h"
+#include "signal_information.h"
+#include "string_ex.h"
+#include "telephony_errors.h"
+#include "telephony_observer.h"
+#include "telephony_state_registry_service.h"
+
+namespace OHOS {
+namespace Telephony {
+namespace {
+using Clock = std::chrono::steady_clock;
+constexpr int32_t BENCHMARK_PID_BASE = 100000;
+constexpr int32_t BENCHMARK_UID = 20010000;
+constexpr int32_t BENCHMARK_TOKEN_ID = 0x28000000;
+constexpr int32_t WARMUP_ITERATIONS = 5;
+constexpr int32_t SIGNAL_RSSI_BASE = -50;
+constexpr int32_t SIGNAL_RSSI_RANGE = 60;
+constexpr int32_t CALL_STATE_COUNT = 4;
+constexpr double PERCENTILE_50 = 0.5;
+constexpr double PERCENTILE_90 = 0.9;
+constexpr double PERCENTILE_99 = 0.99;
+constexpr double US_PER_SECOND = 1000000.0;
+const std::string BENCHMARK_BUNDLE_NAME = "com.ohos.state_registry_benchmark";
+
+std::atomic<uint64_t> g_notifications { 0 };
+std::atomic<uint32_t> g_sequence { 0 };
+
+struct Options {
+    std::vector<int32_t> subscribers { 1, 10, 100, 1000, 10000 };
+    std::vector<int32_t> slots { 1, 2 };
+    std::vector<int32_t> threads { 1, 2, 4 };
+    int32_t iterations = 200;
+    int32_t registerIterations = 3;
+    std::string output;
+};
+
+struct Result {
+    std::string name;
+    int32_t subscribers = 0;
+    int32_t slots = 0;
+    int32_t threads = 0;
+    int32_t iterations = 0;
+    uint64_t operations = 0;
+    uint64_t notifications = 0;
+    double totalUs = 0;
+    std::vector<double> samplesUs;
+};
+
+struct FanOutCase {
+    std::string name;
+    uint32_t mask = 0;
+    std::function<int32_t(TelephonyStateRegistryService &, int32_t)> update;
+};
+
+/**
+ * Observer living in the benchmark process, deliveries reach it without IPC so the figures are the cost of the
+ * service itself.
+ */
+class BenchmarkObserver : public TelephonyObserver {
+public:
+    void OnCallStateUpdated(int32_t slotId, int32_t callState, const std::u16string &phoneNumber) override
+    {
+        g_notifications.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnSignalInfoUpdated(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec) override
+    {
+        g_notifications.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnNetworkStateUpdated(int32_t slotId, const sptr<NetworkState> &networkState) override
+    {
+        g_notifications.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Threads kept alive across iterations, Run starts the task on every thread at once and returns when all are done.
+ */
+class ProducerGroup {
+public:
+    explicit ProducerGroup(int32_t threadCount)
+    {
+        for (int32_t i = 0; i < threadCount; i++) {
+            threads_.emplace_back([this, i]() { Loop(i); });
+        }
+    }
+
+    ~ProducerGroup()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            startCondition_.notify_all();
+        }
+        for (auto &thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void Run(const std::function<void(int32_t)> &task)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        task_ = &task;
+        pending_ = static_cast<int32_t>(threads_.size());
+        generation_++;
+        startCondition_.notify_all();
+        doneCondition_.wait(lock, [this] { return pending_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    void Loop(int32_t index)
+    {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            startCondition_.wait(lock, [this, seen] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+            const std::function<void(int32_t)> *task = task_;
+            lock.unlock();
+            (*task)(index);
+            lock.lock();
+            if (--pending_ == 0) {
+                doneCondition_.notify_one();
+            }
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable startCondition_;
+    std::condition_variable doneCondition_;
+    std::vector<std::thread> threads_;
+    const std::function<void(int32_t)> *task_ = nullptr;
+    uint64_t generation_ = 0;
+    int32_t pending_ = 0;
+    bool stopping_ = false;
+};
+
+double ElapsedUs(Clock::time_point begin)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+}
+
+double Percentile(const std::vector<double> &sorted, double rank)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(rank * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+std::vector<int32_t> ParseList(const std::string &value)
+{
+    std::vector<int32_t> list;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int32_t number = atoi(item.c_str());
+        if (number > 0) {
+            list.push_back(number);
+        }
+    }
+    return list;
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        size_t separator = arg.find('=');
+        std::string name = arg.substr(0, separator);
+        std::string value = separator == std::string::npos ? "" : arg.substr(separator + 1);
+        if (name == "--subscribers") {
+            options.subscribers = ParseList(value);
+        } else if (name == "--slots") {
+            options.slots = ParseList(value);
+        } else if (name == "--threads") {
+            options.threads = ParseList(value);
+        } else if (name == "--iterations") {
+            options.iterations = atoi(value.c_str());
+        } else if (name == "--register-iterations") {
+            options.registerIterations = atoi(value.c_str());
+        } else if (name == "--output") {
+            options.output = value;
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--subscribers=1,10,...] [--slots=1,2] [--threads=1,2,4]"
+                      << " [--iterations=N] [--register-iterations=N] [--output=file.json]" << std::endl;
+            return false;
+        }
+    }
+    return !options.subscribers.empty() && !options.slots.empty() && !options.threads.empty() &&
+        options.iterations > 0 && options.registerIterations > 0;
+}
+
+void ClearRecords(TelephonyStateRegistryService &service)
+{
+    service.FlushNotifications();
+    std::unique_lock<std::shared_mutex> lock(service.lock_);
+    service.stateRecords_.clear();
+    service.PublishSubscribers();
+}
+
+/**
+ * Add the records in one go, registering 10k observers through RegisterStateChange costs a snapshot rebuild each.
+ */
+void AddRecords(TelephonyStateRegistryService &service, uint32_t mask, int32_t subscribers, int32_t slots)
+{
+    std::unique_lock<std::shared_mutex> lock(service.lock_);
+    for (int32_t i = 0; i < subscribers; i++) {
+        TelephonyStateRegistryRecord record;
+        record.telephonyObserver_ = new BenchmarkObserver();
+        record.slotId_ = i % slots;
+        record.mask_ = mask;
+        record.pid_ = BENCHMARK_PID_BASE + i;
+        record.uid_ = BENCHMARK_UID;
+        record.tokenId_ = BENCHMARK_TOKEN_ID + i;
+        record.bundleName_ = BENCHMARK_BUNDLE_NAME;
+        service.stateRecords_.push_back(record);
+    }
+    service.PublishSubscribers();
+}
+
+int32_t UpdateSignalInfo(TelephonyStateRegistryService &service, int32_t slotId)
+{
+    // Every update carries a new value, unchanged ones are suppressed before the fan-out.
+    uint32_t sequence = g_sequence.fetch_add(1, std::memory_order_relaxed);
+    sptr<GsmSignalInformation> signal = sptr<GsmSignalInformation>::MakeSptr();
+    signal->SetValue(SIGNAL_RSSI_BASE - static_cast<int32_t>(sequence % SIGNAL_RSSI_RANGE), 0);
+    std::vector<sptr<SignalInformation>> vec { signal };
+    return service.UpdateSignalInfo(slotId, vec);
+}
+
+int32_t UpdateCallState(TelephonyStateRegistryService &service, int32_t slotId)
+{
+    uint32_t sequence = g_sequence.fetch_add(1, std::memory_order_relaxed);
+    return service.UpdateCallStateForSlotId(slotId, static_cast<int32_t>(sequence % CALL_STATE_COUNT),
+        Str8ToStr16(std::to_string(sequence)));
+}
+
+int32_t UpdateNetworkState(TelephonyStateRegistryService &service, int32_t slotId)
+{
+    uint32_t sequence = g_sequence.fetch_add(1, std::memory_order_relaxed);
+    sptr<NetworkState> networkState = sptr<NetworkState>::MakeSptr();
+    networkState->isEmergency_ = (sequence % 2) != 0;
+    return service.UpdateNetworkState(slotId, networkState);
+}
+
+void RunRegister(TelephonyStateRegistryService &service, const Options &options, int32_t subscribers,
+    int32_t threads, std::vector<Result> &results)
+{
+    Result registerResult { "RegisterStateChange", subscribers, 1, threads, options.registerIterations };
+    Result unregisterResult { "UnregisterStateChange", subscribers, 1, threads, options.registerIterations };
+    uint32_t mask = TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS;
+    std::vector<sptr<TelephonyObserverBroker>> observers;
+    for (int32_t i = 0; i < subscribers; i++) {
+        observers.push_back(new BenchmarkObserver());
+    }
+    ProducerGroup producers(threads);
+    auto registerTask = [&service, &observers, mask, subscribers, threads](int32_t index) {
+        for (int32_t i = index; i < subscribers; i += threads) {
+            service.RegisterStateChange(observers[i], 0, mask, BENCHMARK_BUNDLE_NAME, false,
+                BENCHMARK_PID_BASE + i, BENCHMARK_UID, BENCHMARK_TOKEN_ID + i, "");
+        }
+    };
+    auto unregisterTask = [&service, mask, subscribers, threads](int32_t index) {
+        for (int32_t i = index; i < subscribers; i += threads) {
+            service.UnregisterStateChange(0, mask, BENCHMARK_TOKEN_ID + i, BENCHMARK_PID_BASE + i);
+        }
+    };
+    for (int32_t iteration = 0; iteration < options.registerIterations; iteration++) {
+        auto begin = Clock::now();
+        producers.Run(registerTask);
+        registerResult.samplesUs.push_back(ElapsedUs(begin));
+        begin = Clock::now();
+        producers.Run(unregisterTask);
+        unregisterResult.samplesUs.push_back(ElapsedUs(begin));
+    }
+    for (auto *result : { &registerResult, &unregisterResult }) {
+        result->operations = static_cast<uint64_t>(subscribers) * options.registerIterations;
+        for (double sample : result->samplesUs) {
+            result->totalUs += sample;
+        }
+        results.push_back(std::move(*result));
+    }
+    ClearRecords(service);
+}
+
+void RunFanOut(TelephonyStateRegistryService &service, const Options &options, const FanOutCase &fanOutCase,
+    int32_t subscribers, int32_t slots, int32_t threads, std::vector<Result> &results)
+{
+    Result result { fanOutCase.name, subscribers, slots, threads, options.iterations };
+    AddRecords(service, fanOutCase.mask, subscribers, slots);
+    ProducerGroup producers(threads);
+    // A thread updates the slots of its stride, more threads than slots update the same slot concurrently.
+    std::atomic<uint64_t> updates { 0 };
+    auto task = [&service, &fanOutCase, &updates, slots, threads](int32_t index) {
+        for (int32_t slotId = index % slots; slotId < slots; slotId += threads) {
+            if (fanOutCase.update(service, slotId) == TELEPHONY_SUCCESS) {
+                updates.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+    for (int32_t iteration = 0; iteration < WARMUP_ITERATIONS; iteration++) {
+        producers.Run(task);
+        service.FlushNotifications();
+    }
+    updates = 0;
+    uint64_t notifications = g_notifications.load();
+    for (int32_t iteration = 0; iteration < options.iterations; iteration++) {
+        // Latency of an iteration is from the first update call until every observer received its notification.
+        auto begin = Clock::now();
+        producers.Run(task);
+        service.FlushNotifications();
+        double elapsedUs = ElapsedUs(begin);
+        result.samplesUs.push_back(elapsedUs);
+        result.totalUs += elapsedUs;
+    }
+    result.operations = updates.load();
+    result.notifications = g_notifications.load() - notifications;
+    results.push_back(std::move(result));
+    ClearRecords(service);
+}
+
+void WriteResult(std::ostream &out, Result &result)
+{
+    std::sort(result.samplesUs.begin(), result.samplesUs.end());
+    double opsPerSecond = result.totalUs > 0 ? result.operations * US_PER_SECOND / result.totalUs : 0;
+    double notificationsPerSecond = result.totalUs > 0 ? result.notifications * US_PER_SECOND / result.totalUs : 0;
+    double meanUs = result.samplesUs.empty() ? 0 : result.totalUs / result.samplesUs.size();
+    out << "    {\"name\": \"" << result.name << "\", \"subscribers\": " << result.subscribers
+        << ", \"slots\": " << result.slots << ", \"threads\": " << result.threads
+        << ", \"iterations\": " << result.iterations << ", \"operations\": " << result.operations
+        << ", \"notifications\": " << result.notifications << ", \"opsPerSecond\": " << opsPerSecond
+        << ", \"notificationsPerSecond\": " << notificationsPerSecond << ", \"meanUs\": " << meanUs
+        << ", \"p50Us\": " << Percentile(result.samplesUs, PERCENTILE_50)
+        << ", \"p90Us\": " << Percentile(result.samplesUs, PERCENTILE_90)
+        << ", \"p99Us\": " << Percentile(result.samplesUs, PERCENTILE_99)
+        << ", \"maxUs\": " << (result.samplesUs.empty() ? 0 : result.samplesUs.back()) << "}";
+}
+
+void WriteResults(std::ostream &out, const Options &options, int32_t slotSize, std::vector<Result> &results)
+{
+    out << "{\n  \"benchmark\": \"tel_state_registry_benchmark\",\n";
+    out << "  \"context\": {\"iterations\": " << options.iterations << ", \"registerIterations\": "
+        << options.registerIterations << ", \"slotSize\": " << slotSize << ", \"hardwareConcurrency\": "
+        << std::thread::hardware_concurrency() << "},\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        WriteResult(out, results[i]);
+        out << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+std::vector<Result> RunAll(TelephonyStateRegistryService &service, const Options &options)
+{
+    std::vector<FanOutCase> fanOutCases = {
+        { "UpdateSignalInfo", TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, UpdateSignalInfo },
+        { "UpdateCallStateForSlotId", TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE, UpdateCallState },
+        { "UpdateNetworkState", TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, UpdateNetworkState },
+    };
+    std::vector<Result> results;
+    for (int32_t subscribers : options.subscribers) {
+        for (int32_t threads : options.threads) {
+            RunRegister(service, options, subscribers, threads, results);
+        }
+    }
+    for (const auto &fanOutCase : fanOutCases) {
+        for (int32_t subscribers : options.subscribers) {
+            for (int32_t slots : options.slots) {
+                // Update paths reject the slots the device does not have.
+                if (slots > service.slotSize_) {
+                    continue;
+                }
+                for (int32_t threads : options.threads) {
+                    RunFanOut(service, options, fanOutCase, subscribers, slots, threads, results);
+                }
+            }
+        }
+    }
+    return results;
+}
+} // namespace
+} // namespace Telephony
+} // namespace OHOS
+
+int main(int argc, char *argv[])
+{
+    using namespace OHOS::Telephony;
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+    auto permission = MockTelephonyPermission::GetOrCreateMockTelephonyPermission();
+    EXPECT_CALL(*permission, CheckPermission(testing::_)).WillRepeatedly(testing::Return(true));
+    auto service = OHOS::DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    if (service == nullptr) {
+        std::cerr << "create TelephonyStateRegistryService failed" << std::endl;
+        return 1;
+    }
+    std::vector<Result> results = RunAll(*service, options);
+    if (options.output.empty()) {
+        WriteResults(std::cout, options, service->slotSize_, results);
+    } else {
+        std::ofstream out(options.output);
+        WriteResults(out, options, service->slotSize_, results);
+    }
+    service->FlushNotifications();
+    MockTelephonyPermission::ReleaseMockTelephonyPermission();
+    return 0;
+}
@@ -21,10 +21,12 @@
 #include "sim_state_type.h"
 #include "state_registry_test.h"
 #include "telephony_ext_wrapper.h"
+#include "telephony_event_ring_reader.h"
 #include "telephony_log_wrapper.h"
 #include "telephony_observer_client.h"
 #include "telephony_observer_proxy.h"
 #include "telephony_state_manager.h"
+#include "telephony_state_page_reader.h"
 #include "telephony_state_registry_client.h"
 #include "telephony_state_registry_proxy.h"
 #include "telephony_state_registry_service.h"
@@ -208,6 +210,7 @@ HWTEST_F(StateRegistryBranchTest, TelephonyStateRegistryService_UpdateIccAccount
     service->stateRecords_.push_back(record);
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT;
     service->stateRecords_[0].telephonyObserver_ = nullptr;
+    service->RefreshSubscribers();
     auto result = service->UpdateIccAccount();
     ASSERT_EQ(result, TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST);
 }
@@ -228,6 +231,7 @@ HWTEST_F(StateRegistryBranchTest, TelephonyStateRegistryService_UpdateIccAccount
     service->stateRecords_.push_back(record);
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT;
     service->stateRecords_[0].telephonyObserver_ = std::make_unique<TelephonyObserver>().release();
+    service->RefreshSubscribers();
     auto result = service->UpdateIccAccount();
     ASSERT_EQ(result, TELEPHONY_SUCCESS);
 }
@@ -247,6 +251,7 @@ HWTEST_F(StateRegistryBranchTest, TelephonyStateRegistryService_UpdateIccAccount
     TelephonyStateRegistryRecord record;
     service->stateRecords_.push_back(record);
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE;
+    service->RefreshSubscribers();
     auto result = service->UpdateIccAccount();
     ASSERT_EQ(result, TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST);
 }
@@ -287,18 +292,22 @@ HWTEST_F(StateRegistryBranchTest, Service_UnregisterStateChange_001, TestSize.Le
     TelephonyStateRegistryRecord record;
     service->stateRecords_.push_back(record);
     service->stateRecords_[0].slotId_ = 1;
+    service->RefreshSubscribers();
     pid_t pid = -1;
     auto result = service->UnregisterStateChange(0, TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO, 0, pid);
     ASSERT_EQ(result, TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST);
     service->stateRecords_[0].slotId_ = 0;
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    service->RefreshSubscribers();
     result = service->UnregisterStateChange(0, TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO, 0, pid);
     ASSERT_EQ(result, TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST);
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO;
     service->stateRecords_[0].tokenId_ = 1234;
+    service->RefreshSubscribers();
     result = service->UnregisterStateChange(0, TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO, 0, pid);
     ASSERT_EQ(result, TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST);
     service->stateRecords_[0].pid_ = 1;
+    service->RefreshSubscribers();
     result = service->UnregisterStateChange(0, TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO, 1234, pid);
     ASSERT_EQ(result, TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST);
 }
@@ -372,9 +381,11 @@ HWTEST_F(StateRegistryBranchTest, UpdateSimActiveState_WithPermissionAndObserver
     record.mask_ = TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE;
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateSimActiveState(slotId, true));
     service->stateRecords_.push_back(record);
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateSimActiveState(slotId, true));
     service->stateRecords_.pop_back();
-    service->simActiveResult_.erase(slotId);
+    service->RefreshSubscribers();
+    service->slotStates_->Invalidate(slotId, SlotStateField::SIM_ACTIVE_STATE);
 }
 
 /**
@@ -393,16 +404,20 @@ HWTEST_F(StateRegistryBranchTest, Service_UpdateSimActiveState_WithPermission, F
     recordWithOtherSlotId.slotId_ = 1;
     recordWithOtherSlotId.mask_ = TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE;
     service->stateRecords_.push_back(recordWithOtherSlotId);
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateSimActiveState(slotId, true));
     service->stateRecords_.pop_back();
+    service->RefreshSubscribers();
 
     TelephonyStateRegistryRecord recordNoObserver;
     recordNoObserver.slotId_ = slotId;
     recordNoObserver.mask_ = TelephonyObserverBroker::OBSERVER_MASK_SIM_ACTIVE_STATE;
     service->stateRecords_.push_back(recordNoObserver);
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateSimActiveState(slotId, true));
     service->stateRecords_.pop_back();
-    service->simActiveResult_.erase(slotId);
+    service->RefreshSubscribers();
+    service->slotStates_->Invalidate(slotId, SlotStateField::SIM_ACTIVE_STATE);
 }
 
 /**
@@ -425,9 +440,8 @@ HWTEST_F(StateRegistryBranchTest, Service_UpdateSimActiveState_WithoutPermission
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_SLODID_ERROR, service->UpdateSimActiveState(invalidSlotId, false));
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED, service->UpdateSimActiveState(0, true));
     service->UpdateData(record);
-    auto iter = service->simActiveResult_.find(record.slotId_);
-    EXPECT_TRUE(iter != service->simActiveResult_.end());
-    service->simActiveResult_.erase(record.slotId_);
+    int32_t simActiveState = 0;
+    EXPECT_FALSE(service->slotStates_->Read(record.slotId_, SlotStateField::SIM_ACTIVE_STATE, simActiveState));
 }
 
 /**
@@ -516,5 +530,576 @@ HWTEST_F(StateRegistryBranchTest, Client_UpdateSimActiveState, Function | Medium
         slotId, enable);
     EXPECT_NE(ret, TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL);
 }
+
+/**
+ * @tc.number   TelephonyStateRegistryService_RemoveObserverRecords_001
+ * @tc.name     telephony state registry service remove observer records test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, TelephonyStateRegistryService_RemoveObserverRecords_001, TestSize.Level0)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    sptr<TelephonyObserverBroker> observer = std::make_unique<StateRegistryObserver>().release();
+    TelephonyStateRegistryRecord record;
+    record.telephonyObserver_ = observer;
+    record.mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    {
+        std::unique_lock<std::shared_mutex> lock(service->lock_);
+        service->stateRecords_.push_back(record);
+        record.slotId_ = 1;
+        service->stateRecords_.push_back(record);
+        EXPECT_TRUE(service->HasObserverRecord(observer->AsObject()));
+    }
+    uint64_t purgedRecords = service->GetObserverPurgeStats().purgedRecords;
+    EXPECT_EQ(service->RemoveObserverRecords(observer->AsObject()), 2u);
+    EXPECT_EQ(service->RemoveObserverRecords(observer->AsObject()), 0u);
+    EXPECT_EQ(service->GetObserverPurgeStats().purgedRecords, purgedRecords + 2);
+    std::unique_lock<std::shared_mutex> lock(service->lock_);
+    EXPECT_FALSE(service->HasObserverRecord(observer->AsObject()));
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryStub_BatchUpdate_001
+ * @tc.name     telephony state registry service stub batch update test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Stub_BatchUpdate_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    TelephonyObserverUpdateBatch batch;
+    int32_t slotId = 0;
+    EXPECT_TRUE(batch.AddCellularDataConnectState(slotId, 1, 1));
+    EXPECT_TRUE(batch.AddCellularDataFlow(slotId, 1));
+    EXPECT_EQ(batch.GetEntryCount(), 2);
+    MessageOption option;
+
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(false));
+    MessageParcel deniedData;
+    MessageParcel deniedReply;
+    ASSERT_TRUE(deniedData.WriteInterfaceToken(TelephonyStateRegistryStub::GetDescriptor()));
+    ASSERT_TRUE(batch.Marshalling(deniedData));
+    auto ret = service->OnRemoteRequest(static_cast<uint32_t>(StateNotifyInterfaceCodeEx::BATCH_UPDATE),
+        deniedData, deniedReply, option);
+    EXPECT_EQ(ret, NO_ERROR);
+    EXPECT_EQ(deniedReply.ReadInt32(), TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED);
+
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    uint64_t batches = service->GetBatchUpdateStats().batches;
+    MessageParcel dataParcel;
+    MessageParcel reply;
+    ASSERT_TRUE(dataParcel.WriteInterfaceToken(TelephonyStateRegistryStub::GetDescriptor()));
+    ASSERT_TRUE(batch.Marshalling(dataParcel));
+    ret = service->OnRemoteRequest(static_cast<uint32_t>(StateNotifyInterfaceCodeEx::BATCH_UPDATE),
+        dataParcel, reply, option);
+    EXPECT_EQ(ret, NO_ERROR);
+    int32_t result = reply.ReadInt32();
+    EXPECT_TRUE(result == TELEPHONY_SUCCESS || result == TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST);
+    EXPECT_EQ(reply.ReadInt32(), batch.GetEntryCount());
+    EXPECT_EQ(service->GetBatchUpdateStats().batches, batches + 1);
+    service->FlushNotifications();
+}
+
+static std::atomic<int32_t> g_batchHookRecordCount { 0 };
+
+static void CellularDataConnectStateBatchHook(int32_t slotId, const std::vector<TelephonyStateRegistryRecord> &records,
+    const int32_t &networkType, std::vector<int32_t> &variants, std::vector<int32_t> &variantIndexes)
+{
+    g_batchHookRecordCount += static_cast<int32_t>(records.size());
+    variants.push_back(networkType + 1);
+    variantIndexes.assign(records.size(), 0);
+}
+
+/**
+ * @tc.number   Service_ExtBatchHook_001
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_ExtBatchHook_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    TelephonyStateRegistryRecord record;
+    record.telephonyObserver_ = std::make_unique<TelephonyObserver>().release();
+    record.slotId_ = slotId;
+    record.mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE;
+    service->stateRecords_.push_back(record);
+    service->stateRecords_.push_back(record);
+    service->RefreshSubscribers();
+    service->slotStates_->Invalidate(slotId, SlotStateField::DATA_CONNECTION_STATE);
+
+    auto hook = TelephonyExtWrapper::Hook::CELLULAR_DATA_CONNECT_STATE_UPDATE;
+    uint64_t calls = TELEPHONY_EXT_WRAPPER.GetHookStats(hook).calls;
+    g_batchHookRecordCount = 0;
+    TELEPHONY_EXT_WRAPPER.onCellularDataConnectStateUpdatedBatch_ = CellularDataConnectStateBatchHook;
+    EXPECT_EQ(TELEPHONY_SUCCESS,
+        service->UpdateCellularDataConnectState(slotId, DATA_STATE_CONNECTING, NETWORK_TYPE_GSM));
+    service->FlushNotifications();
+    // One call for both records.
+    EXPECT_EQ(2, g_batchHookRecordCount.load());
+    EXPECT_EQ(calls + 1, TELEPHONY_EXT_WRAPPER.GetHookStats(hook).calls);
+
+    TELEPHONY_EXT_WRAPPER.onCellularDataConnectStateUpdatedBatch_ = nullptr;
+    service->stateRecords_.pop_back();
+    service->stateRecords_.pop_back();
+    service->RefreshSubscribers();
+    service->slotStates_->Invalidate(slotId, SlotStateField::DATA_CONNECTION_STATE);
+}
+
+class InitialStateObserver : public TelephonyObserver {
+public:
+    explicit InitialStateObserver(std::shared_mutex &registryLock) : registryLock_(registryLock) {}
+
+    void OnCellularDataFlowUpdated(int32_t slotId, int32_t dataFlowType) override
+    {
+        // The registration has released the lock of the service when the initial state arrives.
+        if (registryLock_.try_lock()) {
+            registryLock_.unlock();
+            unlockedCount_++;
+        }
+        count_++;
+    }
+
+    std::shared_mutex &registryLock_;
+    std::atomic<int32_t> count_ { 0 };
+    std::atomic<int32_t> unlockedCount_ { 0 };
+};
+
+/**
+ * @tc.number   Service_RegisterInitialState_001
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_RegisterInitialState_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    uint32_t mask = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    sptr<InitialStateObserver> observer = new InitialStateObserver(service->lock_);
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(observer, slotId, mask, "", true, 0, 0, 0, ""));
+    service->FlushNotifications();
+    EXPECT_EQ(1, observer->count_.load());
+    EXPECT_EQ(1, observer->unlockedCount_.load());
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(observer, slotId, mask, "", false, 0, 0, 0, ""));
+    service->FlushNotifications();
+    EXPECT_EQ(1, observer->count_.load());
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->UnregisterStateChange(slotId, mask, 0, 0));
+}
+/**
+ * @tc.number   Service_ModifyObserverMask_001
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_ModifyObserverMask_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    uint32_t dataFlow = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    uint32_t dataState = TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE;
+    sptr<TelephonyObserverBroker> observer = std::make_unique<TelephonyObserver>().release();
+    EXPECT_EQ(TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST,
+        service->ModifyObserverMask(slotId, dataFlow, dataState, 0, false, 0, 0));
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(observer, slotId, dataFlow, "", false, 0, 0, 0, ""));
+    size_t count = service->stateRecords_.size();
+    EXPECT_EQ(TELEPHONY_ERR_ARGUMENT_INVALID,
+        service->ModifyObserverMask(slotId, dataFlow, dataState, dataState, false, 0, 0));
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->ModifyObserverMask(slotId, dataFlow, dataState, 0, true, 0, 0));
+    service->FlushNotifications();
+    EXPECT_EQ(count, service->stateRecords_.size());
+    EXPECT_EQ(dataFlow | dataState, service->stateRecords_.back().mask_);
+    auto subscribers = service->GetSubscribers();
+    std::vector<uint32_t> positions;
+    service->MatchSubscribers(subscribers->index.Find(dataState, { slotId }), *subscribers, positions);
+    EXPECT_FALSE(positions.empty());
+
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->ModifyObserverMask(slotId, dataFlow | dataState, 0, dataFlow, false, 0, 0));
+    EXPECT_EQ(dataState, service->stateRecords_.back().mask_);
+    // Removing the last bit removes the record.
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->ModifyObserverMask(slotId, dataState, 0, dataState, false, 0, 0));
+    EXPECT_EQ(count - 1, service->stateRecords_.size());
+}
+
+/**
+ * @tc.number   Service_BulkRegister_001
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_BulkRegister_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    uint32_t dataFlow = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    uint32_t dataState = TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE;
+    sptr<TelephonyObserverBroker> observer = std::make_unique<TelephonyObserver>().release();
+    TelephonyStateRegistryRecord caller;
+    caller.pid_ = 1;
+    caller.tokenId_ = 1;
+    std::vector<TelephonyObserverRegistration> registrations = {
+        { observer, slotId, dataFlow, true },
+        { observer, slotId, dataState, true },
+        { observer, slotId, dataFlow, false },
+        { nullptr, slotId, dataFlow, false },
+        { observer, 100, dataFlow, false },
+    };
+    size_t count = service->stateRecords_.size();
+    std::vector<int32_t> results;
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChanges(registrations, caller, results));
+    service->FlushNotifications();
+    ASSERT_EQ(registrations.size(), results.size());
+    EXPECT_EQ(TELEPHONY_SUCCESS, results[2]);
+    EXPECT_EQ(TELEPHONY_ERR_ARGUMENT_INVALID, results[3]);
+    EXPECT_EQ(TELEPHONY_STATE_REGISTRY_SLODID_ERROR, results[4]);
+    // The duplicate pair does not add a record.
+    EXPECT_EQ(count + 2, service->stateRecords_.size());
+
+    // Both requests of a duplicate pair report the removal of its record.
+    registrations.resize(1);
+    registrations.push_back(registrations[0]);
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->UnregisterStateChanges(registrations, caller.tokenId_, caller.pid_, results));
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(TELEPHONY_SUCCESS, results[0]);
+    EXPECT_EQ(TELEPHONY_SUCCESS, results[1]);
+    EXPECT_EQ(count + 1, service->stateRecords_.size());
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->UnregisterAllStateChanges(caller.tokenId_, caller.pid_));
+    EXPECT_EQ(count, service->stateRecords_.size());
+    EXPECT_EQ(TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST,
+        service->UnregisterAllStateChanges(caller.tokenId_, caller.pid_));
+}
+
+/**
+ * @tc.number   Service_GetStateSnapshot_001
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_GetStateSnapshot_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    int32_t tokenId = 1;
+    std::vector<TelephonyStateSnapshot> snapshots;
+    EXPECT_EQ(TELEPHONY_STATE_REGISTRY_SLODID_ERROR, service->GetStateSnapshot(MAX_SLOT_COUNT + 1, tokenId, snapshots));
+
+    service->UpdateCellularDataFlow(slotId, 1);
+    service->UpdateCellularDataFlow(slotId, 2);
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->GetStateSnapshot(slotId, tokenId, snapshots));
+    ASSERT_EQ(1u, snapshots.size());
+    EXPECT_EQ(slotId, snapshots[0].slotId);
+    ASSERT_TRUE(snapshots[0].Has(TelephonyStateSnapshot::Field::DATA_FLOW));
+    EXPECT_EQ(2, snapshots[0].Get(TelephonyStateSnapshot::Field::DATA_FLOW));
+    uint64_t sequence = snapshots[0].GetSequence(TelephonyStateSnapshot::Field::DATA_FLOW);
+    EXPECT_GT(sequence, 0u);
+
+    service->UpdateCellularDataFlow(slotId, 1);
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->GetStateSnapshot(TelephonyStateSnapshot::ALL_SLOTS, tokenId, snapshots));
+    auto it = std::find_if(snapshots.begin(), snapshots.end(),
+        [slotId](const TelephonyStateSnapshot &snapshot) { return snapshot.slotId == slotId; });
+    ASSERT_TRUE(it != snapshots.end());
+    EXPECT_EQ(1, it->Get(TelephonyStateSnapshot::Field::DATA_FLOW));
+    EXPECT_GT(it->GetSequence(TelephonyStateSnapshot::Field::DATA_FLOW), sequence);
+
+    MessageParcel parcel;
+    ASSERT_TRUE(it->Marshalling(parcel));
+    TelephonyStateSnapshot copy;
+    ASSERT_TRUE(copy.ReadFromParcel(parcel));
+    EXPECT_EQ(it->fields, copy.fields);
+    EXPECT_EQ(it->GetSequence(TelephonyStateSnapshot::Field::DATA_FLOW),
+        copy.GetSequence(TelephonyStateSnapshot::Field::DATA_FLOW));
+}
+
+/**
+ * @tc.number   Service_RegisterSinceSequence_001
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_RegisterSinceSequence_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    uint32_t mask = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    sptr<InitialStateObserver> observer = new InitialStateObserver(service->lock_);
+    TelephonyStateRegistryRecord caller;
+    caller.pid_ = 1;
+    caller.tokenId_ = 1;
+    service->UpdateCellularDataFlow(slotId, 1);
+    service->UpdateCellularDataFlow(slotId, 2);
+    uint64_t sequence = service->slotStates_->GetVersion();
+    EXPECT_GT(sequence, 0u);
+
+    // Nothing changed since the sequence, the initial state is not notified.
+    std::vector<TelephonyObserverRegistration> registrations = { { observer, slotId, mask, true, sequence } };
+    std::vector<int32_t> results;
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChanges(registrations, caller, results));
+    service->FlushNotifications();
+    EXPECT_EQ(0, observer->count_.load());
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->UnregisterAllStateChanges(caller.tokenId_, caller.pid_));
+
+    service->UpdateCellularDataFlow(slotId, 1);
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChanges(registrations, caller, results));
+    service->FlushNotifications();
+    EXPECT_EQ(1, observer->count_.load());
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->UnregisterAllStateChanges(caller.tokenId_, caller.pid_));
+}
+
+/**
+ * @tc.number   Service_GetStatePage_001
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_GetStatePage_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    service->UpdateCellularDataFlow(slotId, 1);
+    sptr<Ashmem> ashmem = nullptr;
+    ASSERT_EQ(TELEPHONY_SUCCESS, service->GetStatePage(ashmem));
+    auto reader = TelephonyStatePageReader::Create(ashmem);
+    ASSERT_TRUE(reader != nullptr);
+    TelephonyStateSnapshot snapshot;
+    ASSERT_TRUE(reader->Read(slotId, snapshot));
+    EXPECT_EQ(1, snapshot.Get(TelephonyStateSnapshot::Field::DATA_FLOW));
+    uint64_t sequence = snapshot.GetSequence(TelephonyStateSnapshot::Field::DATA_FLOW);
+    EXPECT_GT(sequence, 0u);
+
+    // The page follows the later updates without any request.
+    service->UpdateCellularDataFlow(slotId, 2);
+    ASSERT_TRUE(reader->Read(slotId, snapshot));
+    EXPECT_EQ(2, snapshot.Get(TelephonyStateSnapshot::Field::DATA_FLOW));
+    EXPECT_GT(snapshot.GetSequence(TelephonyStateSnapshot::Field::DATA_FLOW), sequence);
+    EXPECT_FALSE(snapshot.Has(TelephonyStateSnapshot::Field::CALL_INCOMING_NUMBER));
+    EXPECT_FALSE(reader->Read(MAX_SLOT_COUNT + 1, snapshot));
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryService_UpdateCellInfo_001
+ * @tc.name     Get System Services
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, TelephonyStateRegistryService_UpdateCellInfo_001, TestSize.Level0)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_NE(service, nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    auto records = service->stateRecords_;
+    TelephonyStateRegistryRecord record;
+    record.slotId_ = 0;
+    record.mask_ = TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO;
+    record.telephonyObserver_ = std::make_unique<TelephonyObserver>().release();
+    service->stateRecords_.push_back(record);
+    record.telephonyObserver_ = nullptr;
+    service->stateRecords_.push_back(record);
+    service->RefreshSubscribers();
+    // The record without an observer is skipped, the other one is notified.
+    std::vector<sptr<CellInformation>> vecCellInfo;
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCellInfo(0, vecCellInfo));
+    service->FlushNotifications();
+    service->stateRecords_ = records;
+    service->RefreshSubscribers();
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryStub_BatchUpdate_002
+ * @tc.name     telephony state registry service stub batch update entry result test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Stub_BatchUpdate_002, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*permission_, CheckPermission(Permission::CELL_LOCATION)).WillRepeatedly(Return(false));
+    std::vector<sptr<SignalInformation>> signals;
+    signals.push_back(new GsmSignalInformation());
+    std::vector<sptr<CellInformation>> cells;
+    cells.push_back(new GsmCellInformation());
+    TelephonyObserverUpdateBatch batch;
+    int32_t invalidSlotId = 100;
+    EXPECT_TRUE(batch.AddSignalInfo(invalidSlotId, signals));
+    EXPECT_TRUE(batch.AddCellInfo(0, cells));
+    int32_t dataFlow = service->GetCellularDataFlow(0);
+    EXPECT_TRUE(batch.AddCellularDataFlow(0, dataFlow + 1));
+    MessageParcel dataParcel;
+    MessageParcel reply;
+    MessageOption option;
+    ASSERT_TRUE(dataParcel.WriteInterfaceToken(TelephonyStateRegistryStub::GetDescriptor()));
+    ASSERT_TRUE(batch.Marshalling(dataParcel));
+    auto ret = service->OnRemoteRequest(static_cast<uint32_t>(StateNotifyInterfaceCodeEx::BATCH_UPDATE),
+        dataParcel, reply, option);
+    EXPECT_EQ(ret, NO_ERROR);
+    EXPECT_EQ(reply.ReadInt32(), TELEPHONY_STATE_REGISTRY_SLODID_ERROR);
+    ASSERT_EQ(reply.ReadInt32(), batch.GetEntryCount());
+    EXPECT_EQ(reply.ReadInt32(), TELEPHONY_STATE_REGISTRY_SLODID_ERROR);
+    EXPECT_EQ(reply.ReadInt32(), TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED);
+    // The valid entry is not applied either, it reports the failure of the batch.
+    EXPECT_EQ(reply.ReadInt32(), TELEPHONY_STATE_REGISTRY_SLODID_ERROR);
+    EXPECT_EQ(dataFlow, service->GetCellularDataFlow(0));
+    service->FlushNotifications();
+}
+
+/**
+ * @tc.number   Service_ModifyObserverMask_002
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_ModifyObserverMask_002, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    uint32_t dataFlow = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    uint32_t dataState = TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE;
+    sptr<TelephonyObserverBroker> first = std::make_unique<TelephonyObserver>().release();
+    sptr<TelephonyObserverBroker> second = std::make_unique<TelephonyObserver>().release();
+    size_t count = service->stateRecords_.size();
+    EXPECT_EQ(TELEPHONY_SUCCESS,
+        service->RegisterStateChange(first, slotId, dataFlow | dataState, "", false, 0, 0, 0, ""));
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(second, slotId, dataState, "", false, 0, 0, 0, ""));
+    TelephonyObserverDeliveryPolicy policy;
+    policy.minIntervalMs = 1000;
+    ASSERT_EQ(TELEPHONY_SUCCESS, service->SetDeliveryPolicy(slotId, dataFlow | dataState, 0, 0, policy));
+    // The resulting mask belongs to another observer of the caller, the record is left as it is.
+    EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_EXIST,
+        service->ModifyObserverMask(slotId, dataFlow | dataState, 0, dataFlow, true, 0, 0));
+    ASSERT_EQ(count + 2, service->stateRecords_.size());
+    size_t firstCount = 0;
+    for (const auto &record : service->stateRecords_) {
+        if (record.telephonyObserver_ == first) {
+            EXPECT_EQ(dataFlow | dataState, record.mask_);
+            firstCount++;
+        }
+    }
+    EXPECT_EQ(1u, firstCount);
+    EXPECT_EQ(1u, service->throttles_.count({ slotId, dataFlow | dataState, 0, 0 }));
+    // The records of the two observers are still removed one by one.
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->UnregisterStateChange(slotId, dataState, 0, 0));
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->UnregisterStateChange(slotId, dataFlow | dataState, 0, 0));
+    EXPECT_EQ(count, service->stateRecords_.size());
+}
+
+/**
+ * @tc.number   Service_GetStatePage_002
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_GetStatePage_002, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    service->UpdateCellularDataFlow(slotId, 1);
+    service->UpdateSimActiveState(slotId, true);
+    // A caller which can not observe every field maps a page limited to the fields it can observe.
+    EXPECT_CALL(*permission_, CheckPermission(Permission::SET_TELEPHONY_STATE)).WillRepeatedly(Return(false));
+    sptr<Ashmem> ashmem = nullptr;
+    ASSERT_EQ(TELEPHONY_SUCCESS, service->GetStatePage(ashmem));
+    auto reader = TelephonyStatePageReader::Create(ashmem);
+    ASSERT_TRUE(reader != nullptr);
+    TelephonyStateSnapshot snapshot;
+    ASSERT_TRUE(reader->Read(slotId, snapshot));
+    EXPECT_EQ(1, snapshot.Get(TelephonyStateSnapshot::Field::DATA_FLOW));
+    EXPECT_FALSE(snapshot.Has(TelephonyStateSnapshot::Field::SIM_ACTIVE_STATE));
+    EXPECT_CALL(*permission_, CheckPermission(Permission::SET_TELEPHONY_STATE)).WillRepeatedly(Return(true));
+    service->UpdateCellularDataFlow(slotId, 2);
+    ASSERT_TRUE(reader->Read(slotId, snapshot));
+    EXPECT_EQ(2, snapshot.Get(TelephonyStateSnapshot::Field::DATA_FLOW));
+
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(false));
+    EXPECT_NE(TELEPHONY_SUCCESS, service->GetStatePage(ashmem));
+}
+
+/**
+ * @tc.number   Service_GetEventRing_001
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_GetEventRing_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    int32_t slotId = 0;
+    uint32_t mask = TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO;
+    sptr<Ashmem> ashmem = nullptr;
+    EXPECT_EQ(TELEPHONY_ERR_ARGUMENT_INVALID, service->GetEventRing(slotId, mask, nullptr, ashmem));
+    sptr<IRemoteObject> client = new (std::nothrow) IPCObjectStub(u"test");
+    ASSERT_EQ(TELEPHONY_SUCCESS, service->GetEventRing(slotId, mask, client, ashmem));
+    auto reader = TelephonyEventRingReader::Create(ashmem);
+    ASSERT_TRUE(reader != nullptr);
+    // The ring is written by the dispatcher even with no observer of the event.
+    std::vector<sptr<CellInformation>> cellInfos;
+    service->UpdateCellInfo(slotId, cellInfos);
+    service->FlushNotifications();
+    EXPECT_TRUE(reader->Wait(0));
+    // The ring is dropped with its last client.
+    service->OnEventRingClientDied(client);
+    EXPECT_TRUE(service->FindEventRing(slotId, mask) == nullptr);
+}
+
+
+/**
+ * @tc.number   Service_IsRepeatedUpdate_001
+ * @tc.name     telephony state registry service test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryBranchTest, Service_IsRepeatedUpdate_001, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    ASSERT_TRUE(permission_ != nullptr);
+    EXPECT_CALL(*permission_, CheckPermission(_)).WillRepeatedly(Return(true));
+    auto records = service->stateRecords_;
+    auto changeFilter = std::move(service->changeFilter_);
+    service->changeFilter_ = std::make_unique<TelephonyStateRegistryChangeFilter>(1);
+    service->stateRecords_.clear();
+    service->RefreshSubscribers();
+    int32_t slotId = 0;
+    uint32_t event = TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS;
+    uint64_t fingerprint = 1;
+    uint64_t version = 1;
+    service->changeFilter_->BeginCommit(event, slotId);
+    service->changeFilter_->EndCommit(event, slotId, version);
+    ASSERT_TRUE(service->changeFilter_->SetFingerprint(event, slotId, version, fingerprint));
+    // A repeated parcel gets the result of the repeated update, whether the event has subscribers.
+    int32_t result = TELEPHONY_SUCCESS;
+    EXPECT_TRUE(service->IsRepeatedUpdate(event, slotId, fingerprint, result));
+    EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, result);
+    sptr<TelephonyObserverBroker> observer = std::make_unique<TelephonyObserver>().release();
+    ASSERT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(observer, slotId, event, "", false, 0, 0, 0, ""));
+    EXPECT_TRUE(service->IsRepeatedUpdate(event, slotId, fingerprint, result));
+    EXPECT_EQ(TELEPHONY_SUCCESS, result);
+    service->changeFilter_ = std::move(changeFilter);
+    service->stateRecords_ = records;
+    service->RefreshSubscribers();
+}
+
 } // namespace Telephony
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
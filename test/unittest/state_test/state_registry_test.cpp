@@ -13,18 +13,27 @@
  * limitations under the License.
  */
 
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
 #define private public
 #define protected public
 #include "state_registry_test.h"
 
 #include "core_service_client.h"
 #include "sim_state_type.h"
+#include "telephony_event_ring_reader.h"
 #include "telephony_ext_wrapper.h"
 #include "telephony_log_wrapper.h"
 #include "telephony_observer_client.h"
 #include "telephony_observer_proxy.h"
+#include "telephony_permission.h"
 #include "telephony_state_manager.h"
+#include "telephony_state_multiplexer.h"
 #include "telephony_state_registry_client.h"
+#include "telephony_state_registry_event_ring.h"
+#include "telephony_state_registry_payload.h"
 #include "telephony_state_registry_service.h"
 
 namespace OHOS {
@@ -927,25 +936,26 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_001, Function | Me
     EXPECT_EQ(TELEPHONY_ERROR, service->GetCardType(0));
     EXPECT_EQ(TELEPHONY_ERROR, service->GetCallState(0));
     EXPECT_EQ(TELEPHONY_ERROR, service->GetSimState(0));
-    service->simReason_[0] = LockReason::SIM_NONE;
+    service->slotStates_->Write(0, { { SlotStateField::LOCK_REASON, static_cast<int32_t>(LockReason::SIM_NONE) } });
     EXPECT_EQ(TELEPHONY_ERROR, service->GetLockReason(1));
     EXPECT_NE(TELEPHONY_ERROR, service->GetLockReason(0));
-    service->cellularDataConnectionNetworkType_[0] = 0;
+    service->slotStates_->Write(0, { { SlotStateField::DATA_CONNECTION_NETWORK_TYPE, 0 } });
     EXPECT_EQ(TELEPHONY_ERROR, service->GetCellularDataConnectionNetworkType(1));
     EXPECT_EQ(0, service->GetCellularDataConnectionNetworkType(0));
-    service->cellularDataFlow_[0] = 0;
+    service->slotStates_->Write(0, { { SlotStateField::DATA_FLOW, 0 } });
     EXPECT_EQ(TELEPHONY_ERROR, service->GetCellularDataFlow(1));
     EXPECT_EQ(0, service->GetCellularDataFlow(0));
-    service->cellularDataConnectionState_[0] = 0;
+    service->slotStates_->Write(0, { { SlotStateField::DATA_CONNECTION_STATE, 0 } });
     EXPECT_EQ(TELEPHONY_ERROR, service->GetCellularDataConnectionState(1));
     EXPECT_EQ(0, service->GetCellularDataConnectionState(0));
-    service->cardType_[0] = CardType::UNKNOWN_CARD;
+    service->slotStates_->Write(0, { { SlotStateField::CARD_TYPE, static_cast<int32_t>(CardType::UNKNOWN_CARD) } });
     EXPECT_EQ(TELEPHONY_ERROR, service->GetCardType(1));
     EXPECT_EQ(TELEPHONY_ERROR, service->GetCardType(0));
-    service->callState_[0] = 0;
+    service->slotStates_->Write(0, { { SlotStateField::CALL_STATE, 0 } });
     EXPECT_EQ(TELEPHONY_ERROR, service->GetCallState(1));
     EXPECT_EQ(0, service->GetCallState(0));
-    service->simState_[0] = SimState::SIM_STATE_UNKNOWN;
+    service->slotStates_->Write(
+        0, { { SlotStateField::SIM_STATE, static_cast<int32_t>(SimState::SIM_STATE_UNKNOWN) } });
     EXPECT_EQ(TELEPHONY_ERROR, service->GetSimState(1));
     EXPECT_EQ(0, service->GetSimState(0));
 }
@@ -1026,14 +1036,19 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_003, Function | Me
     service->stateRecords_.push_back(record);
     service->stateRecords_[0].tokenId_ = 123456789;
     service->stateRecords_[0].pid_ = 1234;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UnregisterStateChange(0, 0, tokenId, pid));
     service->stateRecords_[0].tokenId_ = 123456788;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST, service->UnregisterStateChange(0, 0, tokenId, pid));
     service->stateRecords_[0].tokenId_ = -1;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST, service->UnregisterStateChange(0, 0, tokenId, pid));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST, service->UnregisterStateChange(0, 0, tokenId, pid));
     service->stateRecords_[0].slotId_ = 1;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST, service->UnregisterStateChange(0, 0, tokenId, pid));
 }
 
@@ -1059,18 +1074,23 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_004, Function | Me
         service->RegisterStateChange(telephonyObserver, 0, mask, "", true, 0, 0, 0, ""));
     TelephonyStateRegistryRecord record;
     service->stateRecords_.push_back(record);
+    service->RefreshSubscribers();
     int32_t invalidSlotId = 5;
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_SLODID_ERROR,
         service->RegisterStateChange(telephonyObserver, invalidSlotId, 0, "", true, 0, 0, 0, ""));
     EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(telephonyObserver, 0, 0, "", true, 0, 0, 0, ""));
     EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(telephonyObserver, 0, 0, "", false, 0, 0, 0, ""));
     service->stateRecords_[0].tokenId_ = 1;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(telephonyObserver, 0, 0, "", true, 0, 0, 0, ""));
     service->stateRecords_[0].tokenId_ = 123456789;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(telephonyObserver, 0, 0, "", true, 0, 0, 0, ""));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(telephonyObserver, 0, 0, "", true, 0, 0, 0, ""));
     service->stateRecords_[0].slotId_ = 1;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->RegisterStateChange(telephonyObserver, 0, 0, "", true, 0, 0, 0, ""));
 }
 
@@ -1086,13 +1106,16 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_005, Function | Me
     ASSERT_TRUE(service != nullptr);
     TelephonyStateRegistryRecord record;
     service->stateRecords_.push_back(record);
+    service->RefreshSubscribers();
     int32_t invalidSlotId = 5;
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_SLODID_ERROR, service->UpdateVoiceMailMsgIndicator(invalidSlotId, true));
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED, service->UpdateVoiceMailMsgIndicator(0, true));
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED, service->UpdateIccAccount());
     service->stateRecords_[0].telephonyObserver_ = std::make_unique<TelephonyObserver>().release();
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED, service->UpdateIccAccount());
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_ICC_ACCOUNT;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED, service->UpdateIccAccount());
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_SLODID_ERROR, service->UpdateCfuIndicator(invalidSlotId, true));
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_PERMISSION_DENIED, service->UpdateCfuIndicator(0, true));
@@ -1135,6 +1158,7 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_006, Function | Me
     TelephonyStateRegistryRecord record;
     EXPECT_FALSE(record.IsCanReadCallHistory());
     service->stateRecords_.push_back(record);
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCellularDataConnectState(0, 0, 0));
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCellularDataFlow(0, 0));
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCallStateForSlotId(0, 0, number));
@@ -1146,36 +1170,48 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_006, Function | Me
     service->stateRecords_[0].telephonyObserver_ = std::make_unique<TelephonyObserver>().release();
     service->stateRecords_[0].slotId_ = 3;
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCellularDataConnectState(0, 0, 0));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCellularDataFlow(0, 0));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCallState(0, number));
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCallStateForSlotId(0, 0, number));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCallState(0, number));
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCallStateForSlotId(0, 0, number));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateSimState(0, type, state, reason));
 
     service->stateRecords_[0].slotId_ = 0;
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCellularDataConnectState(0, 0, 0));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCellularDataFlow(0, 0));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE;
     service->stateRecords_[0].slotId_ = -1;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCallState(-1, number));
     service->stateRecords_[0].slotId_ = 0;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCallStateForSlotId(0, 0, number));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateSimState(0, type, state, reason));
 
     service->stateRecords_[0].slotId_ = 999;
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_CONNECTION_STATE;
+    service->RefreshSubscribers();
     EXPECT_NE(TELEPHONY_SUCCESS, service->UpdateCellularDataConnectState(999, 0, 0));
 
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    service->RefreshSubscribers();
     EXPECT_NE(TELEPHONY_SUCCESS, service->UpdateCellularDataFlow(999, 2));
 }
 
@@ -1193,6 +1229,7 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_007, Function | Me
     TelephonyStateRegistryRecord record;
     std::u16string number = u"123";
     service->stateRecords_.push_back(record);
+    service->RefreshSubscribers();
     sptr<NetworkState> networkState = std::make_unique<NetworkState>().release();
     std::vector<sptr<SignalInformation>> vecSignalInfo;
     EXPECT_NE(TELEPHONY_SUCCESS, service->UpdateSignalInfo(0, vecSignalInfo));
@@ -1205,32 +1242,44 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_007, Function | Me
     service->stateRecords_[0].telephonyObserver_ = std::make_unique<TelephonyObserver>().release();
     service->stateRecords_[0].slotId_ = 3;
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateSignalInfo(0, vecSignalInfo));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCellInfo(0, vecCellInfo));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateNetworkState(0, networkState));
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateNetworkState(0, nullptr));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateCfuIndicator(0, true));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_STATE_REGISTRY_DATA_NOT_EXIST, service->UpdateVoiceMailMsgIndicator(0, true));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX;
     service->stateRecords_[0].slotId_ = -1;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCallState(-1, number));
     service->stateRecords_[0].slotId_ = 0;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCallStateForSlotId(0, 0, number));
 
     service->stateRecords_[0].slotId_ = 0;
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateSignalInfo(0, vecSignalInfo));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCellInfo(0, vecCellInfo));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateNetworkState(0, networkState));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCfuIndicator(0, true));
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_VOICE_MAIL_MSG_INDICATOR;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateVoiceMailMsgIndicator(0, true));
 }
 
@@ -1271,7 +1320,7 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_008, Function | Me
 
     TelephonyStateRegistryRecord record;
     std::u16string testNumber = u"123";
-    service->callIncomingNumber_[0] = testNumber;
+    service->slotStates_->SetCallIncomingNumber(0, testNumber);
     EXPECT_EQ(u"", service->GetCallIncomingNumberForSlotId(record, 0));
     EXPECT_TRUE(service->CheckPermission(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE));
     EXPECT_TRUE(service->CheckPermission(TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO));
@@ -1331,17 +1380,21 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistryServiceTest_010, Function | Me
     service->stateRecords_.push_back(record);
     service->stateRecords_[0].telephonyObserver_ = std::make_unique<TelephonyObserver>().release();
     service->stateRecords_[0].slotId_ = 0;
+    service->RefreshSubscribers();
     TELEPHONY_EXT_WRAPPER.onSignalInfoUpdated_ = nullptr;
     std::vector<sptr<SignalInformation>> vecSignalInfo;
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateSignalInfo(0, vecSignalInfo));
     TELEPHONY_EXT_WRAPPER.onCellInfoUpdated_ = nullptr;
     std::vector<sptr<CellInformation>> vecCellInfo;
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateCellInfo(0, vecCellInfo));
     TELEPHONY_EXT_WRAPPER.onNetworkStateUpdated_ = nullptr;
     sptr<NetworkState> networkState = std::make_unique<NetworkState>().release();
     service->stateRecords_[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE;
+    service->RefreshSubscribers();
     EXPECT_EQ(TELEPHONY_SUCCESS, service->UpdateNetworkState(0, networkState));
     TELEPHONY_EXT_WRAPPER.InitTelephonyExtWrapper();
 }
@@ -1382,6 +1435,710 @@ HWTEST_F(StateRegistryTest, TelephonyStateRegistrySimCountTest_002, Function | M
     EXPECT_FALSE(service->VerifySlotId(-1));
 }
 
+/**
+ * @tc.number   TelephonyStateRegistrySubscriberIndexTest_001
+ * @tc.name     telephony state registry subscriber index test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistrySubscriberIndexTest_001, Function | MediumTest | Level1)
+{
+    std::vector<TelephonyStateRegistryRecord> records(4);
+    records[0].slotId_ = 0;
+    records[0].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    records[1].slotId_ = TelephonyStateRegistrySubscriberIndex::DEFAULT_CONN_SLOT_ID;
+    records[1].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    records[2].slotId_ = 1;
+    records[2].mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    records[3].slotId_ = 0;
+    records[3].mask_ =
+        TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE | TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX;
+    TelephonyStateRegistrySubscriberIndex index;
+    index.Rebuild(records);
+
+    std::vector<uint32_t> positions;
+    uint32_t position = 0;
+    auto cursor = index.Find(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW,
+        { 0, TelephonyStateRegistrySubscriberIndex::DEFAULT_CONN_SLOT_ID });
+    while (cursor.Next(position)) {
+        positions.push_back(position);
+    }
+    EXPECT_EQ(positions, std::vector<uint32_t>({ 0, 1 }));
+
+    positions.clear();
+    cursor = index.Find(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE |
+        TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE_EX, { 0 });
+    while (cursor.Next(position)) {
+        positions.push_back(position);
+    }
+    EXPECT_EQ(positions, std::vector<uint32_t>({ 3 }));
+
+    positions.clear();
+    cursor = index.Find(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW,
+        { TelephonyStateRegistrySubscriberIndex::ANY_SLOT_ID });
+    while (cursor.Next(position)) {
+        positions.push_back(position);
+    }
+    EXPECT_EQ(positions, std::vector<uint32_t>({ 0, 1, 2 }));
+
+    cursor = index.Find(TelephonyObserverBroker::OBSERVER_MASK_SIM_STATE, { 0 });
+    EXPECT_FALSE(cursor.Next(position));
+    cursor = index.Find(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW, { MAX_SLOT_COUNT + 1 });
+    EXPECT_FALSE(cursor.Next(position));
+}
+
+/**
+ * @tc.number   TelephonyStateRegistrySubscriberIndexTest_002
+ * @tc.name     telephony state registry subscriber snapshot test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistrySubscriberIndexTest_002, Function | MediumTest | Level1)
+{
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+
+    ASSERT_TRUE(service != nullptr);
+    TelephonyStateRegistryRecord record;
+    record.slotId_ = 0;
+    record.mask_ = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    record.telephonyObserver_ = std::make_unique<TelephonyObserver>().release();
+    service->stateRecords_.push_back(record);
+    service->RefreshSubscribers();
+    auto subscribers = service->GetSubscribers();
+    ASSERT_TRUE(subscribers != nullptr);
+    size_t recordCount = subscribers->records.size();
+    service->stateRecords_.pop_back();
+    service->RefreshSubscribers();
+    EXPECT_EQ(recordCount, subscribers->records.size());
+    EXPECT_EQ(recordCount, service->GetSubscribers()->records.size() + 1);
+    EXPECT_TRUE(subscribers->records.back().telephonyObserver_ != nullptr);
+}
+
+/**
+ * @tc.number   TelephonyStateRegistrySlotTableTest_001
+ * @tc.name     telephony state registry slot table test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistrySlotTableTest_001, Function | MediumTest | Level1)
+{
+    TelephonyStateRegistrySlotTable slotTable(DUAL_SLOT_COUNT);
+    EXPECT_TRUE(slotTable.IsValidSlot(-1));
+    EXPECT_TRUE(slotTable.IsValidSlot(DUAL_SLOT_COUNT - 1));
+    EXPECT_FALSE(slotTable.IsValidSlot(DUAL_SLOT_COUNT));
+    EXPECT_FALSE(slotTable.IsValidSlot(TelephonyStateRegistrySubscriberIndex::DEFAULT_CONN_SLOT_ID));
+    EXPECT_FALSE(slotTable.Write(DUAL_SLOT_COUNT, { { SlotStateField::DATA_FLOW, DATA_FLOW_TYPE_DOWN } }));
+
+    int32_t value = TELEPHONY_ERROR;
+    EXPECT_FALSE(slotTable.Read(0, SlotStateField::DATA_CONNECTION_STATE, value));
+    EXPECT_EQ(TELEPHONY_ERROR, value);
+    EXPECT_TRUE(slotTable.Write(0, { { SlotStateField::DATA_CONNECTION_STATE, DATA_STATE_CONNECTING },
+        { SlotStateField::DATA_CONNECTION_NETWORK_TYPE, NETWORK_TYPE_GSM } }));
+    SlotStateValues values;
+    EXPECT_TRUE(slotTable.Read(0, values));
+    EXPECT_TRUE(values.IsValid(SlotStateField::DATA_CONNECTION_STATE));
+    EXPECT_TRUE(values.IsValid(SlotStateField::DATA_CONNECTION_NETWORK_TYPE));
+    EXPECT_FALSE(values.IsValid(SlotStateField::DATA_FLOW));
+    EXPECT_EQ(DATA_STATE_CONNECTING, values.Get(SlotStateField::DATA_CONNECTION_STATE));
+    EXPECT_EQ(NETWORK_TYPE_GSM, values.Get(SlotStateField::DATA_CONNECTION_NETWORK_TYPE));
+    EXPECT_FALSE(slotTable.Read(1, SlotStateField::DATA_CONNECTION_STATE, value));
+
+    slotTable.Invalidate(0, SlotStateField::DATA_CONNECTION_STATE);
+    EXPECT_FALSE(slotTable.Read(0, SlotStateField::DATA_CONNECTION_STATE, value));
+    EXPECT_TRUE(slotTable.Read(0, SlotStateField::DATA_CONNECTION_NETWORK_TYPE, value));
+    EXPECT_EQ(NETWORK_TYPE_GSM, value);
+
+    std::u16string number = u"123";
+    slotTable.SetCallIncomingNumber(-1, number);
+    EXPECT_EQ(number, slotTable.GetCallIncomingNumber(-1));
+    EXPECT_EQ(u"", slotTable.GetCallIncomingNumber(0));
+    EXPECT_TRUE(slotTable.GetNetworkState(0) == nullptr);
+    EXPECT_TRUE(slotTable.GetSignalInfos(DUAL_SLOT_COUNT).empty());
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryDispatcherTest_001
+ * @tc.name     telephony state registry dispatcher test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryDispatcherTest_001, Function | MediumTest | Level1)
+{
+    TelephonyStateRegistryDispatcher dispatcher(DUAL_SLOT_COUNT + 1);
+    std::vector<int32_t> slot0Jobs;
+    std::vector<int32_t> slot1Jobs;
+    size_t jobCount = 100;
+    for (int32_t i = 0; i < static_cast<int32_t>(jobCount); i++) {
+        EXPECT_TRUE(dispatcher.Dispatch(0, [&slot0Jobs, i]() { slot0Jobs.push_back(i); }));
+        EXPECT_TRUE(dispatcher.Dispatch(1, [&slot1Jobs, i]() { slot1Jobs.push_back(i); }));
+    }
+    dispatcher.Flush();
+    EXPECT_EQ(0u, dispatcher.GetPendingCount());
+    ASSERT_EQ(jobCount, slot0Jobs.size());
+    ASSERT_EQ(jobCount, slot1Jobs.size());
+    for (size_t i = 0; i < jobCount; i++) {
+        EXPECT_EQ(static_cast<int32_t>(i), slot0Jobs[i]);
+        EXPECT_EQ(static_cast<int32_t>(i), slot1Jobs[i]);
+    }
+    dispatcher.Stop();
+    bool inlineRun = false;
+    EXPECT_FALSE(dispatcher.Dispatch(-1, [&inlineRun]() { inlineRun = true; }));
+    EXPECT_TRUE(inlineRun);
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryMailboxTest_001
+ * @tc.name     telephony state registry mailbox test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryMailboxTest_001, Function | MediumTest | Level1)
+{
+    size_t capacity = 4;
+    TelephonyStateRegistryMailbox mailbox(capacity);
+    std::vector<int32_t> delivered;
+    uint64_t signalKey =
+        TelephonyStateRegistryMailbox::MakeKey(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, 0);
+    uint64_t callKey = TelephonyStateRegistryMailbox::MakeKey(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE, 0);
+    EXPECT_TRUE(mailbox.Post(signalKey, true, [&delivered]() { delivered.push_back(1); }));
+    EXPECT_FALSE(mailbox.Post(callKey, false, [&delivered]() { delivered.push_back(10); }));
+    EXPECT_FALSE(mailbox.Post(signalKey, true, [&delivered]() { delivered.push_back(2); }));
+    EXPECT_FALSE(mailbox.Post(callKey, false, [&delivered]() { delivered.push_back(11); }));
+    TelephonyStateRegistryMailbox::Stats stats = mailbox.GetStats();
+    EXPECT_EQ(3u, stats.depth);
+    EXPECT_EQ(1u, stats.coalesced);
+    EXPECT_FALSE(mailbox.Drain(capacity));
+    ASSERT_EQ(3u, delivered.size());
+    EXPECT_EQ(2, delivered[0]);
+    EXPECT_EQ(10, delivered[1]);
+    EXPECT_EQ(11, delivered[2]);
+
+    delivered.clear();
+    int32_t resync = -1;
+    mailbox.SetResync([&delivered, resync]() { delivered.push_back(resync); });
+    for (int32_t i = 0; i <= static_cast<int32_t>(capacity) + 1; i++) {
+        mailbox.Post(callKey, false, [&delivered, i]() { delivered.push_back(i); });
+    }
+    stats = mailbox.GetStats();
+    EXPECT_EQ(capacity + 1, stats.depth);
+    EXPECT_EQ(0u, stats.dropped);
+    EXPECT_EQ(1u, stats.resyncs);
+    EXPECT_EQ(2u, stats.resynced);
+    EXPECT_TRUE(mailbox.Drain(capacity));
+    EXPECT_FALSE(mailbox.Drain(capacity));
+    ASSERT_EQ(capacity + 1, delivered.size());
+    EXPECT_EQ(0, delivered[0]);
+    EXPECT_EQ(resync, delivered[capacity]);
+    EXPECT_TRUE(mailbox.Post(callKey, false, [&delivered]() { delivered.push_back(0); }));
+    EXPECT_EQ(1u, mailbox.GetStats().depth);
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryPayloadTest_001
+ * @tc.name     telephony state registry payload test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryPayloadTest_001, Function | MediumTest | Level1)
+{
+    std::vector<sptr<SignalInformation>> signalInfos;
+    auto signalPayload = TelephonyStateRegistryPayload::CreateSignalInfo(0, signalInfos);
+    ASSERT_TRUE(signalPayload != nullptr);
+    std::vector<sptr<CellInformation>> cellInfos;
+    EXPECT_TRUE(TelephonyStateRegistryPayload::CreateCellInfo(0, cellInfos) == nullptr);
+    sptr<NetworkState> networkState = std::make_unique<NetworkState>().release();
+    EXPECT_TRUE(TelephonyStateRegistryPayload::CreateNetworkState(0, networkState) != nullptr);
+
+    EXPECT_FALSE(signalPayload->SendTo(nullptr));
+    // Observers of the service process are not remote, they are notified through their interface.
+    sptr<TelephonyObserverBroker> observer = std::make_unique<StateRegistryObserver>().release();
+    EXPECT_FALSE(signalPayload->SendTo(observer));
+    uint64_t events = TelephonyStateRegistryPayload::GetStats().events;
+    signalPayload = nullptr;
+    EXPECT_EQ(events, TelephonyStateRegistryPayload::GetStats().events);
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryChangeFilterTest_001
+ * @tc.name     telephony state registry change filter test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryChangeFilterTest_001, Function | MediumTest | Level1)
+{
+    int32_t slotSize = 2;
+    TelephonyStateRegistryChangeFilter filter(slotSize);
+    uint32_t event = TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS;
+    EXPECT_TRUE(filter.IsEnabled(event));
+    EXPECT_FALSE(filter.IsEnabled(TelephonyObserverBroker::OBSERVER_MASK_CALL_STATE));
+
+    const uint8_t first[] = { 1, 2, 3 };
+    const uint8_t second[] = { 1, 2, 4 };
+    uint64_t fingerprint = TelephonyStateRegistryChangeFilter::Fingerprint(first, sizeof(first));
+    EXPECT_EQ(fingerprint, TelephonyStateRegistryChangeFilter::Fingerprint(first, sizeof(first)));
+    EXPECT_NE(fingerprint, TelephonyStateRegistryChangeFilter::Fingerprint(second, sizeof(second)));
+
+    uint64_t version = 1;
+    EXPECT_FALSE(filter.IsSameFingerprint(event, 0, fingerprint));
+    EXPECT_FALSE(filter.SetFingerprint(event, 0, version, fingerprint));
+    filter.BeginCommit(event, 0);
+    // No fingerprint is kept while a commit runs.
+    EXPECT_FALSE(filter.SetFingerprint(event, 0, version, fingerprint));
+    filter.EndCommit(event, 0, version);
+    EXPECT_TRUE(filter.SetFingerprint(event, 0, version, fingerprint));
+    EXPECT_TRUE(filter.IsSameFingerprint(event, 0, fingerprint));
+    EXPECT_FALSE(filter.IsSameFingerprint(event, 1, fingerprint));
+    EXPECT_FALSE(filter.IsSameFingerprint(TelephonyObserverBroker::OBSERVER_MASK_NETWORK_STATE, 0, fingerprint));
+    filter.BeginCommit(event, 0);
+    EXPECT_FALSE(filter.IsSameFingerprint(event, 0, fingerprint));
+    filter.EndCommit(event, 0, version + 1);
+    // The fingerprint of an update which committed before the last commit is refused.
+    EXPECT_FALSE(filter.SetFingerprint(event, 0, version, fingerprint));
+    EXPECT_FALSE(filter.IsSameFingerprint(event, 0, fingerprint));
+    EXPECT_FALSE(filter.SetFingerprint(event, slotSize, version, fingerprint));
+    EXPECT_FALSE(filter.IsSameFingerprint(event, slotSize, fingerprint));
+
+    filter.CountSuppressed(event, false);
+    filter.CountSuppressed(event, true);
+    EXPECT_EQ(2u, filter.GetSuppressedCount(event));
+    EXPECT_EQ(1u, filter.GetParcelSuppressedCount());
+    EXPECT_EQ(0u, filter.GetSuppressedCount(TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW));
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryThrottleTest_001
+ * @tc.name     telephony state registry delivery policy test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryThrottleTest_001, Function | MediumTest | Level1)
+{
+    TelephonyObserverDeliveryPolicy policy;
+    EXPECT_TRUE(policy.IsDefault());
+    policy.minIntervalMs = -1;
+    EXPECT_FALSE(policy.IsValid());
+    policy.minIntervalMs = 60000;
+    policy.signalDeltaDbm = 3;
+    EXPECT_TRUE(policy.IsValid());
+    Parcel parcel;
+    EXPECT_TRUE(policy.Marshalling(parcel));
+    TelephonyObserverDeliveryPolicy readPolicy;
+    EXPECT_TRUE(readPolicy.ReadFromParcel(parcel));
+    EXPECT_EQ(policy.minIntervalMs, readPolicy.minIntervalMs);
+    EXPECT_EQ(policy.signalDeltaDbm, readPolicy.signalDeltaDbm);
+
+    TelephonyStateRegistryThrottle throttle(policy);
+    uint32_t event = TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS;
+    uint32_t flushDelayMs = 0;
+    int32_t deliveredCount = 0;
+    auto job = [&deliveredCount]() { deliveredCount++; };
+    TelephonyStateRegistryThrottle::Sample sample { 3, -90 };
+    EXPECT_EQ(TelephonyStateRegistryThrottle::Decision::DELIVER, throttle.Offer(event, sample, job, flushDelayMs));
+    sample.dbm = -91;
+    EXPECT_EQ(TelephonyStateRegistryThrottle::Decision::DROP, throttle.Offer(event, sample, job, flushDelayMs));
+    sample.level = 2;
+    EXPECT_EQ(TelephonyStateRegistryThrottle::Decision::DEFER, throttle.Offer(event, sample, job, flushDelayMs));
+    EXPECT_GT(flushDelayMs, 0u);
+    EXPECT_GT(throttle.Flush(event), 0u);
+    EXPECT_EQ(0, deliveredCount);
+    EXPECT_EQ(TelephonyStateRegistryThrottle::Decision::DELIVER,
+        throttle.Offer(TelephonyObserverBroker::OBSERVER_MASK_CELL_INFO, sample, job, flushDelayMs));
+    throttle.Close();
+    EXPECT_EQ(0u, throttle.Flush(event));
+    EXPECT_EQ(0, deliveredCount);
+    TelephonyStateRegistryThrottle::Stats stats = throttle.GetStats();
+    EXPECT_EQ(1u, stats.dropped);
+    EXPECT_EQ(1u, stats.deferred);
+    EXPECT_EQ(0u, stats.flushed);
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryPermissionCacheTest_001
+ * @tc.name     telephony state registry permission cache test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryPermissionCacheTest_001, Function | MediumTest | Level1)
+{
+    TelephonyStateRegistryPermissionCache cache;
+    int32_t tokenId = 0;
+    bool granted = cache.Verify(tokenId, Permission::READ_CALL_LOG);
+    EXPECT_EQ(1u, cache.GetStats().misses);
+    cache.SetTrackedTokens({ tokenId });
+    EXPECT_EQ(granted, cache.Verify(tokenId, Permission::READ_CALL_LOG));
+    cache.OnPermissionChanged(tokenId, Permission::READ_CALL_LOG);
+    EXPECT_EQ(granted, cache.Verify(tokenId, Permission::READ_CALL_LOG));
+    TelephonyStateRegistryPermissionCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(3u, stats.hits + stats.misses);
+
+    cache.SetTrackedTokens({});
+    EXPECT_EQ(granted, cache.Verify(tokenId, Permission::READ_CALL_LOG));
+    EXPECT_EQ(stats.misses + 1, cache.GetStats().misses);
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryEventPublisherTest_001
+ * @tc.name     telephony state registry event publisher test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryEventPublisherTest_001, Function | MediumTest | Level1)
+{
+    using Kind = TelephonyStateRegistryEventPublisher::Kind;
+    TelephonyStateRegistryEventPublisher publisher;
+    std::atomic<int32_t> lastSignal { 0 };
+    publisher.Post(Kind::SIGNAL_INFO, 0, [&lastSignal]() {
+        lastSignal = 1;
+        return true;
+    });
+    publisher.Flush();
+    EXPECT_EQ(1, lastSignal.load());
+
+    // Held back by the interval, the later values replace the queued one.
+    publisher.SetMinInterval(Kind::SIGNAL_INFO, 60000);
+    for (int32_t value = 2; value <= 4; value++) {
+        publisher.Post(Kind::SIGNAL_INFO, 0, [&lastSignal, value]() {
+            lastSignal = value;
+            return true;
+        });
+    }
+    publisher.Post(Kind::CALL_STATE, 0, []() { return false; });
+    publisher.Post(Kind::CALL_STATE, 0, []() { return true; });
+    publisher.SetMinInterval(Kind::SIGNAL_INFO, 0);
+    publisher.Flush();
+    EXPECT_EQ(4, lastSignal.load());
+    TelephonyStateRegistryEventPublisher::Stats stats = publisher.GetStats();
+    EXPECT_EQ(3u, stats.published);
+    EXPECT_EQ(2u, stats.coalesced);
+    EXPECT_EQ(1u, stats.failed);
+    EXPECT_EQ(0u, stats.depth);
+    publisher.Stop();
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryEventPublisherTest_002
+ * @tc.name     telephony state registry event publisher overflow test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryEventPublisherTest_002, Function | MediumTest | Level1)
+{
+    using Kind = TelephonyStateRegistryEventPublisher::Kind;
+    TelephonyStateRegistryEventPublisher publisher(2);
+    std::atomic<bool> started { false };
+    std::atomic<bool> released { false };
+    publisher.Post(Kind::CALL_STATE, 0, [&started, &released]() {
+        started = true;
+        while (!released) {
+            std::this_thread::yield();
+        }
+        return true;
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    // The signal event does not take the room of the transitions, the third transition drops the oldest one.
+    publisher.Post(Kind::SIGNAL_INFO, 0, []() { return true; });
+    publisher.Post(Kind::SIM_STATE, 0, []() { return true; });
+    publisher.Post(Kind::CALL_STATE, 0, []() { return true; });
+    publisher.Post(Kind::CALL_STATE, 0, []() { return true; });
+    EXPECT_EQ(3u, publisher.GetStats().depth);
+    released = true;
+    publisher.Flush();
+    TelephonyStateRegistryEventPublisher::Stats stats = publisher.GetStats();
+    EXPECT_EQ(4u, stats.published);
+    EXPECT_EQ(1u, stats.dropped);
+    EXPECT_EQ(1u, stats.droppedKinds[static_cast<uint32_t>(Kind::SIM_STATE)]);
+    EXPECT_EQ(0u, stats.droppedKinds[static_cast<uint32_t>(Kind::SIGNAL_INFO)]);
+    EXPECT_STREQ("SIM_STATE_CHANGED", TelephonyStateRegistryEventPublisher::GetKindName(Kind::SIM_STATE));
+    publisher.Stop();
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryNetworkStateCloneTest_001
+ * @tc.name     telephony state registry network state clone test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryNetworkStateCloneTest_001, Function | MediumTest | Level1)
+{
+    EXPECT_EQ(nullptr, TelephonyStateRegistryService::CloneNetworkState(nullptr));
+    sptr<NetworkState> networkState = sptr<NetworkState>::MakeSptr();
+    networkState->isEmergency_ = true;
+    sptr<NetworkState> clone = TelephonyStateRegistryService::CloneNetworkState(networkState);
+    ASSERT_NE(nullptr, clone);
+    EXPECT_NE(networkState.GetRefPtr(), clone.GetRefPtr());
+    EXPECT_TRUE(*clone == *networkState);
+    clone->isEmergency_ = false;
+    EXPECT_TRUE(networkState->isEmergency_);
+}
+
+/**
+ * @tc.number   TelephonyStateRegistryMetricsTest_001
+ * @tc.name     telephony state registry metrics test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateRegistryMetricsTest_001, Function | MediumTest | Level1)
+{
+    using Histogram = TelephonyStateRegistryHistogram;
+    for (uint32_t i = 0; i + 1 < Histogram::BUCKET_COUNT; i++) {
+        EXPECT_EQ(i, Histogram::GetBucketIndex(Histogram::GetBucketLowerBound(i)));
+        EXPECT_EQ(i, Histogram::GetBucketIndex(Histogram::GetBucketLowerBound(i + 1) - 1));
+    }
+    TelephonyStateRegistryMetrics metrics;
+    EXPECT_EQ(nullptr, metrics.BeginFanOut(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, 100, 1));
+    {
+        auto fanOut = metrics.BeginFanOut(TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, 0, 2);
+        ASSERT_NE(nullptr, fanOut);
+        fanOut->RecordNotification(10, false);
+        fanOut->RecordNotification(20, true);
+    }
+    std::string result;
+    metrics.Dump(result);
+    EXPECT_NE(std::string::npos, result.find("SignalInfo slotId: 0 updates: 1 matched: 2 notified: 2 ipcFailures: 1"));
+    metrics.Reset();
+    result.clear();
+    metrics.Dump(result);
+    EXPECT_EQ(std::string::npos, result.find("SignalInfo"));
+
+    auto service = DelayedSingleton<TelephonyStateRegistryService>::GetInstance();
+    ASSERT_TRUE(service != nullptr);
+    std::vector<std::u16string> args = { u"-metrics-reset" };
+    EXPECT_EQ(TELEPHONY_SUCCESS, service->Dump(1, args));
+}
+
+/**
+ * @tc.number   TelephonyObserverSequenceTest_001
+ * @tc.name     telephony observer sequence test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyObserverSequenceTest_001, Function | MediumTest | Level1)
+{
+    uint32_t code = static_cast<uint32_t>(TelephonyObserverBroker::ObserverBrokerCode::ON_CELLULAR_DATA_FLOW_UPDATED);
+    uint64_t sequence = 1;
+    MessageParcel parcel;
+    EXPECT_TRUE(TelephonyObserverProxy::WriteRequestHeader(parcel));
+    parcel.WriteInt32(0);
+    uint32_t requestCode = TelephonyObserverProxy::GetRequestCode(code);
+    EXPECT_EQ(code, requestCode);
+    EXPECT_EQ(TelephonyObserverBroker::GetDescriptor(), parcel.ReadInterfaceToken());
+    EXPECT_TRUE(TelephonyObserverProxy::ReadSequence(requestCode, parcel, sequence));
+    EXPECT_EQ(0u, sequence);
+    EXPECT_EQ(0, parcel.ReadInt32());
+
+    MessageParcel sequenced;
+    {
+        TelephonyObserverProxy::SequenceScope scope(5);
+        {
+            // Not sent to an observer which did not ask for it, the local callbacks still see it.
+            TelephonyObserverProxy::SequenceScope innerScope(7, false);
+            EXPECT_EQ(7u, TelephonyObserver::GetUpdateSequence());
+            EXPECT_EQ(code, TelephonyObserverProxy::GetRequestCode(code));
+        }
+        EXPECT_EQ(5u, TelephonyObserverProxy::GetCurrentSequence());
+        EXPECT_TRUE(TelephonyObserverProxy::WriteRequestHeader(sequenced));
+        sequenced.WriteInt32(0);
+        requestCode = TelephonyObserverProxy::GetRequestCode(code);
+    }
+    EXPECT_EQ(0u, TelephonyObserverProxy::GetCurrentSequence());
+    EXPECT_EQ(code | TelephonyObserverProxy::SEQUENCED_CODE_FLAG, requestCode);
+    EXPECT_EQ(TelephonyObserverBroker::GetDescriptor(), sequenced.ReadInterfaceToken());
+    EXPECT_TRUE(TelephonyObserverProxy::ReadSequence(requestCode, sequenced, sequence));
+    EXPECT_EQ(code, requestCode);
+    EXPECT_EQ(5u, sequence);
+    EXPECT_EQ(0, sequenced.ReadInt32());
+}
+
+class EventRingObserver : public TelephonyObserver {
+public:
+    void OnSignalInfoUpdated(int32_t slotId, const std::vector<sptr<SignalInformation>> &vec) override
+    {
+        count_++;
+        signalCount_ = vec.size();
+        sequence_ = TelephonyObserver::GetUpdateSequence();
+    }
+
+    int32_t count_ = 0;
+    size_t signalCount_ = 0;
+    uint64_t sequence_ = 0;
+};
+
+/**
+ * @tc.number   TelephonyEventRingTest_001
+ * @tc.name     telephony event ring test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyEventRingTest_001, Function | MediumTest | Level1)
+{
+    // The ring lives in a memfd, the writer stands in for the service.
+    uint32_t entryCount = 4;
+    size_t size = TelephonyEventRing::GetSize(entryCount, TelephonyEventRing::DEFAULT_ENTRY_SIZE);
+    int fd = memfd_create("telephony_event_ring_test", MFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(0, ftruncate(fd, size));
+    int32_t slotId = 0;
+    sptr<Ashmem> ashmem = new Ashmem(fd, static_cast<int32_t>(size));
+    auto writer = TelephonyStateRegistryEventRing::Create(
+        ashmem, slotId, TelephonyObserverBroker::OBSERVER_MASK_SIGNAL_STRENGTHS, entryCount);
+    ASSERT_TRUE(writer != nullptr);
+    auto reader = TelephonyEventRingReader::Create(new Ashmem(dup(fd), static_cast<int32_t>(size)));
+    ASSERT_TRUE(reader != nullptr);
+    EXPECT_EQ(slotId, reader->GetSlotId());
+    EXPECT_FALSE(reader->Wait(0));
+
+    std::vector<sptr<SignalInformation>> vec;
+    std::unique_ptr<SignalInformation> signal = std::make_unique<GsmSignalInformation>();
+    vec.push_back(signal.release());
+    auto payload = TelephonyStateRegistryPayload::CreateSignalInfo(slotId, vec);
+    ASSERT_TRUE(payload != nullptr);
+    EXPECT_TRUE(writer->Write(payload->GetCode(), 1, payload->GetBody()));
+    EXPECT_TRUE(reader->Wait(0));
+    sptr<EventRingObserver> observer = std::make_unique<EventRingObserver>().release();
+    EXPECT_EQ(1u, reader->Poll(*observer, entryCount));
+    EXPECT_EQ(1, observer->count_);
+    EXPECT_EQ(vec.size(), observer->signalCount_);
+    EXPECT_EQ(1u, observer->sequence_);
+
+    // The two oldest events are overwritten before the reader polls.
+    uint64_t stateSequence = 1;
+    for (uint32_t i = 0; i < entryCount + 2; i++) {
+        EXPECT_TRUE(writer->Write(payload->GetCode(), ++stateSequence, payload->GetBody()));
+    }
+    EXPECT_EQ(entryCount, reader->Poll(*observer, entryCount + 2));
+    EXPECT_EQ(2u, reader->GetLostCount());
+    EXPECT_EQ(stateSequence, observer->sequence_);
+
+    std::vector<uint8_t> oversized(TelephonyEventRing::DEFAULT_ENTRY_SIZE + 1);
+    EXPECT_FALSE(writer->Write(payload->GetCode(), ++stateSequence, oversized));
+    EXPECT_EQ(0u, reader->Poll(*observer, entryCount));
+    EXPECT_EQ(3u, reader->GetLostCount());
+}
+
+/**
+ * @tc.number   TelephonyStateMultiplexerTest_001
+ * @tc.name     telephony state multiplexer test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateMultiplexerTest_001, Function | MediumTest | Level1)
+{
+    AccessToken token;
+    auto &multiplexer = DelayedRefSingleton<TelephonyStateMultiplexer>::GetInstance();
+    uint32_t mask = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    std::atomic<int32_t> counts[3] = {};
+    int32_t listenerIds[3] = { 0 };
+    for (int32_t i = 0; i < 3; i++) {
+        TelephonyStateListener listener;
+        listener.onCellularDataFlowUpdated = [&counts, i](int32_t slotId, int32_t dataFlowType) { counts[i]++; };
+        // The last listener is added once an event has been received.
+        if (i == 2) {
+            auto observer = multiplexer.slots_[DEFAULT_SIM_SLOT_ID].observer;
+            ASSERT_TRUE(observer != nullptr);
+            observer->OnCellularDataFlowUpdated(DEFAULT_SIM_SLOT_ID, 1);
+            EXPECT_GE(counts[0].load(), 1);
+            EXPECT_GE(counts[1].load(), 1);
+        }
+        ASSERT_EQ(TELEPHONY_SUCCESS, multiplexer.AddListener(DEFAULT_SIM_SLOT_ID, mask, listener, i == 2,
+            listenerIds[i]));
+        EXPECT_EQ(mask, multiplexer.GetRegisteredMask(DEFAULT_SIM_SLOT_ID));
+    }
+    // The last event is replayed to the listener added with notifyNow.
+    EXPECT_GE(counts[2].load(), 1);
+
+    EXPECT_EQ(TELEPHONY_SUCCESS, multiplexer.RemoveListener(listenerIds[0]));
+    EXPECT_EQ(mask, multiplexer.GetRegisteredMask(DEFAULT_SIM_SLOT_ID));
+    EXPECT_EQ(TELEPHONY_STATE_UNREGISTRY_DATA_NOT_EXIST, multiplexer.RemoveListener(listenerIds[0]));
+    EXPECT_EQ(TELEPHONY_SUCCESS, multiplexer.RemoveListener(listenerIds[1]));
+    EXPECT_EQ(TELEPHONY_SUCCESS, multiplexer.RemoveListener(listenerIds[2]));
+    EXPECT_EQ(0u, multiplexer.GetRegisteredMask(DEFAULT_SIM_SLOT_ID));
+}
+
+/**
+ * @tc.number   TelephonyStateMultiplexerTest_002
+ * @tc.name     telephony state multiplexer test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyStateMultiplexerTest_002, Function | MediumTest | Level1)
+{
+    AccessToken token;
+    auto &multiplexer = DelayedRefSingleton<TelephonyStateMultiplexer>::GetInstance();
+    uint32_t mask = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    std::atomic<int32_t> count = 0;
+    TelephonyStateListener listener;
+    listener.onCellularDataFlowUpdated = [&count](int32_t slotId, int32_t dataFlowType) { count++; };
+    int32_t listenerId = 0;
+    ASSERT_EQ(TELEPHONY_SUCCESS, multiplexer.AddListener(DEFAULT_SIM_SLOT_ID, mask, listener, false, listenerId));
+    // A pending registration of the slot holds back its other changes but not its events.
+    auto observer = multiplexer.slots_[DEFAULT_SIM_SLOT_ID].observer;
+    ASSERT_TRUE(observer != nullptr);
+    multiplexer.slots_[DEFAULT_SIM_SLOT_ID].pending = true;
+    observer->OnCellularDataFlowUpdated(DEFAULT_SIM_SLOT_ID, 1);
+    EXPECT_EQ(1, count.load());
+    std::atomic<int32_t> result = -1;
+    std::thread remover([&multiplexer, &result, listenerId]() { result = multiplexer.RemoveListener(listenerId); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(-1, result.load());
+    {
+        std::lock_guard<std::mutex> lock(multiplexer.mutex_);
+        multiplexer.EndRegistration(multiplexer.slots_[DEFAULT_SIM_SLOT_ID]);
+    }
+    remover.join();
+    EXPECT_EQ(TELEPHONY_SUCCESS, result.load());
+    EXPECT_EQ(0u, multiplexer.GetRegisteredMask(DEFAULT_SIM_SLOT_ID));
+}
+
+/**
+ * @tc.number   TelephonyObserverClientRecoverTest_001
+ * @tc.name     telephony observer client recover test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyObserverClientRecoverTest_001, Function | MediumTest | Level1)
+{
+    AccessToken token;
+    auto &client = TelephonyObserverClient::GetInstance();
+    sptr<TelephonyObserver> observer = new TelephonyObserver();
+    uint32_t mask = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    uint32_t newMask = mask | TelephonyObserverBroker::OBSERVER_MASK_CFU_INDICATOR;
+    ASSERT_EQ(TELEPHONY_SUCCESS, client.AddStateObserver(observer, DEFAULT_SIM_SLOT_ID, mask, false));
+    EXPECT_EQ(1u, client.journal_.count({ DEFAULT_SIM_SLOT_ID, mask }));
+    ASSERT_EQ(TELEPHONY_SUCCESS, client.ModifyStateObserver(DEFAULT_SIM_SLOT_ID, mask, newMask & ~mask, 0, false));
+    EXPECT_EQ(0u, client.journal_.count({ DEFAULT_SIM_SLOT_ID, mask }));
+    EXPECT_EQ(1u, client.journal_.count({ DEFAULT_SIM_SLOT_ID, newMask }));
+
+    // Replay the journal as the restart of the service does.
+    auto stats = client.GetRecoveryStats();
+    client.recovering_ = true;
+    client.diedTime_ = std::chrono::steady_clock::now();
+    client.Recover();
+    EXPECT_FALSE(client.recovering_);
+    EXPECT_EQ(stats.recoveries + 1, client.GetRecoveryStats().recoveries);
+    EXPECT_EQ(1u, client.journal_.count({ DEFAULT_SIM_SLOT_ID, newMask }));
+    client.Recover();
+    EXPECT_EQ(stats.recoveries + 1, client.GetRecoveryStats().recoveries);
+
+    EXPECT_EQ(TELEPHONY_SUCCESS, client.RemoveStateObserver(DEFAULT_SIM_SLOT_ID, newMask));
+    EXPECT_EQ(0u, client.journal_.count({ DEFAULT_SIM_SLOT_ID, newMask }));
+}
+
+/**
+ * @tc.number   TelephonyObserverClientRecoverTest_002
+ * @tc.name     telephony observer client recover test
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateRegistryTest, TelephonyObserverClientRecoverTest_002, Function | MediumTest | Level1)
+{
+    auto client = std::make_unique<TelephonyObserverClient>();
+    sptr<TelephonyObserver> observer = new TelephonyObserver();
+    uint32_t mask = TelephonyObserverBroker::OBSERVER_MASK_DATA_FLOW;
+    client->JournalAdd(DEFAULT_SIM_SLOT_ID, mask, observer, TelephonyObserverDeliveryPolicy());
+    // The requests to a remote which does not handle them do not get through.
+    sptr<IRemoteObject> remote = new IPCObjectStub(u"test");
+    client->proxy_ = new TelephonyStateRegistryProxy(remote);
+    sptr<ISystemAbilityStatusChange> listener =
+        new TelephonyObserverClient::StateRegistryStatusListener(*client);
+    client->statusListener_ = listener;
+    client->recovering_ = true;
+    client->diedTime_ = std::chrono::steady_clock::now();
+    client->Recover();
+    // The observer stays in the journal and the recovery waits for the service again.
+    EXPECT_TRUE(client->recovering_);
+    EXPECT_EQ(listener, client->statusListener_);
+    EXPECT_EQ(1u, client->journal_.count({ DEFAULT_SIM_SLOT_ID, mask }));
+    auto stats = client->GetRecoveryStats();
+    EXPECT_EQ(1u, stats.unsentRegistrations);
+    EXPECT_EQ(0u, stats.failedRegistrations);
+    client->recovering_ = false;
+    client->statusListener_ = nullptr;
+    client->proxy_ = nullptr;
+}
+
 #else // TEL_TEST_UNSUPPORT
 /**
  * @tc.number   State_MockTest_001